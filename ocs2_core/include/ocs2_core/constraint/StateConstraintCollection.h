@@ -66,6 +66,17 @@ class StateConstraintCollection : public Collection<StateConstraint> {
  protected:
   /** Copy constructor */
   StateConstraintCollection(const StateConstraintCollection& other);
+
+  /**
+   * Collects the terms which are active at the given time. The activity of each term is checked only once, so that the
+   * concatenated outputs can be allocated upfront and the inactive terms are skipped without further queries. The list is
+   * provided by the caller, such that concurrent evaluations of the same collection do not share any state.
+   *
+   * @param [in] time: The query time.
+   * @param [out] activeTerms: The active terms in the order they were added.
+   * @return The total number of the active constraints.
+   */
+  size_t getActiveTerms(scalar_t time, std::vector<const StateConstraint*>& activeTerms) const;
 };
 
 }  // namespace ocs2
\ No newline at end of file
@@ -92,6 +92,26 @@ class ControlledSystemBase : public OdeBase {
    */
   virtual vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) = 0;
 
+  /**
+   * Computes the flow map for a batch of states. The inputs are computed by the controller.
+   *
+   * @param [in] times: The time of each state.
+   * @param [in] states: The states, one per column.
+   * @param [out] derivatives: The state time derivatives, one per column.
+   */
+  void computeFlowMapBatch(const vector_t& times, const matrix_t& states, matrix_t& derivatives) override final;
+
+  /**
+   * Computes the flow map for a batch of states and inputs. The default implementation calls computeFlowMap(t, x, u) for each
+   * column, including the pre-computation request. Derived classes can override it to vectorize the evaluation over the batch.
+   *
+   * @param [in] times: The time of each state.
+   * @param [in] states: The states, one per column.
+   * @param [in] inputs: The inputs, one per column.
+   * @param [out] derivatives: The state time derivatives, one per column.
+   */
+  virtual void computeFlowMapBatch(const vector_t& times, const matrix_t& states, const matrix_t& inputs, matrix_t& derivatives);
+
   /**
    * State map at the transition time
    *
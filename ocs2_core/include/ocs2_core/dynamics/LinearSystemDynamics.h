@@ -52,12 +52,16 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
+  void computeFlowMapBatch(const vector_t& times, const matrix_t& states, const matrix_t& inputs, matrix_t& derivatives) override;
+
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation&) override;
 
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) override;
 
+  bool isLinearTimeInvariant() const override { return true; }
+
  protected:
   LinearSystemDynamics(const LinearSystemDynamics& other) = default;
 
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <array>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/dynamics/ControlledSystemBase.h>
 
@@ -113,6 +115,47 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   virtual matrix_t dynamicsCovariance(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Gets the dimension of the configuration of a mechanical system whose state is ordered as x = [q; v], such that the
+   * configuration rate dq/dt does not depend on the acceleration. Symplectic discretizations use this split.
+   *
+   * @return The dimension of q, zero if the state does not have such a split.
+   */
+  virtual size_t getConfigurationDimension() const { return 0; }
+
+  /**
+   * Whether the flow map is affine in the state and the input with constant Jacobians, i.e., dx/dt = A * x + B * u + c.
+   * The exponential discretization is exact for such systems and falls back to Runge-Kutta 4th order otherwise.
+   *
+   * @return true if the system is linear time-invariant.
+   */
+  virtual bool isLinearTimeInvariant() const { return false; }
+
+  /**
+   * Workspace of the exponential discretization of a linear time-invariant system, see exponentialDiscretization(). The cache
+   * is not copied by clone(), hence each worker of a solver computes the exponential of its own copy of the system.
+   *
+   * The exponential is kept for the few most recent interval durations, such that a time grid which alternates between a
+   * handful of durations (e.g. the regular step and the shortened steps before the events) reuses it. On a grid with more
+   * distinct durations than entries, the exponential is recomputed at each node.
+   */
+  struct ExponentialDiscretizationCache {
+    struct Entry {
+      matrix_t dfdx;       // continuous-time state Jacobian of the cached exponential
+      matrix_t dfdu;       // continuous-time input Jacobian of the cached GammaB
+      scalar_t dt = -1.0;  // interval of the cached exponential, negative if not computed yet
+      matrix_t Phi;        // expm(A * dt)
+      matrix_t Gamma;      // \int_0^dt expm(A * s) ds
+      matrix_t GammaB;     // Gamma * B
+      bool hasGammaB = false;
+    };
+    std::array<Entry, 4> entries;
+    size_t nextEntryIndex = 0;  // entry replaced by the next interval duration which is not cached
+  };
+
+  /** Gets the workspace of the exponential discretization. */
+  ExponentialDiscretizationCache& getExponentialDiscretizationCache() { return exponentialDiscretizationCache_; }
+
   /**
    * Computes the flow map linear approximation.
    *
@@ -122,6 +165,14 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the state derivative of the flow map for the input of the controller.
+   *
+   * @note This method evaluates the linearApproximation() at the controller input. The dependency of the input on the
+   *       state through the controller is neglected, which is sufficient for the Newton iterations of implicit integrators.
+   */
+  matrix_t computeFlowMapJacobian(scalar_t t, const vector_t& x) override;
+
   /** Computes the jump map linear approximation.
    *
    * @note This method updates the internal preComputation with the requestPreJump() callback and
@@ -132,6 +183,9 @@ class SystemDynamicsBase : public ControlledSystemBase {
  protected:
   /** Copy constructor */
   SystemDynamicsBase(const SystemDynamicsBase& other);
+
+ private:
+  ExponentialDiscretizationCache exponentialDiscretizationCache_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,106 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/integration/IntegratorBase.h>
+
+namespace ocs2 {
+
+/*
+ * 2nd order variable step size backward differentiation formula (BDF2) integrator class for stiff systems.
+ *
+ * The first step of each integration is an implicit Euler step. The implicit equations are solved by a simplified Newton
+ * method using the state derivative of the system (OdeBase::computeFlowMapJacobian). The Jacobian is reused across steps as
+ * long as the Newton iterations converge fast, and the LU factorization of the iteration matrix is kept in a workspace which
+ * is reused across steps and integrations. The local error is estimated from the difference to a Hermite predictor.
+ */
+class BackwardDifferentiationFormula2 : public IntegratorBase {
+ public:
+  explicit BackwardDifferentiationFormula2(std::shared_ptr<SystemEventHandler> eventHandlerPtr = nullptr);
+
+  ~BackwardDifferentiationFormula2() override;
+
+ private:
+  void setSystemJacobian(jacobian_func_t jacobian) override { systemJacobian_ = std::move(jacobian); }
+
+  /**
+   * Equidistant integration based on initial and final time as well as step length.
+   *
+   * @param [in] system: System function
+   * @param [in] observer: Observer callback
+   * @param [in] initialState: Initial state.
+   * @param [in] startTime: Initial time.
+   * @param [in] finalTime: Final time.
+   * @param [in] dt: Time step.
+   */
+  void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                         scalar_t finalTime, scalar_t dt) override;
+
+  /**
+   * Adaptive time integration based on start time and final time.
+   *
+   * @param [in] system: System function
+   * @param [in] observer: Observer callback
+   * @param [in] initialState: Initial state.
+   * @param [in] startTime: Initial time.
+   * @param [in] finalTime: Final time.
+   * @param [in] dtInitial: Initial time step.
+   * @param [in] absTol: The absolute tolerance error for ode solver.
+   * @param [in] relTol: The relative tolerance error for ode solver.
+   */
+  void runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                            scalar_t finalTime, scalar_t dtInitial, scalar_t absTol, scalar_t relTol) override;
+
+  /**
+   * Output integration based on a given time trajectory.
+   *
+   * @param [in] system: System function
+   * @param [in] observer: Observer callback
+   * @param [in] initialState: Initial state.
+   * @param [in] beginTimeItr: The iterator to the beginning of the time stamp trajectory.
+   * @param [in] endTimeItr: The iterator to the end of the time stamp trajectory.
+   * @param [in] dtInitial: Initial time step.
+   * @param [in] absTol: The absolute tolerance error for ode solver.
+   * @param [in] relTol: The relative tolerance error for ode solver.
+   */
+  void runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                         typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                         scalar_t dtInitial, scalar_t absTol, scalar_t relTol) override;
+
+  class Stepper;
+  std::unique_ptr<Stepper> stepperPtr_;
+  jacobian_func_t systemJacobian_;
+
+  static constexpr size_t maxNumStepsRetries_ = 100;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,145 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/integration/Observer.h>
+#include <ocs2_core/integration/OdeBase.h>
+
+namespace ocs2 {
+
+/**
+ * 5th order Runge Kutta Dormand-Prince integrator for a batch of independent trajectories of the same system.
+ *
+ * The K states are stored as the columns of one (nx x K) matrix and are advanced in lockstep: every stage of the Runge-Kutta step
+ * evaluates the dynamics of the whole batch with a single call to OdeBase::computeFlowMapBatch, which the system can vectorize.
+ * In adaptive integration, every trajectory has its own time and step size. The error control accepts or rejects the step of each
+ * trajectory separately, and the trajectories which have reached the final time are removed from the batch. Therefore, the dynamics
+ * is only evaluated for the trajectories which are still running.
+ *
+ * The integration of a batch is not thread-safe with respect to the system. For multi-core throughput, split the trajectories in
+ * several batches and integrate each one with a clone of the system.
+ */
+class BatchRungeKuttaDormandPrince5 {
+ public:
+  BatchRungeKuttaDormandPrince5() = default;
+  ~BatchRungeKuttaDormandPrince5() = default;
+
+  /**
+   * Equidistant integration based on initial and final time as well as step length.
+   *
+   * @param [in] system: System dynamics
+   * @param [in] observers: The observer of each trajectory.
+   * @param [in] initialStates: Initial states, one per column.
+   * @param [in] startTime: Initial time.
+   * @param [in] finalTime: Final time.
+   * @param [in] dt: Time step.
+   * @param [in] maxNumSteps: The maximum number of batch evaluations of the system dynamics.
+   */
+  void integrateConst(OdeBase& system, std::vector<Observer>& observers, const matrix_t& initialStates, scalar_t startTime,
+                      scalar_t finalTime, scalar_t dt, int maxNumSteps = std::numeric_limits<int>::max());
+
+  /**
+   * Adaptive time integration based on start time and final time. The step size is controlled separately for each trajectory.
+   *
+   * @param [in] system: System dynamics
+   * @param [in] observers: The observer of each trajectory.
+   * @param [in] initialStates: Initial states, one per column.
+   * @param [in] startTime: Initial time.
+   * @param [in] finalTime: Final time.
+   * @param [in] dtInitial: Initial time step.
+   * @param [in] absTol: The absolute tolerance error for ode solver.
+   * @param [in] relTol: The relative tolerance error for ode solver.
+   * @param [in] maxNumSteps: The maximum number of batch evaluations of the system dynamics.
+   */
+  void integrateAdaptive(OdeBase& system, std::vector<Observer>& observers, const matrix_t& initialStates, scalar_t startTime,
+                         scalar_t finalTime, scalar_t dtInitial = 0.01, scalar_t absTol = 1e-6, scalar_t relTol = 1e-3,
+                         int maxNumSteps = std::numeric_limits<int>::max());
+
+ private:
+  /**
+   * Evaluates the system dynamics of the batch and checks the maximum number of function calls.
+   */
+  void evaluate(OdeBase& system, const vector_t& times, const matrix_t& states, matrix_t& derivatives, int maxNumSteps) const;
+
+  /**
+   * Performs one Dormand-Prince step for all the trajectories.
+   *
+   * @param [in] system: System dynamics
+   * @param [in] x0: Current states.
+   * @param [in] dxdt: Current state derivatives.
+   * @param [in] t: Current time of each trajectory.
+   * @param [in] dt: Step size of each trajectory.
+   * @param [out] x_out: Next states.
+   * @param [out] dxdt_out: Derivatives at the next states.
+   * @param [in] maxNumSteps: The maximum number of batch evaluations of the system dynamics.
+   */
+  void doStep(OdeBase& system, const matrix_t& x0, const matrix_t& dxdt, const vector_t& t, const vector_t& dt, matrix_t& x_out,
+              matrix_t& dxdt_out, int maxNumSteps);
+
+  /**
+   * Estimates the maximal error of each trajectory for the last step.
+   *
+   * @param [in] x_old: Previous states.
+   * @param [in] dxdt_old: Previous state derivatives.
+   * @param [in] dxdt_out: Derivatives at the next states.
+   * @param [in] dt: Step size of each trajectory.
+   * @param [in] absTol: The absolute error tolerance.
+   * @param [in] relTol: The relative error tolerance.
+   * @return The maximal error value of each trajectory.
+   */
+  vector_t maxError(const matrix_t& x_old, const matrix_t& dxdt_old, const matrix_t& dxdt_out, const vector_t& dt, scalar_t absTol,
+                    scalar_t relTol) const;
+
+  /**
+   * Removes the finished trajectories from the batch. The remaining trajectories keep their order.
+   *
+   * @param [in] isActive: Whether each trajectory of the batch is still running.
+   * @param [in, out] indices: The index of the observer of each trajectory.
+   * @param [in, out] tries: The number of rejected steps of each trajectory.
+   * @param [in, out] t: Current time of each trajectory.
+   * @param [in, out] dt: Step size of each trajectory.
+   * @param [in, out] x: Current states.
+   * @param [in, out] dxdt: Current state derivatives.
+   */
+  void removeFinishedTrajectories(const std::vector<bool>& isActive, std::vector<Eigen::Index>& indices, std::vector<size_t>& tries,
+                                  vector_t& t, vector_t& dt, matrix_t& x, matrix_t& dxdt) const;
+
+  /** intermediate derivatives during Runge-Kutta step. */
+  matrix_t k1_, k2_, k3_, k4_, k5_, k6_;
+  matrix_t x_;
+
+  static constexpr size_t maxNumStepsRetries_ = 100;
+};
+
+}  // namespace ocs2
@@ -49,7 +49,9 @@ enum class IntegratorType {
   MODIFIED_MIDPOINT,
   RK4,
   RK5_VARIABLE,
-  ADAMS_BASHFORTH_MOULTON
+  ADAMS_BASHFORTH_MOULTON,
+  RADAU_IIA5,
+  BDF2
 };
 
 namespace integrator_type {
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -47,6 +48,7 @@ class IntegratorBase {
  public:
   using system_func_t = std::function<void(const vector_t& x, vector_t& dxdt, scalar_t t)>;
   using observer_func_t = std::function<void(const vector_t& x, scalar_t t)>;
+  using jacobian_func_t = std::function<void(const vector_t& x, matrix_t& dfdx, scalar_t t)>;
 
   /**
    * Default constructor
@@ -105,12 +107,49 @@ class IntegratorBase {
                       scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
                       int maxNumSteps = std::numeric_limits<int>::max());
 
+  /**
+   * Enables or disables the step-size warm start, which is disabled by default. When enabled, an adaptive integration over the
+   * same time interval as one of the recent ones, e.g., the rollout of the next iteration, starts from the step size proposed after
+   * the first accepted step of that integration instead of the user-defined initial step. The result of an integration then
+   * depends on the previous integrations of this integrator. Only the integrators with their own step-size control support it.
+   *
+   * @param [in] enable: Whether to warm start the step size.
+   */
+  void setStepSizeWarmStart(bool enable);
+
+  /**
+   * Clears the step sizes recorded for the warm start, e.g., when the integrator is used for an unrelated problem.
+   */
+  void resetStepSizeWarmStart();
+
  protected:
   /** Copy constructor */
   IntegratorBase(const IntegratorBase& rhs) = default;
 
   system_func_t systemFunction(OdeBase& system, int maxNumSteps) const;
 
+  jacobian_func_t jacobianFunction(OdeBase& system) const;
+
+  /**
+   * Sets the state derivative of the system function before each integration. Only implicit integrators, which need the
+   * Jacobian for their Newton iterations, use it.
+   *
+   * @param [in] jacobian: The state derivative of the system function.
+   */
+  virtual void setSystemJacobian(jacobian_func_t jacobian) {}
+
+  /**
+   * Records the step size proposed after the first accepted step of the current adaptive integration for the step-size warm
+   * start. It has no effect if the warm start is disabled. See setStepSizeWarmStart.
+   *
+   * @param [in] dt: The step size proposed by the step-size controller.
+   */
+  void setWarmStartTimeStep(scalar_t dt) {
+    if (activeWarmStartIndex_ < warmStartCacheSize_) {
+      warmStartCache_[activeWarmStartIndex_].timeStep = dt;
+    }
+  }
+
   virtual void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
                                  scalar_t finalTime, scalar_t dt) = 0;
 
@@ -122,7 +161,27 @@ class IntegratorBase {
                                  scalar_t dtInitial, scalar_t AbsTol, scalar_t RelTol) = 0;
 
  private:
+  /**
+   * Returns the initial step size of an adaptive integration over [startTime, finalTime]. If the warm start is enabled, it
+   * selects the warm start entry of this interval, which is updated by setWarmStartTimeStep.
+   */
+  scalar_t initialTimeStep(scalar_t startTime, scalar_t finalTime, scalar_t dtInitial);
+
+  /** The step size warm start of an integration interval. A zero time step denotes that none is available. */
+  struct WarmStart {
+    scalar_t startTime;
+    scalar_t finalTime;
+    scalar_t timeStep;
+  };
+
   std::shared_ptr<SystemEventHandler> eventHandlerPtr_;
+
+  // one entry per integration interval, e.g., per mode of a rollout, where the oldest entry is replaced first
+  static constexpr size_t warmStartCacheSize_ = 16;
+  bool useStepSizeWarmStart_ = false;
+  std::array<WarmStart, warmStartCacheSize_> warmStartCache_{};
+  size_t nextWarmStartIndex_ = 0;
+  size_t activeWarmStartIndex_ = warmStartCacheSize_;  // warmStartCacheSize_ denotes no active entry
 };
 
 }  // namespace ocs2
@@ -61,6 +61,26 @@ class OdeBase {
    */
   virtual vector_t computeFlowMap(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * Computes the autonomous system dynamics for a batch of states. The default implementation calls computeFlowMap for each
+   * column. Derived classes can override it to vectorize the evaluation over the batch.
+   *
+   * @param [in] times: The time of each state.
+   * @param [in] states: The states, one per column.
+   * @param [out] derivatives: The state time derivatives, one per column.
+   */
+  virtual void computeFlowMapBatch(const vector_t& times, const matrix_t& states, matrix_t& derivatives);
+
+  /**
+   * Computes the derivative of the autonomous system dynamics w.r.t. the state, e.g., for the Newton iterations of implicit
+   * integrators. The default implementation uses forward finite differences of computeFlowMap.
+   *
+   * @param [in] t: Current time.
+   * @param [in] x: Current state.
+   * @return The state derivative of the flow map.
+   */
+  virtual matrix_t computeFlowMapJacobian(scalar_t t, const vector_t& x);
+
   /**
    * State map at the transition time
    *
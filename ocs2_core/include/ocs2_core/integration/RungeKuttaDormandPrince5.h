@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <memory>
+
 #include <ocs2_core/integration/IntegratorBase.h>
 
 namespace ocs2 {
@@ -37,14 +39,14 @@ namespace ocs2 {
  * 5th order Runge Kutta Dormand-Prince (ode45) Integrator class
  *
  * The implementation is based on the boost odeint integrator with the controlled
- * boost::numeric::odeint::runge_kutta_dopri5 stepper.
+ * boost::numeric::odeint::runge_kutta_dopri5 stepper. The stepper and its stage buffers persist across integrations,
+ * such that repeated rollouts of the same system do not allocate.
  */
 class RungeKuttaDormandPrince5 : public IntegratorBase {
  public:
-  explicit RungeKuttaDormandPrince5(std::shared_ptr<SystemEventHandler> eventHandlerPtr = nullptr)
-      : IntegratorBase(std::move(eventHandlerPtr)){};
+  explicit RungeKuttaDormandPrince5(std::shared_ptr<SystemEventHandler> eventHandlerPtr = nullptr);
 
-  ~RungeKuttaDormandPrince5() override = default;
+  ~RungeKuttaDormandPrince5() override;
 
  private:
   /**
@@ -90,6 +92,9 @@ class RungeKuttaDormandPrince5 : public IntegratorBase {
                          typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
                          scalar_t dtInitial, scalar_t absTol, scalar_t relTol) override;
 
+  class Stepper;
+  std::unique_ptr<Stepper> stepperPtr_;
+
   static constexpr size_t maxNumStepsRetries_ = 100;
 };
 
@@ -34,7 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
-enum class SensitivityIntegratorType { EULER, RK2, RK4 };
+enum class SensitivityIntegratorType { EULER, RK2, RK4, EXPONENTIAL, IMPLICIT_EULER, RADAU_IIA5, IMPLICIT_MIDPOINT, SYMPLECTIC_EULER };
 
 namespace sensitivity_integrator {
 
@@ -76,4 +76,91 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
-}  // namespace ocs2
\ No newline at end of file
+/**
+ * Computes the discretized dynamics. Uses the exact zero-order-hold discretization of linear time-invariant dynamics,
+ * x_{k+1} = x_{k} + \int_0^dt expm(A * s) ds * f(x_{k},u_{k}), where the matrix exponential is cached in the system for the
+ * most recent interval durations, see SystemDynamicsBase::ExponentialDiscretizationCache.
+ * Falls back to a Runge-Kutta 4th order discretization if SystemDynamicsBase::isLinearTimeInvariant() is false.
+ * Returns x_{k+1}
+ */
+vector_t exponentialDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the exact zero-order-hold discretization of linear
+ * time-invariant dynamics with a cached matrix exponential, see exponentialDiscretization. Falls back to a Runge-Kutta
+ * 4th order discretization if SystemDynamicsBase::isLinearTimeInvariant() is false.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation exponentialSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                       const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics. Uses an implicit (backward) euler discretization, x_{k+1} = x_{k} + dt * f(x_{k+1},u_{k}),
+ * solved with a simplified Newton iteration on the state Jacobian at x_{k}. Suited for stiff dynamics.
+ * Returns x_{k+1}
+ */
+vector_t implicitEulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses an implicit (backward) euler discretization solved with a
+ * Newton iteration, the sensitivities follow from the implicit function theorem at the converged solution.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitEulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                         const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics. Uses the 3-stage Radau IIA (5th order, L-stable) discretization solved with a simplified
+ * Newton iteration on the state Jacobian at x_{k}. Suited for stiff dynamics.
+ * Returns x_{k+1}
+ */
+vector_t radauIIA5Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the 3-stage Radau IIA discretization solved with a Newton
+ * iteration, the sensitivities follow from the implicit function theorem at the converged stages.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation radauIIA5SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                     const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics. Uses the implicit midpoint rule, x_{k+1} = x_{k} + dt * f((x_{k} + x_{k+1}) / 2, u_{k}),
+ * solved with a simplified Newton iteration on the state Jacobian at x_{k}. The method is symplectic and of 2nd order, which
+ * preserves the energy behavior of conservative mechanical systems over long horizons.
+ * Returns x_{k+1}
+ */
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the implicit midpoint rule solved with a Newton iteration,
+ * the sensitivities follow from the implicit function theorem at the converged stage.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics of a mechanical system with state x = [q; v]. Uses the semi-implicit (symplectic) euler
+ * discretization which first updates the velocity and then the configuration with the updated velocity:
+ *      v_{k+1} = v_{k} + dt * f_v(q_{k}, v_{k}, u_{k})
+ *      q_{k+1} = q_{k} + dt * f_q(q_{k}, v_{k+1}, u_{k})
+ * The split is given by SystemDynamicsBase::getConfigurationDimension(), throws if the system does not provide it.
+ * Returns x_{k+1}
+ */
+vector_t symplecticEulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the semi-implicit (symplectic) euler discretization of
+ * symplecticEulerDiscretization(), throws if the system does not provide a (q, v) split of its state.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation symplecticEulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                           const vector_t& u, scalar_t dt);
+
+}  // namespace ocs2
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <type_traits>
 
@@ -41,6 +42,10 @@ namespace ocs2 {
 
 /**
  * Integrator class for autonomous systems.
+ *
+ * The odeint steppers are members which are passed by reference to the odeint integrate functions. Therefore, their state
+ * buffers persist across integrations and only their internal history and step-size controller are reset for each call.
+ *
  * @tparam Stepper: Stepper class type to be used.
  */
 template <class Stepper>
@@ -48,6 +53,7 @@ class Integrator final : public IntegratorBase {
  public:
   using observer_func_t = typename IntegratorBase::observer_func_t;
   using system_func_t = typename IntegratorBase::system_func_t;
+  using controlled_stepper_t = typename boost::numeric::odeint::result_of::make_controlled<runge_kutta_dopri5_t>::type;
 
   /**
    * Default constructor
@@ -198,10 +204,36 @@ class Integrator final : public IntegratorBase {
   typename std::enable_if<!(std::is_same<S, runge_kutta_dopri5_t>::value), void>::type initializeStepper(vector_t& initialState, scalar_t t,
                                                                                                          scalar_t dt);
 
+  /**
+   * Returns the controlled runge_kutta_dopri5_t stepper for the given tolerances. The stepper is only recreated if the tolerances
+   * change, otherwise its step-size controller is reset.
+   *
+   * @param [in] AbsTol: The absolute tolerance error for ode solver.
+   * @param [in] RelTol: The relative tolerance error for ode solver.
+   */
+  controlled_stepper_t& controlledStepper(scalar_t AbsTol, scalar_t RelTol);
+
+  /**
+   * Resets the internal history of a stepper, e.g., of the multistep Adams-Bashforth stepper, before a new integration.
+   */
+  template <typename S>
+  static auto resetStepper(S& stepper, int) -> decltype(stepper.reset(), void()) {
+    stepper.reset();
+  }
+
+  /**
+   * Steppers without an internal history do not need to be reset.
+   */
+  template <typename S>
+  static void resetStepper(S& stepper, long) {}
+
   /*
    * Variables
    */
   Stepper stepper_;
+  controlled_stepper_t controlledStepper_;
+  scalar_t controlledStepperAbsTol_ = -1.0;
+  scalar_t controlledStepperRelTol_ = -1.0;
 };
 
 /******************************************************************************************************/
@@ -221,7 +253,8 @@ inline void Integrator<Stepper>::runIntegrateConst(system_func_t system, observe
   vector_t initialStateInternal = initialState;
   // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
   finalTime += 0.1 * dt;
-  boost::numeric::odeint::integrate_const(stepper_, system, initialStateInternal, startTime, finalTime, dt, observer);
+  resetStepper(stepper_, 0);
+  boost::numeric::odeint::integrate_const(std::ref(stepper_), system, initialStateInternal, startTime, finalTime, dt, observer);
 }
 
 /******************************************************************************************************/
@@ -255,8 +288,8 @@ template <typename S>
 inline typename std::enable_if<std::is_same<S, runge_kutta_dopri5_t>::value, void>::type Integrator<Stepper>::integrateAdaptiveSpecialized(
     system_func_t system, observer_func_t observer, vector_t& initialState, scalar_t startTime, scalar_t finalTime, scalar_t dtInitial,
     scalar_t AbsTol, scalar_t RelTol) {
-  boost::numeric::odeint::integrate_adaptive(boost::numeric::odeint::make_controlled<S>(AbsTol, RelTol), system, initialState, startTime,
-                                             finalTime, dtInitial, observer);
+  boost::numeric::odeint::integrate_adaptive(std::ref(controlledStepper(AbsTol, RelTol)), system, initialState, startTime, finalTime,
+                                             dtInitial, observer);
 }
 
 /******************************************************************************************************/
@@ -267,7 +300,8 @@ template <typename S>
 inline typename std::enable_if<!std::is_same<S, runge_kutta_dopri5_t>::value, void>::type Integrator<Stepper>::integrateAdaptiveSpecialized(
     system_func_t system, observer_func_t observer, vector_t& initialState, scalar_t startTime, scalar_t finalTime, scalar_t dtInitial,
     scalar_t AbsTol, scalar_t RelTol) {
-  boost::numeric::odeint::integrate_adaptive(stepper_, system, initialState, startTime, finalTime, dtInitial, observer);
+  resetStepper(stepper_, 0);
+  boost::numeric::odeint::integrate_adaptive(std::ref(stepper_), system, initialState, startTime, finalTime, dtInitial, observer);
 }
 
 /******************************************************************************************************/
@@ -282,11 +316,11 @@ inline typename std::enable_if<std::is_same<S, runge_kutta_dopri5_t>::value, voi
   boost::numeric::odeint::max_step_checker maxStepChecker(
       std::numeric_limits<int>::max());  // maxNumSteps is already checked by event handler.
 
-  boost::numeric::odeint::integrate_times(boost::numeric::odeint::make_controlled<S>(AbsTol, RelTol), system, initialState, beginTimeItr,
-                                          endTimeItr, dtInitial, observer, maxStepChecker);
+  boost::numeric::odeint::integrate_times(std::ref(controlledStepper(AbsTol, RelTol)), system, initialState, beginTimeItr, endTimeItr,
+                                          dtInitial, observer, maxStepChecker);
 #else
-  boost::numeric::odeint::integrate_times(boost::numeric::odeint::make_controlled<S>(AbsTol, RelTol), system, initialState, beginTimeItr,
-                                          endTimeItr, dtInitial, observer);
+  boost::numeric::odeint::integrate_times(std::ref(controlledStepper(AbsTol, RelTol)), system, initialState, beginTimeItr, endTimeItr,
+                                          dtInitial, observer);
 #endif
 }
 
@@ -302,10 +336,12 @@ inline typename std::enable_if<!std::is_same<S, runge_kutta_dopri5_t>::value, vo
   boost::numeric::odeint::max_step_checker maxStepChecker(
       std::numeric_limits<int>::max());  // maxNumSteps is already checked by event handler.
 
-  boost::numeric::odeint::integrate_times(stepper_, system, initialState, beginTimeItr, endTimeItr, dtInitial, observer, maxStepChecker);
-
+  resetStepper(stepper_, 0);
+  boost::numeric::odeint::integrate_times(std::ref(stepper_), system, initialState, beginTimeItr, endTimeItr, dtInitial, observer,
+                                          maxStepChecker);
 #else
-  boost::numeric::odeint::integrate_times(stepper_, system, initialState, beginTimeItr, endTimeItr, dtInitial, observer);
+  resetStepper(stepper_, 0);
+  boost::numeric::odeint::integrate_times(std::ref(stepper_), system, initialState, beginTimeItr, endTimeItr, dtInitial, observer);
 #endif
 }
 
@@ -329,6 +365,22 @@ typename std::enable_if<!(std::is_same<S, runge_kutta_dopri5_t>::value), void>::
   stepper_.initialize(runge_kutta_dopri5_t(), system, initialState, t, dt);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <class Stepper>
+typename Integrator<Stepper>::controlled_stepper_t& Integrator<Stepper>::controlledStepper(scalar_t AbsTol, scalar_t RelTol) {
+  if (AbsTol != controlledStepperAbsTol_ || RelTol != controlledStepperRelTol_) {
+    using error_checker_t = typename controlled_stepper_t::error_checker_type;
+    using step_adjuster_t = typename controlled_stepper_t::step_adjuster_type;
+    controlledStepper_ = controlled_stepper_t(error_checker_t(AbsTol, RelTol), step_adjuster_t(), controlledStepper_.stepper());
+    controlledStepperAbsTol_ = AbsTol;
+    controlledStepperRelTol_ = RelTol;
+  }
+  controlledStepper_.reset();
+  return controlledStepper_;
+}
+
 /**
  * Euler integrator.
  */
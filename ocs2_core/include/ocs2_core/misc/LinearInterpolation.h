@@ -53,6 +53,17 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment(enquiryTime, timeArray), but the interval of a previous enquiry and its neighbours are checked before
+ * searching the whole time array. This makes the lookup constant time for a sequence of close enquiries, e.g. in an integration.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in] hintIndex: The interval index of a previous enquiry.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int hintIndex);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -115,6 +126,21 @@ template <typename Data, class Alloc, class AccessFun>
 auto interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, AccessFun accessFun)
     -> remove_cvref_t<typename std::result_of<AccessFun(const std::vector<Data, Alloc>&, size_t)>::type>;
 
+/**
+ * Same as interpolate(indexAlpha, dataArray, accessFun), but writes the result into the given output. For Eigen types, no
+ * memory is allocated if the output already has the correct size.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: vector of data
+ * @param [in] accessFun: Method to access the subfield of Data in array.
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc, class AccessFun, typename Field>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, AccessFun accessFun, Field& result);
+
 /**
  * Linearly interpolates at the given time. When duplicate values exist the lower range is selected s.t. ( ]
  * Example: t = [0.0, 1.0, 1.0, 2.0]
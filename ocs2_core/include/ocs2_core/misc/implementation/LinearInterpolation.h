@@ -66,13 +66,10 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Computes the index and interpolation coefficient from the interval index given by lookup::findIntervalInTimeArray.
+ */
+inline index_alpha_t intervalToTimeSegment(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +101,46 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return intervalToTimeSegment(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int hintIndex) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  // the interval (time[i], time[i+1]] is the one selected by lookup::findIntervalInTimeArray
+  const auto isInInterval = [&](int i) {
+    return i >= 0 && i + 1 < static_cast<int>(timeArray.size()) && timeArray[i] < enquiryTime && enquiryTime <= timeArray[i + 1];
+  };
+
+  int index;
+  if (isInInterval(hintIndex)) {
+    index = hintIndex;
+  } else if (isInInterval(hintIndex - 1)) {
+    index = hintIndex - 1;
+  } else if (isInInterval(hintIndex + 1)) {
+    index = hintIndex + 1;
+  } else {
+    index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  }
+  return intervalToTimeSegment(index, enquiryTime, timeArray);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -144,6 +181,29 @@ auto interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataA
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc, class AccessFun, typename Field>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, AccessFun accessFun, Field& result) {
+  assert(dataArray.size() > 0);
+  if (dataArray.size() > 1) {
+    // Normal interpolation case
+    int index = indexAlpha.first;
+    scalar_t alpha = indexAlpha.second;
+    const auto& lhs = accessFun(dataArray, index);
+    const auto& rhs = accessFun(dataArray, index + 1);
+    if (areSameSize(rhs, lhs)) {
+      result = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {  // dataArray.size() == 1
+    // Time vector has only 1 element -> Constant function
+    result = accessFun(dataArray, 0);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -62,20 +62,36 @@ size_t StateConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t StateConstraintCollection::getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const {
-  vector_t constraintValues;
-  constraintValues.resize(getNumConstraints(time));
+size_t StateConstraintCollection::getActiveTerms(scalar_t time, std::vector<const StateConstraint*>& activeTerms) const {
+  activeTerms.clear();
+  activeTerms.reserve(this->terms_.size());
 
-  // append vectors of constraint values from each constraintTerm
-  size_t i = 0;
+  size_t numConstraints = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
-      const auto constraintTermValues = constraintTerm->getValue(time, state, preComp);
-      constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
-      i += constraintTermValues.rows();
+      activeTerms.push_back(constraintTerm.get());
+      numConstraints += constraintTerm->getNumConstraints(time);
     }
   }
 
+  return numConstraints;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t StateConstraintCollection::getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const {
+  std::vector<const StateConstraint*> activeTerms;
+  vector_t constraintValues(getActiveTerms(time, activeTerms));
+
+  // append vectors of constraint values from each active constraintTerm
+  size_t i = 0;
+  for (const auto* constraintTerm : activeTerms) {
+    const auto constraintTermValues = constraintTerm->getValue(time, state, preComp);
+    constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
+    i += constraintTermValues.rows();
+  }
+
   return constraintValues;
 }
 
@@ -84,18 +100,17 @@ vector_t StateConstraintCollection::getValue(scalar_t time, const vector_t& stat
 /******************************************************************************************************/
 VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                     const PreComputation& preComp) const {
-  VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows(), 0);
+  std::vector<const StateConstraint*> activeTerms;
+  VectorFunctionLinearApproximation linearApproximation(getActiveTerms(time, activeTerms), state.rows(), 0);
 
-  // append linearApproximation of each constraintTerm
+  // append linearApproximation of each active constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      i += nc;
-    }
+  for (const auto* constraintTerm : activeTerms) {
+    const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
+    const size_t nc = constraintTermApproximation.f.rows();
+    linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+    linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+    i += nc;
   }
 
   return linearApproximation;
@@ -106,24 +121,23 @@ VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximat
 /******************************************************************************************************/
 VectorFunctionQuadraticApproximation StateConstraintCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                           const PreComputation& preComp) const {
-  const auto numConstraints = getNumConstraints(time);
+  std::vector<const StateConstraint*> activeTerms;
+  const auto numConstraints = getActiveTerms(time, activeTerms);
 
   VectorFunctionQuadraticApproximation quadraticApproximation;
   quadraticApproximation.f.resize(numConstraints);
   quadraticApproximation.dfdx.resize(numConstraints, state.rows());
   quadraticApproximation.dfdxx.reserve(numConstraints);  // Use reserve instead of resize to avoid unnecessary allocations.
 
-  // append quadraticApproximation of each constraintTerm
+  // append quadraticApproximation of each active constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
-      i += nc;
-    }
+  for (const auto* constraintTerm : activeTerms) {
+    auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, preComp);
+    const size_t nc = constraintTermApproximation.f.rows();
+    quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+    quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+    appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
+    i += nc;
   }
 
   return quadraticApproximation;
@@ -63,21 +63,37 @@ size_t StateInputConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t StateInputConstraintCollection::getValue(scalar_t time, const vector_t& state, const vector_t& input,
-                                                  const PreComputation& preComp) const {
-  vector_t constraintValues;
-  constraintValues.resize(getNumConstraints(time));
+size_t StateInputConstraintCollection::getActiveTerms(scalar_t time, std::vector<const StateInputConstraint*>& activeTerms) const {
+  activeTerms.clear();
+  activeTerms.reserve(this->terms_.size());
 
-  // append vectors of constraint values from each constraintTerm
-  size_t i = 0;
+  size_t numConstraints = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
-      const auto constraintTermValues = constraintTerm->getValue(time, state, input, preComp);
-      constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
-      i += constraintTermValues.rows();
+      activeTerms.push_back(constraintTerm.get());
+      numConstraints += constraintTerm->getNumConstraints(time);
     }
   }
 
+  return numConstraints;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t StateInputConstraintCollection::getValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                                  const PreComputation& preComp) const {
+  std::vector<const StateInputConstraint*> activeTerms;
+  vector_t constraintValues(getActiveTerms(time, activeTerms));
+
+  // append vectors of constraint values from each active constraintTerm
+  size_t i = 0;
+  for (const auto* constraintTerm : activeTerms) {
+    const auto constraintTermValues = constraintTerm->getValue(time, state, input, preComp);
+    constraintValues.segment(i, constraintTermValues.rows()) = constraintTermValues;
+    i += constraintTermValues.rows();
+  }
+
   return constraintValues;
 }
 
@@ -87,19 +103,18 @@ vector_t StateInputConstraintCollection::getValue(scalar_t time, const vector_t&
 VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                          const vector_t& input,
                                                                                          const PreComputation& preComp) const {
-  VectorFunctionLinearApproximation linearApproximation(getNumConstraints(time), state.rows(), input.rows());
+  std::vector<const StateInputConstraint*> activeTerms;
+  VectorFunctionLinearApproximation linearApproximation(getActiveTerms(time, activeTerms), state.rows(), input.rows());
 
-  // append linearApproximation of each constraintTerm
+  // append linearApproximation of each active constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
-      i += nc;
-    }
+  for (const auto* constraintTerm : activeTerms) {
+    const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
+    const size_t nc = constraintTermApproximation.f.rows();
+    linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+    linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+    linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+    i += nc;
   }
 
   return linearApproximation;
@@ -111,7 +126,8 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
 VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                                const vector_t& input,
                                                                                                const PreComputation& preComp) const {
-  const auto numConstraints = getNumConstraints(time);
+  std::vector<const StateInputConstraint*> activeTerms;
+  const auto numConstraints = getActiveTerms(time, activeTerms);
 
   VectorFunctionQuadraticApproximation quadraticApproximation;
   quadraticApproximation.f.resize(numConstraints);
@@ -121,20 +137,18 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
   quadraticApproximation.dfdux.reserve(numConstraints);
   quadraticApproximation.dfduu.reserve(numConstraints);
 
-  // append quadraticApproximation of each constraintTerm
+  // append quadraticApproximation of each active constraintTerm
   size_t i = 0;
-  for (const auto& constraintTerm : this->terms_) {
-    if (constraintTerm->isActive(time)) {
-      auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
-      const size_t nc = constraintTermApproximation.f.rows();
-      quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
-      quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
-      quadraticApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
-      appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
-      appendVectorToVectorByMoving(quadraticApproximation.dfdux, std::move(constraintTermApproximation.dfdux));
-      appendVectorToVectorByMoving(quadraticApproximation.dfduu, std::move(constraintTermApproximation.dfduu));
-      i += nc;
-    }
+  for (const auto* constraintTerm : activeTerms) {
+    auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
+    const size_t nc = constraintTermApproximation.f.rows();
+    quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+    quadraticApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+    quadraticApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+    appendVectorToVectorByMoving(quadraticApproximation.dfdxx, std::move(constraintTermApproximation.dfdxx));
+    appendVectorToVectorByMoving(quadraticApproximation.dfdux, std::move(constraintTermApproximation.dfdux));
+    appendVectorToVectorByMoving(quadraticApproximation.dfduu, std::move(constraintTermApproximation.dfduu));
+    i += nc;
   }
 
   return quadraticApproximation;
@@ -63,6 +63,33 @@ vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x, con
   return computeFlowMap(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapBatch(const vector_t& times, const matrix_t& states, matrix_t& derivatives) {
+  assert(controllerPtr_ != nullptr);
+  matrix_t inputs;
+  for (Eigen::Index k = 0; k < states.cols(); k++) {
+    const vector_t u = controllerPtr_->computeInput(times(k), states.col(k));
+    if (k == 0) {
+      inputs.resize(u.size(), states.cols());
+    }
+    inputs.col(k) = u;
+  }
+  computeFlowMapBatch(times, states, inputs, derivatives);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapBatch(const vector_t& times, const matrix_t& states, const matrix_t& inputs,
+                                               matrix_t& derivatives) {
+  derivatives.resize(states.rows(), states.cols());
+  for (Eigen::Index k = 0; k < states.cols(); k++) {
+    derivatives.col(k) = computeFlowMap(times(k), states.col(k), inputs.col(k));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -57,6 +57,15 @@ vector_t LinearSystemDynamics::computeFlowMap(scalar_t t, const vector_t& x, con
   return f;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::computeFlowMapBatch(const vector_t& times, const matrix_t& states, const matrix_t& inputs,
+                                               matrix_t& derivatives) {
+  derivatives.noalias() = A_ * states;
+  derivatives.noalias() += B_ * inputs;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
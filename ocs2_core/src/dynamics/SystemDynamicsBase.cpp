@@ -50,6 +50,15 @@ VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar
   return linearApproximation(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t SystemDynamicsBase::computeFlowMapJacobian(scalar_t t, const vector_t& x) {
+  assert(controllerPtr() != nullptr);
+  const vector_t u = controllerPtr()->computeInput(t, x);
+  return linearApproximation(t, x, u).dfdx;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
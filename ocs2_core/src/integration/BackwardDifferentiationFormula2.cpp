@@ -0,0 +1,414 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Eigen/LU>
+
+#include <ocs2_core/integration/BackwardDifferentiationFormula2.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Helper less comparison for both positive and negative dt case. */
+bool lessWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t2 - t1 > std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t1 - t2 > std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Helper to get the min absolute value, t1 and t2 have same sign. */
+scalar_t minAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::min(t1, t2);
+  } else {
+    return std::max(t1, t2);
+  }
+}
+
+/** Helper to get max absolute value, t1 and t2 have same sign. */
+scalar_t maxAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::max(t1, t2);
+  } else {
+    return std::min(t1, t2);
+  }
+}
+
+/** Tolerances of the Newton iterations for the equidistant integration, which has no user defined tolerances. */
+constexpr scalar_t constStepAbsTol = 1e-9;
+constexpr scalar_t constStepRelTol = 1e-9;
+
+}  // namespace
+
+/** BDF2 stepper with a workspace which is reused across steps. */
+class BackwardDifferentiationFormula2::Stepper {
+ public:
+  using system_func_t = IntegratorBase::system_func_t;
+  using jacobian_func_t = IntegratorBase::jacobian_func_t;
+
+  /**
+   * Prepares the workspace for a new integration. The step history and the Jacobian of a previous integration are discarded.
+   *
+   * @param [in] stateDim: The state dimension.
+   */
+  void reset(Eigen::Index stateDim) {
+    n_ = stateDim;
+    dtPrevious_ = 0.0;
+    isJacobianValid_ = false;
+    factorizedGamma_ = 0.0;
+    eta_ = 1.0;
+    theta_ = 1.0;
+  }
+
+  /**
+   * Try to perform one step. If the step is accepted, then state (x), derivative (dxdt), time (t) and step size (dt) are updated.
+   * Otherwise only the step size (dt) is updated and false is returned.
+   *
+   * @param [in] system: System function.
+   * @param [in] jacobian: State derivative of the system function.
+   * @param [in,out] x: current state, updated if step is taken.
+   * @param [in,out] dxdt: current derivative wrt. time, updated if step is taken.
+   * @param [in,out] t: current time, updated if step is taken.
+   * @param [in,out] dt: step size, updated if step is taken.
+   * @param [in] absTol: The absolute tolerance error for ode solver.
+   * @param [in] relTol: The relative tolerance error for ode solver.
+   * @return true if the step is taken, false otherwise.
+   */
+  bool tryStep(system_func_t& system, jacobian_func_t& jacobian, vector_t& x, vector_t& dxdt, scalar_t& t, scalar_t& dt, scalar_t absTol,
+               scalar_t relTol) {
+    const bool isFirstStep = dtPrevious_ == 0.0;
+    // limit the step size ratio for zero-stability of the variable step size formula
+    if (!isFirstStep) {
+      dt = minAbs(dt, maxStepSizeRatio * dtPrevious_);
+    }
+    if (!solve(system, jacobian, x, dxdt, t, dt, absTol, relTol)) {
+      dt *= 0.5;
+      return false;
+    }
+
+    // local error estimate from the difference between corrector and predictor
+    const scalar_t omega = isFirstStep ? 0.0 : dt / dtPrevious_;
+    const scalar_t errorConstant = isFirstStep ? 0.5 : (1.0 + omega) / (2.0 + 3.0 * omega);
+    const scalar_t errorExponent = isFirstStep ? -0.5 : -1.0 / 3.0;
+    errorEstimate_ = errorConstant * (xNext_ - xPredicted_);
+    scale_ = absTol + relTol * x.cwiseAbs().cwiseMax(xNext_.cwiseAbs()).array();
+    const scalar_t error = std::max(rmsNorm(errorEstimate_, scale_), 1e-10);
+
+    if (error > 1.0) {
+      dt *= std::max(0.9 * std::pow(error, errorExponent), 0.2);
+      // the rejected step might be due to an outdated Jacobian
+      if (!isJacobianCurrent_) {
+        isJacobianValid_ = false;
+      }
+      return false;
+    }
+
+    // accept the step
+    acceptStep(system, x, dxdt, t, dt);
+    // keep the step size for small changes to reuse the factorization
+    const scalar_t factor = std::min(std::max(0.9 * std::pow(error, errorExponent), 0.2), maxStepSizeRatio);
+    if (!isJacobianValid_ || factor < 1.0 || factor > 1.2) {
+      dt *= factor;
+    }
+    return true;
+  }
+
+  /**
+   * Perform one BDF step with a fixed step size.
+   *
+   * @param [in] system: System function.
+   * @param [in] jacobian: State derivative of the system function.
+   * @param [in,out] x: current state, updated to the next state.
+   * @param [in,out] dxdt: current derivative wrt. time, updated to the next derivative.
+   * @param [in] t: current time.
+   * @param [in] dt: step size.
+   */
+  void doStep(system_func_t& system, jacobian_func_t& jacobian, vector_t& x, vector_t& dxdt, scalar_t t, scalar_t dt) {
+    if (!solve(system, jacobian, x, dxdt, t, dt, constStepAbsTol, constStepRelTol)) {
+      throw std::runtime_error("[BackwardDifferentiationFormula2] Newton iterations did not converge, decrease the time step.");
+    }
+    acceptStep(system, x, dxdt, t, dt);
+  }
+
+ private:
+  static constexpr size_t maxNumNewtonIterations = 7;
+  static constexpr scalar_t maxStepSizeRatio = 2.0;
+
+  /** Root mean square norm of the scaled vector. */
+  static scalar_t rmsNorm(const vector_t& v, const vector_t& scale) {
+    return std::sqrt((v.array() / scale.array()).square().mean());
+  }
+
+  /** Shifts the step history. */
+  void acceptStep(system_func_t& system, vector_t& x, vector_t& dxdt, scalar_t& t, scalar_t dt) {
+    xPrevious_.swap(x);
+    x.swap(xNext_);
+    dtPrevious_ = dt;
+    t += dt;
+    system(x, dxdt, t);
+    isJacobianCurrent_ = false;
+    // the Jacobian is only re-evaluated if the Newton iterations converged slowly
+    if (theta_ > 1e-3) {
+      isJacobianValid_ = false;
+    }
+  }
+
+  /**
+   * Solves x_{n+1} = a1 x_{n} + a2 x_{n-1} + gamma f(t_{n+1}, x_{n+1}) with the simplified Newton method. If the iterations fail
+   * with an outdated Jacobian, they are repeated once with a Jacobian at the current point.
+   *
+   * @return true if the iterations converged.
+   */
+  bool solve(system_func_t& system, jacobian_func_t& jacobian, const vector_t& x, const vector_t& dxdt, scalar_t t, scalar_t dt,
+             scalar_t absTol, scalar_t relTol) {
+    // variable step size BDF2 coefficients, implicit Euler for the first step
+    scalar_t gamma;
+    if (dtPrevious_ == 0.0) {
+      gamma = dt;
+      constant_ = x;
+      xPredicted_ = x + dt * dxdt;
+    } else {
+      const scalar_t omega = dt / dtPrevious_;
+      const scalar_t den = 1.0 + 2.0 * omega;
+      gamma = dt * (1.0 + omega) / den;
+      constant_ = ((1.0 + omega) * (1.0 + omega) / den) * x - (omega * omega / den) * xPrevious_;
+      // quadratic Hermite predictor through x_{n-1}, x_{n} and dxdt_{n}
+      xPredicted_ = x + dt * dxdt + (omega * omega) * (xPrevious_ - x + dtPrevious_ * dxdt);
+    }
+
+    const scalar_t newtonTol = std::max(10.0 * std::numeric_limits<scalar_t>::epsilon() / relTol, std::min(0.03, std::sqrt(relTol)));
+    scale_ = absTol + relTol * x.cwiseAbs().array();
+
+    while (true) {
+      updateIterationMatrix(jacobian, x, t, gamma);
+      if (newtonIterations(system, t + dt, gamma, newtonTol)) {
+        return true;
+      } else if (isJacobianCurrent_) {
+        return false;
+      }
+      isJacobianValid_ = false;
+    }
+  }
+
+  /** Evaluates the Jacobian at (t, x) if the current one is outdated and factorizes the iteration matrix for gamma. */
+  void updateIterationMatrix(jacobian_func_t& jacobian, const vector_t& x, scalar_t t, scalar_t gamma) {
+    if (!isJacobianValid_) {
+      jacobian(x, jacobian_, t);
+      isJacobianValid_ = true;
+      isJacobianCurrent_ = true;
+      factorizedGamma_ = 0.0;
+    }
+
+    if (factorizedGamma_ != gamma) {
+      // I - gamma * J
+      iterationMatrix_ = -gamma * jacobian_;
+      iterationMatrix_.diagonal().array() += 1.0;
+      iterationMatrixLu_.compute(iterationMatrix_);
+      factorizedGamma_ = gamma;
+    }
+  }
+
+  /** Simplified Newton iterations starting from the predictor. */
+  bool newtonIterations(system_func_t& system, scalar_t tNext, scalar_t gamma, scalar_t newtonTol) {
+    xNext_ = xPredicted_;
+    eta_ = std::pow(std::max(eta_, std::numeric_limits<scalar_t>::epsilon()), 0.8);
+
+    scalar_t dxNormPrevious = 0.0;
+    for (size_t k = 0; k < maxNumNewtonIterations; k++) {
+      system(xNext_, derivative_, tNext);
+      residual_ = constant_ + gamma * derivative_ - xNext_;
+      dx_ = iterationMatrixLu_.solve(residual_);
+      xNext_ += dx_;
+
+      const scalar_t dxNorm = rmsNorm(dx_, scale_);
+      if (!std::isfinite(dxNorm)) {
+        return false;
+      }
+      if (k > 0) {
+        theta_ = dxNorm / dxNormPrevious;
+        if (theta_ >= 0.99) {
+          return false;
+        }
+        eta_ = theta_ / (1.0 - theta_);
+      }
+      if (eta_ * dxNorm <= newtonTol) {
+        return true;
+      }
+      dxNormPrevious = dxNorm;
+    }
+    return false;
+  }
+
+  Eigen::Index n_ = 0;
+  vector_t xPrevious_;
+  scalar_t dtPrevious_ = 0.0;  // zero if there is no previous step
+  matrix_t jacobian_;
+  bool isJacobianValid_ = false;    // whether the Jacobian can be used for the Newton iterations
+  bool isJacobianCurrent_ = false;  // whether the Jacobian is evaluated at the current state
+  scalar_t factorizedGamma_ = 0.0;
+  scalar_t eta_ = 1.0;    // Newton convergence factor
+  scalar_t theta_ = 1.0;  // Newton contraction rate
+
+  // workspace
+  matrix_t iterationMatrix_;
+  Eigen::PartialPivLU<matrix_t> iterationMatrixLu_;
+  vector_t constant_, xPredicted_, xNext_, derivative_, residual_, dx_, scale_, errorEstimate_;
+};
+
+constexpr size_t BackwardDifferentiationFormula2::Stepper::maxNumNewtonIterations;
+constexpr scalar_t BackwardDifferentiationFormula2::Stepper::maxStepSizeRatio;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BackwardDifferentiationFormula2::BackwardDifferentiationFormula2(std::shared_ptr<SystemEventHandler> eventHandlerPtr)
+    : IntegratorBase(std::move(eventHandlerPtr)), stepperPtr_(new Stepper) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BackwardDifferentiationFormula2::~BackwardDifferentiationFormula2() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BackwardDifferentiationFormula2::runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                                        scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
+  finalTime += 0.1 * dt;
+
+  stepperPtr_->reset(initialState.size());
+  scalar_t t = startTime;
+  vector_t x = initialState;
+  vector_t dxdt;
+  system(x, dxdt, t);
+  size_t step = 0;
+  while (lessWithSign(t + dt, finalTime, dt)) {
+    observer(x, t);
+    stepperPtr_->doStep(system, systemJacobian_, x, dxdt, t, dt);
+    step++;
+    t = startTime + step * dt;
+  }
+  observer(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BackwardDifferentiationFormula2::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                                           scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t absTol,
+                                                           scalar_t relTol) {
+  stepperPtr_->reset(initialState.size());
+  scalar_t t = startTime;
+  scalar_t dt = dtInitial;
+  bool isFirstStep = true;
+  vector_t x = initialState;
+  vector_t dxdt;
+  system(x, dxdt, t);
+
+  while (lessWithSign(t, finalTime, dt)) {
+    observer(x, t);
+
+    if (lessWithSign(finalTime, t + dt, dt)) {
+      dt = finalTime - t;
+    }
+
+    size_t tries = 0;
+    while (!stepperPtr_->tryStep(system, systemJacobian_, x, dxdt, t, dt, absTol, relTol)) {
+      tries++;
+      if (tries > maxNumStepsRetries_) {
+        throw std::runtime_error("[BackwardDifferentiationFormula2] Max number of iterations exceeded");
+      }
+    }  // end of while loop
+
+    if (isFirstStep) {
+      setWarmStartTimeStep(dt);
+      isFirstStep = false;
+    }
+  }    // end of while loop
+  observer(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BackwardDifferentiationFormula2::runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                                        typename scalar_array_t::const_iterator beginTimeItr,
+                                                        typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial,
+                                                        scalar_t absTol, scalar_t relTol) {
+  stepperPtr_->reset(initialState.size());
+  scalar_t dt = dtInitial;
+  bool isFirstStep = true;
+  vector_t x = initialState;
+  vector_t dxdt;
+  system(x, dxdt, *beginTimeItr);
+
+  while (true) {
+    scalar_t t = *beginTimeItr++;
+    observer(x, t);
+
+    if (beginTimeItr == endTimeItr) {
+      break;
+    }
+
+    size_t tries = 0;
+    while (lessWithSign(t, *beginTimeItr, dt)) {
+      // adjust stepsize to end up exactly at the observation point
+      scalar_t dtCurrent = minAbs(dt, *beginTimeItr - t);
+      if (stepperPtr_->tryStep(system, systemJacobian_, x, dxdt, t, dtCurrent, absTol, relTol)) {
+        tries = 0;
+        // continue with the original step size if dt was reduced due to observation
+        dt = maxAbs(dt, dtCurrent);
+        if (isFirstStep) {
+          setWarmStartTimeStep(dt);
+          isFirstStep = false;
+        }
+      } else {
+        tries++;
+        dt = dtCurrent;
+        if (tries > maxNumStepsRetries_) {
+          throw std::runtime_error("[BackwardDifferentiationFormula2] Max number of iterations exceeded");
+        }
+      }
+    }  // end of while loop
+  }    // end of while loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+constexpr size_t BackwardDifferentiationFormula2::maxNumStepsRetries_;
+
+}  // namespace ocs2
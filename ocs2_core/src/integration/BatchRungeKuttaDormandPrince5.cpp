@@ -0,0 +1,294 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/integration/BatchRungeKuttaDormandPrince5.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace ocs2 {
+
+namespace {
+
+/** Helper less comparison for both positive and negative dt case. */
+bool lessWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t2 - t1 > std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t1 - t2 > std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Decrease the step size of a rejected step. */
+scalar_t decreaseStep(scalar_t dt, scalar_t error) {
+  constexpr int ERROR_ORDER = 4;
+  return dt * std::max(0.9 * std::pow(error, -1.0 / (ERROR_ORDER - 1)), 0.2);
+}
+
+/** Increase the step size of an accepted step. */
+scalar_t increaseStep(scalar_t dt, scalar_t error) {
+  constexpr int STEPPER_ORDER = 5;
+  if (error < 0.5) {
+    error = std::max(std::pow(scalar_t(5.0), -STEPPER_ORDER), error);
+    dt *= 0.9 * std::pow(error, -1.0 / STEPPER_ORDER);
+  }
+  return dt;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRungeKuttaDormandPrince5::integrateConst(OdeBase& system, std::vector<Observer>& observers, const matrix_t& initialStates,
+                                                   scalar_t startTime, scalar_t finalTime, scalar_t dt, int maxNumSteps) {
+  const auto batchSize = initialStates.cols();
+  if (observers.size() != static_cast<size_t>(batchSize)) {
+    throw std::runtime_error("[BatchRungeKuttaDormandPrince5] The number of observers should be equal to the number of trajectories.");
+  }
+  auto observe = [&](const matrix_t& x, scalar_t t) {
+    for (Eigen::Index k = 0; k < batchSize; k++) {
+      observers[k].observe(x.col(k), t);
+    }
+  };
+
+  // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
+  finalTime += 0.1 * dt;
+
+  scalar_t t = startTime;
+  const vector_t stepSizes = vector_t::Constant(batchSize, dt);
+  matrix_t x = initialStates;
+  matrix_t dxdt;
+  evaluate(system, vector_t::Constant(batchSize, t), x, dxdt, maxNumSteps);
+  size_t step = 0;
+  while (lessWithSign(t + dt, finalTime, dt)) {
+    observe(x, t);
+    doStep(system, x, dxdt, vector_t::Constant(batchSize, t), stepSizes, x, dxdt, maxNumSteps);
+    step++;
+    t = startTime + step * dt;
+  }
+  observe(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRungeKuttaDormandPrince5::integrateAdaptive(OdeBase& system, std::vector<Observer>& observers, const matrix_t& initialStates,
+                                                      scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t absTol,
+                                                      scalar_t relTol, int maxNumSteps) {
+  const auto batchSize = initialStates.cols();
+  if (observers.size() != static_cast<size_t>(batchSize)) {
+    throw std::runtime_error("[BatchRungeKuttaDormandPrince5] The number of observers should be equal to the number of trajectories.");
+  }
+
+  // the columns hold the trajectories which have not reached the final time yet, indices maps them to the observers
+  std::vector<Eigen::Index> indices(batchSize);
+  vector_t t = vector_t::Constant(batchSize, startTime);
+  vector_t dt = vector_t::Constant(batchSize, dtInitial);
+  matrix_t x = initialStates;
+  matrix_t dxdt;
+  evaluate(system, t, x, dxdt, maxNumSteps);
+
+  std::vector<size_t> tries(batchSize, 0);
+  std::vector<bool> isActive(batchSize);
+  for (Eigen::Index k = 0; k < batchSize; k++) {
+    indices[k] = k;
+    observers[k].observe(x.col(k), t(k));
+    isActive[k] = lessWithSign(t(k), finalTime, dt(k));
+  }
+  removeFinishedTrajectories(isActive, indices, tries, t, dt, x, dxdt);
+
+  matrix_t x_out, dxdt_out;
+  while (!indices.empty()) {
+    const auto numActive = x.cols();
+    for (Eigen::Index i = 0; i < numActive; i++) {
+      if (lessWithSign(finalTime, t(i) + dt(i), dt(i))) {
+        dt(i) = finalTime - t(i);
+      }
+    }
+
+    doStep(system, x, dxdt, t, dt, x_out, dxdt_out, maxNumSteps);
+    const vector_t errors = maxError(x, dxdt, dxdt_out, dt, absTol, relTol);
+
+    for (Eigen::Index i = 0; i < numActive; i++) {
+      if (errors(i) > 1.0) {
+        dt(i) = decreaseStep(dt(i), errors(i));
+        if (++tries[i] > maxNumStepsRetries_) {
+          throw std::runtime_error("[BatchRungeKuttaDormandPrince5] Max number of iterations exceeded");
+        }
+      } else {
+        // accept the step
+        t(i) += dt(i);
+        x.col(i) = x_out.col(i);
+        dxdt.col(i) = dxdt_out.col(i);
+        dt(i) = increaseStep(dt(i), errors(i));
+        tries[i] = 0;
+        observers[indices[i]].observe(x.col(i), t(i));
+      }
+      isActive[i] = lessWithSign(t(i), finalTime, dt(i));
+    }  // end of i loop
+
+    removeFinishedTrajectories(isActive, indices, tries, t, dt, x, dxdt);
+  }  // end of while loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRungeKuttaDormandPrince5::removeFinishedTrajectories(const std::vector<bool>& isActive, std::vector<Eigen::Index>& indices,
+                                                               std::vector<size_t>& tries, vector_t& t, vector_t& dt, matrix_t& x,
+                                                               matrix_t& dxdt) const {
+  const auto batchSize = x.cols();
+  Eigen::Index numActive = 0;
+  for (Eigen::Index i = 0; i < batchSize; i++) {
+    if (isActive[i]) {
+      if (numActive != i) {
+        indices[numActive] = indices[i];
+        tries[numActive] = tries[i];
+        t(numActive) = t(i);
+        dt(numActive) = dt(i);
+        x.col(numActive) = x.col(i);
+        dxdt.col(numActive) = dxdt.col(i);
+      }
+      numActive++;
+    }
+  }
+
+  if (numActive < batchSize) {
+    indices.resize(numActive);
+    tries.resize(numActive);
+    t.conservativeResize(numActive);
+    dt.conservativeResize(numActive);
+    x.conservativeResize(Eigen::NoChange, numActive);
+    dxdt.conservativeResize(Eigen::NoChange, numActive);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRungeKuttaDormandPrince5::evaluate(OdeBase& system, const vector_t& times, const matrix_t& states, matrix_t& derivatives,
+                                             int maxNumSteps) const {
+  system.computeFlowMapBatch(times, states, derivatives);
+  // max number of function calls
+  if (system.incrementNumFunctionCalls() > static_cast<size_t>(maxNumSteps)) {
+    std::stringstream msg;
+    msg << "Integration terminated since the maximum number of function calls is reached. Times at termination:\n["
+        << times.transpose() << "]\n";
+    throw std::runtime_error(msg.str());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRungeKuttaDormandPrince5::doStep(OdeBase& system, const matrix_t& x0, const matrix_t& dxdt, const vector_t& t,
+                                           const vector_t& dt, matrix_t& x_out, matrix_t& dxdt_out, int maxNumSteps) {
+  /* Runge Kutta Dormand-Prince Butcher tableau constants.
+   * https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method */
+  constexpr scalar_t a2 = 1.0 / 5;
+  constexpr scalar_t a3 = 3.0 / 10;
+  constexpr scalar_t a4 = 4.0 / 5;
+  constexpr scalar_t a5 = 8.0 / 9;
+
+  constexpr scalar_t b21 = 1.0 / 5;
+
+  constexpr scalar_t b31 = 3.0 / 40;
+  constexpr scalar_t b32 = 9.0 / 40;
+
+  constexpr scalar_t b41 = 44.0 / 45;
+  constexpr scalar_t b42 = -56.0 / 15;
+  constexpr scalar_t b43 = 32.0 / 9;
+
+  constexpr scalar_t b51 = 19372.0 / 6561;
+  constexpr scalar_t b52 = -25360.0 / 2187;
+  constexpr scalar_t b53 = 64448.0 / 6561;
+  constexpr scalar_t b54 = -212.0 / 729;
+
+  constexpr scalar_t b61 = 9017.0 / 3168;
+  constexpr scalar_t b62 = -355.0 / 33;
+  constexpr scalar_t b63 = 46732.0 / 5247;
+  constexpr scalar_t b64 = 49.0 / 176;
+  constexpr scalar_t b65 = -5103.0 / 18656;
+
+  constexpr scalar_t c1 = 35.0 / 384;
+  // c2 = 0
+  constexpr scalar_t c3 = 500.0 / 1113;
+  constexpr scalar_t c4 = 125.0 / 192;
+  constexpr scalar_t c5 = -2187.0 / 6784;
+  constexpr scalar_t c6 = 11.0 / 84;
+
+  // the step size of each trajectory scales its column
+  const auto dtDiag = dt.asDiagonal();
+
+  k1_ = dxdt;  // k1 = system(x, t) from previous iteration
+  x_.noalias() = x0 + (b21 * k1_) * dtDiag;
+  evaluate(system, t + a2 * dt, x_, k2_, maxNumSteps);
+  x_.noalias() = x0 + (b31 * k1_ + b32 * k2_) * dtDiag;
+  evaluate(system, t + a3 * dt, x_, k3_, maxNumSteps);
+  x_.noalias() = x0 + (b41 * k1_ + b42 * k2_ + b43 * k3_) * dtDiag;
+  evaluate(system, t + a4 * dt, x_, k4_, maxNumSteps);
+  x_.noalias() = x0 + (b51 * k1_ + b52 * k2_ + b53 * k3_ + b54 * k4_) * dtDiag;
+  evaluate(system, t + a5 * dt, x_, k5_, maxNumSteps);
+  x_.noalias() = x0 + (b61 * k1_ + b62 * k2_ + b63 * k3_ + b64 * k4_ + b65 * k5_) * dtDiag;
+  evaluate(system, t + dt, x_, k6_, maxNumSteps);
+  // update x_out and dxdt_out (x_out can be x0 and dxdt_out can be dxdt)
+  x_out = x0 + (c1 * k1_ + c3 * k3_ + c4 * k4_ + c5 * k5_ + c6 * k6_) * dtDiag;
+  evaluate(system, t + dt, x_out, dxdt_out, maxNumSteps);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t BatchRungeKuttaDormandPrince5::maxError(const matrix_t& x_old, const matrix_t& dxdt_old, const matrix_t& dxdt_out,
+                                                 const vector_t& dt, scalar_t absTol, scalar_t relTol) const {
+  constexpr scalar_t dc1 = 35.0 / 384 - 5179.0 / 57600;
+  constexpr scalar_t dc3 = 500.0 / 1113 - 7571.0 / 16695;
+  constexpr scalar_t dc4 = 125.0 / 192 - 393.0 / 640;
+  constexpr scalar_t dc5 = -2187.0 / 6784 - -92097.0 / 339200;
+  constexpr scalar_t dc6 = 11.0 / 84 - 187.0 / 2100;
+  constexpr scalar_t dc7 = -1.0 / 40;
+
+  const auto dtDiag = dt.asDiagonal();
+  const matrix_t x_err = (dc1 * k1_ + dc3 * k3_ + dc4 * k4_ + dc5 * k5_ + dc6 * k6_ + dc7 * dxdt_out) * dtDiag;
+
+  // error scale: absTol + relTol * (|x| + |dt| * |dxdt|)
+  matrix_t scale = dxdt_old.cwiseAbs() * dt.cwiseAbs().asDiagonal();
+  scale += x_old.cwiseAbs();
+  const matrix_t err = x_err.array().abs() / (absTol + relTol * scale.array());
+  return err.colwise().maxCoeff().transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+constexpr size_t BatchRungeKuttaDormandPrince5::maxNumStepsRetries_;
+
+}  // namespace ocs2
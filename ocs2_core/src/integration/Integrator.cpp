@@ -28,7 +28,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include <unordered_map>
 
+#include <ocs2_core/integration/BackwardDifferentiationFormula2.h>
 #include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/integration/RadauIIA5.h>
 #include <ocs2_core/integration/RungeKuttaDormandPrince5.h>
 #include <ocs2_core/integration/implementation/Integrator.h>
 
@@ -49,7 +51,9 @@ std::string toString(IntegratorType integratorType) {
       {IntegratorType::MODIFIED_MIDPOINT, "MODIFIED_MIDPOINT"},
       {IntegratorType::RK4, "RK4"},
       {IntegratorType::RK5_VARIABLE, "RK5_VARIABLE"},
-      {IntegratorType::ADAMS_BASHFORTH_MOULTON, "ADAMS_BASHFORTH_MOULTON"}};
+      {IntegratorType::ADAMS_BASHFORTH_MOULTON, "ADAMS_BASHFORTH_MOULTON"},
+      {IntegratorType::RADAU_IIA5, "RADAU_IIA5"},
+      {IntegratorType::BDF2, "BDF2"}};
 
   return integratorMap.at(integratorType);
 }
@@ -67,7 +71,9 @@ IntegratorType fromString(const std::string& name) {
       {"MODIFIED_MIDPOINT", IntegratorType::MODIFIED_MIDPOINT},
       {"RK4", IntegratorType::RK4},
       {"RK5_VARIABLE", IntegratorType::RK5_VARIABLE},
-      {"ADAMS_BASHFORTH_MOULTON", IntegratorType::ADAMS_BASHFORTH_MOULTON}};
+      {"ADAMS_BASHFORTH_MOULTON", IntegratorType::ADAMS_BASHFORTH_MOULTON},
+      {"RADAU_IIA5", IntegratorType::RADAU_IIA5},
+      {"BDF2", IntegratorType::BDF2}};
 
   return integratorMap.at(name);
 }
@@ -95,6 +101,10 @@ std::unique_ptr<IntegratorBase> newIntegrator(IntegratorType integratorType, con
       return std::unique_ptr<IntegratorBase>(new IntegratorRK4(eventHandlerPtr));
     case (IntegratorType::RK5_VARIABLE):
       return std::unique_ptr<IntegratorBase>(new IntegratorRK5Variable(eventHandlerPtr));
+    case (IntegratorType::RADAU_IIA5):
+      return std::unique_ptr<IntegratorBase>(new RadauIIA5(eventHandlerPtr));
+    case (IntegratorType::BDF2):
+      return std::unique_ptr<IntegratorBase>(new BackwardDifferentiationFormula2(eventHandlerPtr));
 #if (BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 > 55)
     case (IntegratorType::ADAMS_BASHFORTH_MOULTON):
       return std::unique_ptr<IntegratorBase>(new IntegratorAdamsBashforthMoulton<1>(eventHandlerPtr));
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/integration/IntegratorBase.h>
 
+#include <iterator>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -57,6 +59,13 @@ IntegratorBase::system_func_t IntegratorBase::systemFunction(OdeBase& system, in
   };
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+IntegratorBase::jacobian_func_t IntegratorBase::jacobianFunction(OdeBase& system) const {
+  return [&system](const vector_t& x, matrix_t& dfdx, scalar_t t) { dfdx = system.computeFlowMapJacobian(t, x); };
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -66,6 +75,7 @@ void IntegratorBase::integrateConst(OdeBase& system, Observer& observer, const v
     observer.observe(x, t);
     eventHandlerPtr_->handleEvent(system, t, x);
   };
+  setSystemJacobian(jacobianFunction(system));
   runIntegrateConst(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dt);
 }
 
@@ -79,6 +89,8 @@ void IntegratorBase::integrateAdaptive(OdeBase& system, Observer& observer, cons
     observer.observe(x, t);
     eventHandlerPtr_->handleEvent(system, t, x);
   };
+  setSystemJacobian(jacobianFunction(system));
+  dtInitial = initialTimeStep(startTime, finalTime, dtInitial);
   runIntegrateAdaptive(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dtInitial, AbsTol, RelTol);
 }
 
@@ -94,7 +106,57 @@ void IntegratorBase::integrateTimes(OdeBase& system, Observer& observer, const v
     observer.observe(x, t);
     eventHandlerPtr_->handleEvent(system, t, x);
   };
+  setSystemJacobian(jacobianFunction(system));
+  if (beginTimeItr != endTimeItr) {
+    dtInitial = initialTimeStep(*beginTimeItr, *std::prev(endTimeItr), dtInitial);
+  }
   runIntegrateTimes(systemFunction(system, maxNumSteps), callback, initialState, beginTimeItr, endTimeItr, dtInitial, AbsTol, RelTol);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IntegratorBase::setStepSizeWarmStart(bool enable) {
+  useStepSizeWarmStart_ = enable;
+  resetStepSizeWarmStart();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IntegratorBase::resetStepSizeWarmStart() {
+  warmStartCache_.fill(WarmStart{0.0, 0.0, 0.0});
+  nextWarmStartIndex_ = 0;
+  activeWarmStartIndex_ = warmStartCacheSize_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t IntegratorBase::initialTimeStep(scalar_t startTime, scalar_t finalTime, scalar_t dtInitial) {
+  if (!useStepSizeWarmStart_) {
+    activeWarmStartIndex_ = warmStartCacheSize_;
+    return dtInitial;
+  }
+
+  for (size_t i = 0; i < warmStartCacheSize_; i++) {
+    const auto& warmStart = warmStartCache_[i];
+    if (warmStart.startTime == startTime && warmStart.finalTime == finalTime) {
+      activeWarmStartIndex_ = i;
+      // the warm start is only used for the same integration direction
+      return (warmStart.timeStep * dtInitial > 0.0) ? warmStart.timeStep : dtInitial;
+    }
+  }
+
+  activeWarmStartIndex_ = nextWarmStartIndex_;
+  nextWarmStartIndex_ = (nextWarmStartIndex_ + 1) % warmStartCacheSize_;
+  warmStartCache_[activeWarmStartIndex_] = WarmStart{startTime, finalTime, 0.0};
+  return dtInitial;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+constexpr size_t IntegratorBase::warmStartCacheSize_;
+
 }  // namespace ocs2
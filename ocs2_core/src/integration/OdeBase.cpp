@@ -29,8 +29,38 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/integration/OdeBase.h>
 
+#include <cmath>
+#include <limits>
+
 namespace ocs2 {
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OdeBase::computeFlowMapBatch(const vector_t& times, const matrix_t& states, matrix_t& derivatives) {
+  derivatives.resize(states.rows(), states.cols());
+  for (Eigen::Index k = 0; k < states.cols(); k++) {
+    derivatives.col(k) = computeFlowMap(times(k), states.col(k));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t OdeBase::computeFlowMapJacobian(scalar_t t, const vector_t& x) {
+  const scalar_t sqrtEps = std::sqrt(std::numeric_limits<scalar_t>::epsilon());
+  const vector_t f = computeFlowMap(t, x);
+  matrix_t jacobian(f.rows(), x.rows());
+  vector_t xPerturbed = x;
+  for (Eigen::Index i = 0; i < x.rows(); i++) {
+    const scalar_t h = sqrtEps * std::max(scalar_t(1.0), std::abs(x(i)));
+    xPerturbed(i) = x(i) + h;
+    jacobian.col(i) = (computeFlowMap(t, xPerturbed) - f) / h;
+    xPerturbed(i) = x(i);
+  }
+  return jacobian;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,431 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Eigen/LU>
+
+#include <ocs2_core/integration/RadauIIA5.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Helper less comparison for both positive and negative dt case. */
+bool lessWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t2 - t1 > std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t1 - t2 > std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Helper to get the min absolute value, t1 and t2 have same sign. */
+scalar_t minAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::min(t1, t2);
+  } else {
+    return std::max(t1, t2);
+  }
+}
+
+/** Helper to get max absolute value, t1 and t2 have same sign. */
+scalar_t maxAbs(scalar_t t1, scalar_t t2) {
+  if (t1 > 0) {
+    return std::max(t1, t2);
+  } else {
+    return std::min(t1, t2);
+  }
+}
+
+/** Tolerances of the Newton iterations for the equidistant integration, which has no user defined tolerances. */
+constexpr scalar_t constStepAbsTol = 1e-9;
+constexpr scalar_t constStepRelTol = 1e-9;
+
+}  // namespace
+
+/** Radau IIA stepper with a workspace which is reused across steps. */
+class RadauIIA5::Stepper {
+ public:
+  using system_func_t = IntegratorBase::system_func_t;
+  using jacobian_func_t = IntegratorBase::jacobian_func_t;
+
+  /** Constructor */
+  Stepper() {
+    const scalar_t sqrt6 = std::sqrt(6.0);
+    c_ << (4.0 - sqrt6) / 10.0, (4.0 + sqrt6) / 10.0, 1.0;
+    a_ << (88.0 - 7.0 * sqrt6) / 360.0, (296.0 - 169.0 * sqrt6) / 1800.0, (-2.0 + 3.0 * sqrt6) / 225.0,  // clang-format off
+          (296.0 + 169.0 * sqrt6) / 1800.0, (88.0 + 7.0 * sqrt6) / 360.0, (-2.0 - 3.0 * sqrt6) / 225.0,
+          (16.0 - sqrt6) / 36.0, (16.0 + sqrt6) / 36.0, 1.0 / 9.0;  // clang-format on
+    errorWeights_ << -(13.0 + 7.0 * sqrt6) / 3.0, (-13.0 + 7.0 * sqrt6) / 3.0, -1.0 / 3.0;
+    errorGamma_ = 30.0 / (6.0 + std::cbrt(81.0) - std::cbrt(9.0));
+  }
+
+  /**
+   * Prepares the workspace for a new integration. The Jacobian of a previous integration is discarded.
+   *
+   * @param [in] stateDim: The state dimension.
+   */
+  void reset(Eigen::Index stateDim) {
+    n_ = stateDim;
+    isJacobianValid_ = false;
+    factorizedStepSize_ = 0.0;
+    eta_ = 1.0;
+    theta_ = 1.0;
+  }
+
+  /**
+   * Try to perform one step. If the step is accepted, then state (x), derivative (dxdt), time (t) and step size (dt) are updated.
+   * Otherwise only the step size (dt) is updated and false is returned.
+   *
+   * @param [in] system: System function.
+   * @param [in] jacobian: State derivative of the system function.
+   * @param [in,out] x: current state, updated if step is taken.
+   * @param [in,out] dxdt: current derivative wrt. time, updated if step is taken.
+   * @param [in,out] t: current time, updated if step is taken.
+   * @param [in,out] dt: step size, updated if step is taken.
+   * @param [in] absTol: The absolute tolerance error for ode solver.
+   * @param [in] relTol: The relative tolerance error for ode solver.
+   * @return true if the step is taken, false otherwise.
+   */
+  bool tryStep(system_func_t& system, jacobian_func_t& jacobian, vector_t& x, vector_t& dxdt, scalar_t& t, scalar_t& dt, scalar_t absTol,
+               scalar_t relTol) {
+    if (!solveStages(system, jacobian, x, t, dt, absTol, relTol)) {
+      dt *= 0.5;
+      return false;
+    }
+
+    // embedded error estimate of RADAU5: ((gamma / dt) I - J)^{-1} (f(x) + sum_i e_i z_i / dt)
+    xNext_ = x + z_.tail(n_);
+    errorRhs_ = dxdt;
+    for (size_t i = 0; i < numStages; i++) {
+      errorRhs_ += (errorWeights_(i) / dt) * z_.segment(i * n_, n_);
+    }
+    errorEstimate_ = errorMatrixLu_.solve(errorRhs_);
+    scale_ = absTol + relTol * x.cwiseAbs().cwiseMax(xNext_.cwiseAbs()).array();
+    const scalar_t error = std::max(rmsNorm(errorEstimate_, scale_), 1e-10);
+
+    if (error > 1.0) {
+      dt *= std::max(0.9 * std::pow(error, -0.25), 0.2);
+      // the rejected step might be due to an outdated Jacobian
+      if (!isJacobianCurrent_) {
+        isJacobianValid_ = false;
+      }
+      return false;
+    }
+
+    // accept the step
+    t += dt;
+    x.swap(xNext_);
+    system(x, dxdt, t);
+    isJacobianCurrent_ = false;
+    // the Jacobian is only re-evaluated if the Newton iterations converged slowly
+    if (theta_ > 1e-3) {
+      isJacobianValid_ = false;
+    }
+    // keep the step size for small changes to reuse the factorizations
+    const scalar_t factor = std::min(std::max(0.9 * std::pow(error, -0.25), 0.2), 8.0);
+    if (!isJacobianValid_ || factor < 1.0 || factor > 1.2) {
+      dt *= factor;
+    }
+    return true;
+  }
+
+  /**
+   * Perform one Radau IIA step with a fixed step size.
+   *
+   * @param [in] system: System function.
+   * @param [in] jacobian: State derivative of the system function.
+   * @param [in,out] x: current state, updated to the next state.
+   * @param [in] t: current time.
+   * @param [in] dt: step size.
+   */
+  void doStep(system_func_t& system, jacobian_func_t& jacobian, vector_t& x, scalar_t t, scalar_t dt) {
+    if (!solveStages(system, jacobian, x, t, dt, constStepAbsTol, constStepRelTol)) {
+      throw std::runtime_error("[RadauIIA5] Newton iterations did not converge, decrease the time step.");
+    }
+    x += z_.tail(n_);
+    isJacobianCurrent_ = false;
+    if (theta_ > 1e-3) {
+      isJacobianValid_ = false;
+    }
+  }
+
+ private:
+  static constexpr size_t numStages = 3;
+  static constexpr size_t maxNumNewtonIterations = 7;
+
+  /** Root mean square norm of the scaled vector. */
+  static scalar_t rmsNorm(const vector_t& v, const vector_t& scale) {
+    return std::sqrt((v.array() / scale.array()).square().mean());
+  }
+
+  /** Evaluates the Jacobian at (t, x) if the current one is outdated and factorizes the iteration matrices for dt. */
+  void updateIterationMatrices(jacobian_func_t& jacobian, const vector_t& x, scalar_t t, scalar_t dt) {
+    if (!isJacobianValid_) {
+      jacobian(x, jacobian_, t);
+      isJacobianValid_ = true;
+      isJacobianCurrent_ = true;
+      factorizedStepSize_ = 0.0;
+    }
+
+    if (factorizedStepSize_ != dt) {
+      // I - dt * (A kron J)
+      iterationMatrix_.resize(numStages * n_, numStages * n_);
+      for (size_t i = 0; i < numStages; i++) {
+        for (size_t j = 0; j < numStages; j++) {
+          iterationMatrix_.block(i * n_, j * n_, n_, n_) = (-dt * a_(i, j)) * jacobian_;
+        }
+      }
+      iterationMatrix_.diagonal().array() += 1.0;
+      iterationMatrixLu_.compute(iterationMatrix_);
+
+      // (gamma / dt) I - J
+      errorMatrix_ = -jacobian_;
+      errorMatrix_.diagonal().array() += errorGamma_ / dt;
+      errorMatrixLu_.compute(errorMatrix_);
+
+      factorizedStepSize_ = dt;
+    }
+  }
+
+  /**
+   * Solves the collocation equations z_i = dt * sum_j a_ij f(t + c_j dt, x + z_j) with the simplified Newton method. If the
+   * iterations fail with an outdated Jacobian, they are repeated once with a Jacobian at the current point.
+   *
+   * @return true if the iterations converged.
+   */
+  bool solveStages(system_func_t& system, jacobian_func_t& jacobian, const vector_t& x, scalar_t t, scalar_t dt, scalar_t absTol,
+                   scalar_t relTol) {
+    const scalar_t newtonTol = std::max(10.0 * std::numeric_limits<scalar_t>::epsilon() / relTol, std::min(0.03, std::sqrt(relTol)));
+    scale_ = (absTol + relTol * x.cwiseAbs().array()).replicate(numStages, 1);
+
+    while (true) {
+      updateIterationMatrices(jacobian, x, t, dt);
+      if (newtonIterations(system, x, t, dt, newtonTol)) {
+        return true;
+      } else if (isJacobianCurrent_) {
+        return false;
+      }
+      isJacobianValid_ = false;
+    }
+  }
+
+  /** Simplified Newton iterations on the stage increments. */
+  bool newtonIterations(system_func_t& system, const vector_t& x, scalar_t t, scalar_t dt, scalar_t newtonTol) {
+    z_.setZero(numStages * n_);
+    stageDerivatives_.resize(numStages * n_);
+    residual_.resize(numStages * n_);
+    eta_ = std::pow(std::max(eta_, std::numeric_limits<scalar_t>::epsilon()), 0.8);
+
+    scalar_t dzNormPrevious = 0.0;
+    for (size_t k = 0; k < maxNumNewtonIterations; k++) {
+      for (size_t i = 0; i < numStages; i++) {
+        stageState_ = x + z_.segment(i * n_, n_);
+        system(stageState_, stageDerivative_, t + c_(i) * dt);
+        stageDerivatives_.segment(i * n_, n_) = stageDerivative_;
+      }
+
+      // residual of the collocation equations
+      for (size_t i = 0; i < numStages; i++) {
+        auto residual_i = residual_.segment(i * n_, n_);
+        residual_i = -z_.segment(i * n_, n_);
+        for (size_t j = 0; j < numStages; j++) {
+          residual_i += (dt * a_(i, j)) * stageDerivatives_.segment(j * n_, n_);
+        }
+      }
+
+      dz_ = iterationMatrixLu_.solve(residual_);
+      z_ += dz_;
+
+      const scalar_t dzNorm = rmsNorm(dz_, scale_);
+      if (!std::isfinite(dzNorm)) {
+        return false;
+      }
+      if (k > 0) {
+        theta_ = dzNorm / dzNormPrevious;
+        if (theta_ >= 0.99) {
+          return false;
+        }
+        eta_ = theta_ / (1.0 - theta_);
+      }
+      if (eta_ * dzNorm <= newtonTol) {
+        return true;
+      }
+      dzNormPrevious = dzNorm;
+    }
+    return false;
+  }
+
+  // Butcher tableau and error estimate coefficients
+  Eigen::Matrix<scalar_t, 3, 1> c_;
+  Eigen::Matrix<scalar_t, 3, 3> a_;
+  Eigen::Matrix<scalar_t, 3, 1> errorWeights_;
+  scalar_t errorGamma_;
+
+  Eigen::Index n_ = 0;
+  matrix_t jacobian_;
+  bool isJacobianValid_ = false;    // whether the Jacobian can be used for the Newton iterations
+  bool isJacobianCurrent_ = false;  // whether the Jacobian is evaluated at the current state
+  scalar_t factorizedStepSize_ = 0.0;
+  scalar_t eta_ = 1.0;    // Newton convergence factor
+  scalar_t theta_ = 1.0;  // Newton contraction rate
+
+  // workspace
+  matrix_t iterationMatrix_;
+  Eigen::PartialPivLU<matrix_t> iterationMatrixLu_;
+  matrix_t errorMatrix_;
+  Eigen::PartialPivLU<matrix_t> errorMatrixLu_;
+  vector_t z_, dz_, residual_, stageDerivatives_, scale_;
+  vector_t stageState_, stageDerivative_, xNext_, errorRhs_, errorEstimate_;
+};
+
+constexpr size_t RadauIIA5::Stepper::numStages;
+constexpr size_t RadauIIA5::Stepper::maxNumNewtonIterations;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RadauIIA5::RadauIIA5(std::shared_ptr<SystemEventHandler> eventHandlerPtr)
+    : IntegratorBase(std::move(eventHandlerPtr)), stepperPtr_(new Stepper) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RadauIIA5::~RadauIIA5() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RadauIIA5::runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                                  scalar_t finalTime, scalar_t dt) {
+  // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
+  finalTime += 0.1 * dt;
+
+  stepperPtr_->reset(initialState.size());
+  scalar_t t = startTime;
+  vector_t x = initialState;
+  size_t step = 0;
+  while (lessWithSign(t + dt, finalTime, dt)) {
+    observer(x, t);
+    stepperPtr_->doStep(system, systemJacobian_, x, t, dt);
+    step++;
+    t = startTime + step * dt;
+  }
+  observer(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RadauIIA5::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                                     scalar_t finalTime, scalar_t dtInitial, scalar_t absTol, scalar_t relTol) {
+  stepperPtr_->reset(initialState.size());
+  scalar_t t = startTime;
+  scalar_t dt = dtInitial;
+  bool isFirstStep = true;
+  vector_t x = initialState;
+  vector_t dxdt;
+  system(x, dxdt, t);
+
+  while (lessWithSign(t, finalTime, dt)) {
+    observer(x, t);
+
+    if (lessWithSign(finalTime, t + dt, dt)) {
+      dt = finalTime - t;
+    }
+
+    size_t tries = 0;
+    while (!stepperPtr_->tryStep(system, systemJacobian_, x, dxdt, t, dt, absTol, relTol)) {
+      tries++;
+      if (tries > maxNumStepsRetries_) {
+        throw std::runtime_error("[RadauIIA5] Max number of iterations exceeded");
+      }
+    }  // end of while loop
+
+    if (isFirstStep) {
+      setWarmStartTimeStep(dt);
+      isFirstStep = false;
+    }
+  }    // end of while loop
+  observer(x, t);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RadauIIA5::runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                  typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                                  scalar_t dtInitial, scalar_t absTol, scalar_t relTol) {
+  stepperPtr_->reset(initialState.size());
+  scalar_t dt = dtInitial;
+  bool isFirstStep = true;
+  vector_t x = initialState;
+  vector_t dxdt;
+  system(x, dxdt, *beginTimeItr);
+
+  while (true) {
+    scalar_t t = *beginTimeItr++;
+    observer(x, t);
+
+    if (beginTimeItr == endTimeItr) {
+      break;
+    }
+
+    size_t tries = 0;
+    while (lessWithSign(t, *beginTimeItr, dt)) {
+      // adjust stepsize to end up exactly at the observation point
+      scalar_t dtCurrent = minAbs(dt, *beginTimeItr - t);
+      if (stepperPtr_->tryStep(system, systemJacobian_, x, dxdt, t, dtCurrent, absTol, relTol)) {
+        tries = 0;
+        // continue with the original step size if dt was reduced due to observation
+        dt = maxAbs(dt, dtCurrent);
+        if (isFirstStep) {
+          setWarmStartTimeStep(dt);
+          isFirstStep = false;
+        }
+      } else {
+        tries++;
+        dt = dtCurrent;
+        if (tries > maxNumStepsRetries_) {
+          throw std::runtime_error("[RadauIIA5] Max number of iterations exceeded");
+        }
+      }
+    }  // end of while loop
+  }    // end of while loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+constexpr size_t RadauIIA5::maxNumStepsRetries_;
+
+}  // namespace ocs2
@@ -63,8 +63,10 @@ scalar_t maxAbs(scalar_t t1, scalar_t t2) {
   }
 }
 
+}  // namespace
+
 /** Runge Kutta Dormand-Prince stepper */
-class Stepper {
+class RungeKuttaDormandPrince5::Stepper {
  public:
   using system_func_t = IntegratorBase::system_func_t;
 
@@ -96,21 +98,20 @@ class Stepper {
     constexpr scalar_t dc6 = c6 - 187.0 / 2100;
     constexpr scalar_t dc7 = -1.0 / 40;
 
-    vector_t x_out, dxdt_out;
-    doStep(system, x, dxdt, t, dt, x_out, dxdt_out);
+    doStep(system, x, dxdt, t, dt, xOut_, dxdtOut_);
 
     // error estimate
-    const vector_t x_err = dt * (dc1 * k1_ + dc3 * k3_ + dc4 * k4_ + dc5 * k5_ + dc6 * k6_ + dc7 * dxdt_out);
+    xErr_.noalias() = dt * (dc1 * k1_ + dc3 * k3_ + dc4 * k4_ + dc5 * k5_ + dc6 * k6_ + dc7 * dxdtOut_);
 
-    const scalar_t error = maxError(x, dxdt, x_err, dt, absTol, relTol);
+    const scalar_t error = maxError(x, dxdt, xErr_, dt, absTol, relTol);
     if (error > 1.0) {
       dt = decreaseStep(dt, error);
       return false;
     } else {
-      // accept the step
+      // accept the step, swapping keeps the buffers of both sides allocated
       t += dt;
-      x = x_out;
-      dxdt = dxdt_out;
+      x.swap(xOut_);
+      dxdt.swap(dxdtOut_);
       dt = increaseStep(dt, error);
       return true;
     }
@@ -164,7 +165,8 @@ class Stepper {
     constexpr scalar_t c6 = 11.0 / 84;
 
     k1_ = dxdt;  // k1 = system(x, t) from previous iteration
-    vector_t x = x0 + dt * b21 * k1_;
+    auto& x = xTmp_;
+    x.noalias() = x0 + dt * b21 * k1_;
     system(x, k2_, t + dt * a2);
     x.noalias() = x0 + dt * b31 * k1_ + dt * b32 * k2_;
     system(x, k3_, t + dt * a3);
@@ -193,8 +195,7 @@ class Stepper {
    */
   static scalar_t maxError(const vector_t& x_old, const vector_t& dxdt_old, const vector_t& x_err, scalar_t dt, scalar_t absTol,
                            scalar_t relTol) {
-    const vector_t err = x_err.array() / (absTol + relTol * (x_old.array().abs() + std::abs(dt) * dxdt_old.array().abs()));
-    return err.lpNorm<Eigen::Infinity>();
+    return (x_err.array() / (absTol + relTol * (x_old.array().abs() + std::abs(dt) * dxdt_old.array().abs()))).abs().maxCoeff();
   }
 
   /**
@@ -228,9 +229,20 @@ class Stepper {
 
   /** intermediate derivatives during Runge-Kutta step. */
   vector_t k1_, k2_, k3_, k4_, k5_, k6_;
+  /** intermediate state, proposed state, its derivative, and its error estimate. */
+  vector_t xTmp_, xOut_, dxdtOut_, xErr_;
 };
 
-}  // namespace
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RungeKuttaDormandPrince5::RungeKuttaDormandPrince5(std::shared_ptr<SystemEventHandler> eventHandlerPtr)
+    : IntegratorBase(std::move(eventHandlerPtr)), stepperPtr_(new Stepper) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RungeKuttaDormandPrince5::~RungeKuttaDormandPrince5() = default;
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -242,7 +254,7 @@ void RungeKuttaDormandPrince5::runIntegrateConst(system_func_t system, observer_
   // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
   finalTime += 0.1 * dt;
 
-  Stepper stepper;
+  auto& stepper = *stepperPtr_;
   scalar_t t = startTime;
   vector_t x = initialState;
   vector_t dxdt;
@@ -263,9 +275,10 @@ void RungeKuttaDormandPrince5::runIntegrateConst(system_func_t system, observer_
 void RungeKuttaDormandPrince5::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState,
                                                     scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t absTol,
                                                     scalar_t relTol) {
-  Stepper stepper;
+  auto& stepper = *stepperPtr_;
   scalar_t t = startTime;
   scalar_t dt = dtInitial;
+  bool isFirstStep = true;
   vector_t x = initialState;
   vector_t dxdt;
   system(x, dxdt, t);
@@ -284,6 +297,11 @@ void RungeKuttaDormandPrince5::runIntegrateAdaptive(system_func_t system, observ
         throw std::runtime_error("[RungeKuttaDormandPrince5] Max number of iterations exceeded");
       }
     }  // end of while loop
+
+    if (isFirstStep) {
+      setWarmStartTimeStep(dt);
+      isFirstStep = false;
+    }
   }    // end of while loop
   observer(x, t);
 }
@@ -295,8 +313,9 @@ void RungeKuttaDormandPrince5::runIntegrateTimes(system_func_t system, observer_
                                                  typename scalar_array_t::const_iterator beginTimeItr,
                                                  typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial, scalar_t absTol,
                                                  scalar_t relTol) {
-  Stepper stepper;
+  auto& stepper = *stepperPtr_;
   scalar_t dt = dtInitial;
+  bool isFirstStep = true;
   vector_t x = initialState;
   vector_t dxdt;
   system(x, dxdt, *beginTimeItr);
@@ -317,6 +336,10 @@ void RungeKuttaDormandPrince5::runIntegrateTimes(system_func_t system, observer_
         tries = 0;
         // continue with the original step size if dt was reduced due to observation
         dt = maxAbs(dt, dtCurrent);
+        if (isFirstStep) {
+          setWarmStartTimeStep(dt);
+          isFirstStep = false;
+        }
       } else {
         tries++;
         dt = dtCurrent;
@@ -46,6 +46,16 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
       return rk2Discretization;
     case SensitivityIntegratorType::RK4:
       return rk4Discretization;
+    case SensitivityIntegratorType::EXPONENTIAL:
+      return exponentialDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_EULER:
+      return implicitEulerDiscretization;
+    case SensitivityIntegratorType::RADAU_IIA5:
+      return radauIIA5Discretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointDiscretization;
+    case SensitivityIntegratorType::SYMPLECTIC_EULER:
+      return symplecticEulerDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -62,6 +72,16 @@ DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(Sensitivi
       return rk2SensitivityDiscretization;
     case SensitivityIntegratorType::RK4:
       return rk4SensitivityDiscretization;
+    case SensitivityIntegratorType::EXPONENTIAL:
+      return exponentialSensitivityDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_EULER:
+      return implicitEulerSensitivityDiscretization;
+    case SensitivityIntegratorType::RADAU_IIA5:
+      return radauIIA5SensitivityDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointSensitivityDiscretization;
+    case SensitivityIntegratorType::SYMPLECTIC_EULER:
+      return symplecticEulerSensitivityDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -74,7 +94,14 @@ namespace sensitivity_integrator {
 /******************************************************************************************************/
 std::string toString(SensitivityIntegratorType integratorType) {
   static const std::unordered_map<SensitivityIntegratorType, std::string> integratorMap = {
-      {SensitivityIntegratorType::EULER, "EULER"}, {SensitivityIntegratorType::RK2, "RK2"}, {SensitivityIntegratorType::RK4, "RK4"}};
+      {SensitivityIntegratorType::EULER, "EULER"},
+      {SensitivityIntegratorType::RK2, "RK2"},
+      {SensitivityIntegratorType::RK4, "RK4"},
+      {SensitivityIntegratorType::EXPONENTIAL, "EXPONENTIAL"},
+      {SensitivityIntegratorType::IMPLICIT_EULER, "IMPLICIT_EULER"},
+      {SensitivityIntegratorType::RADAU_IIA5, "RADAU_IIA5"},
+      {SensitivityIntegratorType::IMPLICIT_MIDPOINT, "IMPLICIT_MIDPOINT"},
+      {SensitivityIntegratorType::SYMPLECTIC_EULER, "SYMPLECTIC_EULER"}};
 
   return integratorMap.at(integratorType);
 }
@@ -84,7 +111,14 @@ std::string toString(SensitivityIntegratorType integratorType) {
 /******************************************************************************************************/
 SensitivityIntegratorType fromString(const std::string& name) {
   static const std::unordered_map<std::string, SensitivityIntegratorType> integratorMap = {
-      {"EULER", SensitivityIntegratorType::EULER}, {"RK2", SensitivityIntegratorType::RK2}, {"RK4", SensitivityIntegratorType::RK4}};
+      {"EULER", SensitivityIntegratorType::EULER},
+      {"RK2", SensitivityIntegratorType::RK2},
+      {"RK4", SensitivityIntegratorType::RK4},
+      {"EXPONENTIAL", SensitivityIntegratorType::EXPONENTIAL},
+      {"IMPLICIT_EULER", SensitivityIntegratorType::IMPLICIT_EULER},
+      {"RADAU_IIA5", SensitivityIntegratorType::RADAU_IIA5},
+      {"IMPLICIT_MIDPOINT", SensitivityIntegratorType::IMPLICIT_MIDPOINT},
+      {"SYMPLECTIC_EULER", SensitivityIntegratorType::SYMPLECTIC_EULER}};
 
   return integratorMap.at(name);
 }
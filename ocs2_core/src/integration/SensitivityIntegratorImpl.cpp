@@ -29,8 +29,241 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/LU>
+#include <unsupported/Eigen/MatrixFunctions>
+
 namespace ocs2 {
 
+namespace {
+
+bool isEqual(const matrix_t& lhs, const matrix_t& rhs) {
+  return lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols() && lhs == rhs;
+}
+
+using ExponentialCacheEntry = SystemDynamicsBase::ExponentialDiscretizationCache::Entry;
+
+/**
+ * Finds the entry of the exponential cache which holds the given interval duration.
+ *
+ * @param [in] cache: The exponential cache of the system.
+ * @param [in] dt: The interval duration.
+ * @return The cached entry, or nullptr if the interval duration is not cached.
+ */
+ExponentialCacheEntry* findExponentialCacheEntry(SystemDynamicsBase::ExponentialDiscretizationCache& cache, scalar_t dt) {
+  for (auto& entry : cache.entries) {
+    if (entry.dt == dt) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Updates the exponential cache of a linear time-invariant system. The exponential is only recomputed if the interval
+ * duration is not cached or the state Jacobian differs from the cached one. A new interval duration replaces the oldest
+ * entry of the cache.
+ *
+ * @param [in, out] cache: The exponential cache of the system.
+ * @param [in] dfdx: The continuous-time state Jacobian.
+ * @param [in] dt: The interval duration.
+ * @return The entry of the given interval duration.
+ */
+ExponentialCacheEntry& updateExponentialCache(SystemDynamicsBase::ExponentialDiscretizationCache& cache, const matrix_t& dfdx,
+                                              scalar_t dt) {
+  auto* entryPtr = findExponentialCacheEntry(cache, dt);
+  if (entryPtr != nullptr && isEqual(entryPtr->dfdx, dfdx)) {
+    return *entryPtr;
+  }
+  if (entryPtr == nullptr) {
+    entryPtr = &cache.entries[cache.nextEntryIndex];
+    cache.nextEntryIndex = (cache.nextEntryIndex + 1) % cache.entries.size();
+  }
+
+  // expm([A I; 0 0] * dt) = [expm(A * dt), \int_0^dt expm(A * s) ds; 0 I]
+  auto& entry = *entryPtr;
+  const auto n = dfdx.rows();
+  matrix_t augmented = matrix_t::Zero(2 * n, 2 * n);
+  augmented.topLeftCorner(n, n) = dt * dfdx;
+  augmented.topRightCorner(n, n).diagonal().setConstant(dt);
+  const matrix_t augmentedExponential = augmented.exp();
+  entry.Phi = augmentedExponential.topLeftCorner(n, n);
+  entry.Gamma = augmentedExponential.topRightCorner(n, n);
+  entry.dfdx = dfdx;
+  entry.dt = dt;
+  entry.hasGammaB = false;
+  return entry;
+}
+
+/** Maximum number of Newton iterations on the stage equations of the implicit Runge-Kutta discretizations. */
+constexpr size_t implicitMaxNumIterations = 10;
+
+/** Tolerance on the Newton step, relative to the magnitude of the state. */
+constexpr scalar_t implicitTolerance = 1e-10;
+
+/**
+ * Butcher tableau of an implicit Runge-Kutta method in stage increment form, x_{k+1} = x_{k} + sum_i d_i * Z_i with
+ * d = b^T * a^{-1}. For stiffly accurate methods the last stage coincides with x_{k+1}, i.e., d is the last unit vector.
+ */
+struct ImplicitRungeKuttaTableau {
+  matrix_t a;
+  vector_t c;
+  vector_t d;
+};
+
+const ImplicitRungeKuttaTableau& implicitEulerTableau() {
+  static const ImplicitRungeKuttaTableau tableau{matrix_t::Ones(1, 1), vector_t::Ones(1), vector_t::Ones(1)};
+  return tableau;
+}
+
+const ImplicitRungeKuttaTableau& implicitMidpointTableau() {
+  static const ImplicitRungeKuttaTableau tableau{matrix_t::Constant(1, 1, 0.5), vector_t::Constant(1, 0.5), vector_t::Constant(1, 2.0)};
+  return tableau;
+}
+
+const ImplicitRungeKuttaTableau& radauIIA5Tableau() {
+  static const ImplicitRungeKuttaTableau tableau = []() {
+    const scalar_t sqrt6 = std::sqrt(6.0);
+    ImplicitRungeKuttaTableau radau{matrix_t(3, 3), vector_t(3), vector_t::Unit(3, 2)};
+    radau.a << (88.0 - 7.0 * sqrt6) / 360.0, (296.0 - 169.0 * sqrt6) / 1800.0, (-2.0 + 3.0 * sqrt6) / 225.0,  // clang-format off
+               (296.0 + 169.0 * sqrt6) / 1800.0, (88.0 + 7.0 * sqrt6) / 360.0, (-2.0 - 3.0 * sqrt6) / 225.0,
+               (16.0 - sqrt6) / 36.0, (16.0 + sqrt6) / 36.0, 1.0 / 9.0;  // clang-format on
+    radau.c << (4.0 - sqrt6) / 10.0, (4.0 + sqrt6) / 10.0, 1.0;
+    return radau;
+  }();
+  return tableau;
+}
+
+/**
+ * Solves the stage equations Z_i = dt * sum_j a_ij * f(t + c_j * dt, x + Z_j, u) with a simplified Newton iteration. The
+ * iteration matrix I - dt * (a \otimes dfdx) is factorized once with the state Jacobian at the beginning of the interval.
+ * Returns x_{k+1} = x + sum_i d_i * Z_i
+ */
+vector_t implicitRungeKuttaDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                          const ImplicitRungeKuttaTableau& tableau) {
+  const auto numStages = tableau.c.size();
+  const auto n = x.size();
+  const matrix_t dfdx = system.linearApproximation(t, x, u).dfdx;
+
+  matrix_t iterationMatrix(numStages * n, numStages * n);
+  for (int i = 0; i < numStages; ++i) {
+    for (int j = 0; j < numStages; ++j) {
+      iterationMatrix.block(i * n, j * n, n, n) = -dt * tableau.a(i, j) * dfdx;
+    }
+  }
+  iterationMatrix.diagonal().array() += 1.0;
+  const Eigen::PartialPivLU<matrix_t> iterationMatrixLu(iterationMatrix);
+
+  const scalar_t tolerance = implicitTolerance * (1.0 + x.lpNorm<Eigen::Infinity>());
+  vector_t stages = vector_t::Zero(numStages * n);
+  matrix_t stageFlows(n, numStages);
+  vector_t residual(numStages * n);
+  for (size_t iter = 0; iter < implicitMaxNumIterations; ++iter) {
+    for (int j = 0; j < numStages; ++j) {
+      stageFlows.col(j) = system.computeFlowMap(t + tableau.c(j) * dt, x + stages.segment(j * n, n), u);
+    }
+    residual = -stages;
+    for (int i = 0; i < numStages; ++i) {
+      residual.segment(i * n, n).noalias() += dt * stageFlows * tableau.a.row(i).transpose();
+    }
+    residual = iterationMatrixLu.solve(residual);
+    stages += residual;
+    if (residual.lpNorm<Eigen::Infinity>() <= tolerance) {
+      break;
+    }
+  }
+
+  vector_t xNext = x;
+  for (int i = 0; i < numStages; ++i) {
+    xNext += tableau.d(i) * stages.segment(i * n, n);
+  }
+  return xNext;
+}
+
+/**
+ * Solves the stage equations of implicitRungeKuttaDiscretization with a full Newton iteration on the stage linearizations
+ * and differentiates the converged solution with the implicit function theorem:
+ *      (I - dt * [a_ij * dfdx_j]) * dZ = dt * [sum_j a_ij * dfdx_j] * dx + dt * [sum_j a_ij * dfdu_j] * du
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitRungeKuttaSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                              const vector_t& u, scalar_t dt,
+                                                                              const ImplicitRungeKuttaTableau& tableau) {
+  const auto numStages = tableau.c.size();
+  const auto n = x.size();
+  const auto m = u.size();
+
+  const scalar_t tolerance = implicitTolerance * (1.0 + x.lpNorm<Eigen::Infinity>());
+  std::vector<VectorFunctionLinearApproximation> stageApproximations(numStages);
+  matrix_t newtonMatrix(numStages * n, numStages * n);
+  Eigen::PartialPivLU<matrix_t> newtonMatrixLu(numStages * n);
+  vector_t stages = vector_t::Zero(numStages * n);
+  vector_t residual(numStages * n);
+  for (size_t iter = 0;; ++iter) {
+    for (int j = 0; j < numStages; ++j) {
+      stageApproximations[j] = system.linearApproximation(t + tableau.c(j) * dt, x + stages.segment(j * n, n), u);
+    }
+    residual = -stages;
+    for (int i = 0; i < numStages; ++i) {
+      for (int j = 0; j < numStages; ++j) {
+        residual.segment(i * n, n) += dt * tableau.a(i, j) * stageApproximations[j].f;
+        newtonMatrix.block(i * n, j * n, n, n) = -dt * tableau.a(i, j) * stageApproximations[j].dfdx;
+      }
+    }
+    newtonMatrix.diagonal().array() += 1.0;
+    newtonMatrixLu.compute(newtonMatrix);
+
+    // the factorization at the converged stages is reused for the sensitivities
+    if (residual.lpNorm<Eigen::Infinity>() <= tolerance || iter + 1 >= implicitMaxNumIterations) {
+      break;
+    }
+    stages += newtonMatrixLu.solve(residual);
+  }
+
+  matrix_t stagesDx = matrix_t::Zero(numStages * n, n);
+  matrix_t stagesDu = matrix_t::Zero(numStages * n, m);
+  for (int i = 0; i < numStages; ++i) {
+    for (int j = 0; j < numStages; ++j) {
+      stagesDx.middleRows(i * n, n) += dt * tableau.a(i, j) * stageApproximations[j].dfdx;
+      stagesDu.middleRows(i * n, n) += dt * tableau.a(i, j) * stageApproximations[j].dfdu;
+    }
+  }
+
+  stagesDx = newtonMatrixLu.solve(stagesDx);
+  stagesDu = newtonMatrixLu.solve(stagesDu);
+
+  // x_{k+1} = x_{k} + sum_i d_i * Z_i
+  VectorFunctionLinearApproximation discreteApproximation;
+  discreteApproximation.dfdx = matrix_t::Identity(n, n);
+  discreteApproximation.dfdu = matrix_t::Zero(n, m);
+  discreteApproximation.f = x;
+  for (int i = 0; i < numStages; ++i) {
+    discreteApproximation.dfdx += tableau.d(i) * stagesDx.middleRows(i * n, n);
+    discreteApproximation.dfdu += tableau.d(i) * stagesDu.middleRows(i * n, n);
+    discreteApproximation.f += tableau.d(i) * stages.segment(i * n, n);
+  }
+  return discreteApproximation;
+}
+
+/**
+ * Returns the dimension of the configuration q of a system with state x = [q; v].
+ * Throws if the system does not expose such a split.
+ */
+size_t getConfigurationDimension(const SystemDynamicsBase& system, const vector_t& x) {
+  const size_t configurationDim = system.getConfigurationDimension();
+  if (configurationDim == 0 || configurationDim >= static_cast<size_t>(x.size())) {
+    throw std::runtime_error("[SymplecticEuler] The system does not expose a valid (q, v) split of its state, configuration dimension: " +
+                             std::to_string(configurationDim) + ", state dimension: " + std::to_string(x.size()) + ".");
+  }
+  return configurationDim;
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -168,4 +401,145 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   return k1;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t exponentialDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  if (!system.isLinearTimeInvariant()) {
+    return rk4Discretization(system, t, x, u, dt);
+  }
+
+  // the state Jacobian is constant, hence it is only evaluated when the exponential has not been computed for this interval
+  auto& cache = system.getExponentialDiscretizationCache();
+  const auto* entryPtr = findExponentialCacheEntry(cache, dt);
+  const auto& entry = (entryPtr != nullptr) ? *entryPtr : updateExponentialCache(cache, system.linearApproximation(t, x, u).dfdx, dt);
+
+  // x_{k+1} = x_{n} + Gamma * f(x_{n},u_{n}), exact for affine time-invariant dynamics
+  vector_t tmp = x;
+  tmp.noalias() += entry.Gamma * system.computeFlowMap(t, x, u);
+  return tmp;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation exponentialSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                       const vector_t& u, scalar_t dt) {
+  if (!system.isLinearTimeInvariant()) {
+    return rk4SensitivityDiscretization(system, t, x, u, dt);
+  }
+
+  auto continuousApproximation = system.linearApproximation(t, x, u);
+  auto& entry = updateExponentialCache(system.getExponentialDiscretizationCache(), continuousApproximation.dfdx, dt);
+
+  // x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+  // A_{k} = expm(dfdx * dt)
+  // B_{k} = Gamma * dfdu, with Gamma = \int_0^dt expm(dfdx * s) ds
+  // b_{k} = x_{n} + Gamma * f(x_{n},u_{n})
+  if (!entry.hasGammaB || !isEqual(entry.dfdu, continuousApproximation.dfdu)) {
+    entry.dfdu = continuousApproximation.dfdu;
+    entry.GammaB.noalias() = entry.Gamma * entry.dfdu;
+    entry.hasGammaB = true;
+  }
+  continuousApproximation.dfdx = entry.Phi;
+  continuousApproximation.dfdu = entry.GammaB;
+  vector_t tmp = x;
+  tmp.noalias() += entry.Gamma * continuousApproximation.f;
+  continuousApproximation.f.swap(tmp);
+  return continuousApproximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitEulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaDiscretization(system, t, x, u, dt, implicitEulerTableau());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitEulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                         const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaSensitivityDiscretization(system, t, x, u, dt, implicitEulerTableau());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t radauIIA5Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaDiscretization(system, t, x, u, dt, radauIIA5Tableau());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation radauIIA5SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                     const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaSensitivityDiscretization(system, t, x, u, dt, radauIIA5Tableau());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaDiscretization(system, t, x, u, dt, implicitMidpointTableau());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaSensitivityDiscretization(system, t, x, u, dt, implicitMidpointTableau());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t symplecticEulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  const auto nq = getConfigurationDimension(system, x);
+  const auto nv = x.size() - nq;
+
+  // v_{k+1} = v_{k} + dt * f_v(q_{k}, v_{k}, u_{k})
+  vector_t xNext = x;
+  xNext.tail(nv) += dt * system.computeFlowMap(t, x, u).tail(nv);
+
+  // q_{k+1} = q_{k} + dt * f_q(q_{k}, v_{k+1}, u_{k})
+  xNext.head(nq) += dt * system.computeFlowMap(t, xNext, u).head(nq);
+  return xNext;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation symplecticEulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                           const vector_t& u, scalar_t dt) {
+  const auto nq = getConfigurationDimension(system, x);
+  const auto nv = x.size() - nq;
+
+  // Velocity update: the bottom rows of the result hold the sensitivities of v_{k+1}
+  VectorFunctionLinearApproximation discreteApproximation = system.linearApproximation(t, x, u);
+  discreteApproximation.dfdx *= dt;
+  discreteApproximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  discreteApproximation.dfdu *= dt;
+  discreteApproximation.f = x + dt * discreteApproximation.f;
+
+  // Configuration update on the intermediate state [q_{k}; v_{k+1}]
+  discreteApproximation.f.head(nq) = x.head(nq);
+  const auto configurationFlow = system.linearApproximation(t, discreteApproximation.f, u);
+  const auto dfqdq = configurationFlow.dfdx.topLeftCorner(nq, nq);
+  const auto dfqdv = configurationFlow.dfdx.topRightCorner(nq, nv);
+
+  // dq_{k+1} = dq_{k} + dt * (dfqdq * dq_{k} + dfqdv * dv_{k+1} + dfqdu * du_{k})
+  discreteApproximation.f.head(nq) += dt * configurationFlow.f.head(nq);
+  discreteApproximation.dfdx.topRows(nq).setZero();
+  discreteApproximation.dfdx.topLeftCorner(nq, nq) = dt * dfqdq;
+  discreteApproximation.dfdx.topLeftCorner(nq, nq).diagonal().array() += 1.0;  // plus Identity()
+  discreteApproximation.dfdx.topRows(nq).noalias() += dt * dfqdv * discreteApproximation.dfdx.bottomRows(nv);
+  discreteApproximation.dfdu.topRows(nq) = dt * configurationFlow.dfdu.topRows(nq);
+  discreteApproximation.dfdu.topRows(nq).noalias() += dt * dfqdv * discreteApproximation.dfdu.bottomRows(nv);
+  return discreteApproximation;
+}
+
+}  // namespace ocs2
@@ -187,3 +187,30 @@ TEST(TestConstraintCollection, getQuadraticApproximation) {
   EXPECT_EQ(quadraticApproximation.dfduu[1].sum(), 2 * 2);
   EXPECT_EQ(quadraticApproximation.dfdux[1].sum(), 2 * 3);
 }
+
+TEST(TestConstraintCollection, activityCheckedOncePerTerm) {
+  using collection_t = ocs2::StateInputConstraintCollection;
+  collection_t constraintCollection;
+
+  // evaluation point
+  double t = 0.0;
+  ocs2::vector_t x = ocs2::vector_t::Zero(3);
+  ocs2::vector_t u = ocs2::vector_t::Zero(2);
+
+  // Add an active and an inactive term
+  constraintCollection.add("Constraint1", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  constraintCollection.add("Constraint2", std::unique_ptr<TestDummyConstraint>(new TestDummyConstraint()));
+  constraintCollection.get<TestDummyConstraint>("Constraint2").setActivity(false);
+
+  const auto constraintValues = constraintCollection.getValue(t, x, u, ocs2::PreComputation());
+  const auto linearApproximation = constraintCollection.getLinearApproximation(t, x, u, ocs2::PreComputation());
+  const auto quadraticApproximation = constraintCollection.getQuadraticApproximation(t, x, u, ocs2::PreComputation());
+  EXPECT_EQ(constraintValues.rows(), 2);
+  EXPECT_EQ(linearApproximation.f.rows(), 2);
+  EXPECT_EQ(quadraticApproximation.f.rows(), 2);
+  EXPECT_EQ(quadraticApproximation.dfdxx.size(), 2);
+
+  // One activity check per term and per evaluation
+  EXPECT_EQ(constraintCollection.get<TestDummyConstraint>("Constraint1").getNumActivityChecks(), 3);
+  EXPECT_EQ(constraintCollection.get<TestDummyConstraint>("Constraint2").getNumActivityChecks(), 3);
+}
@@ -67,10 +67,15 @@ class TestDummyConstraint final : public ocs2::StateInputConstraint {
 
   size_t getNumConstraints(ocs2::scalar_t time) const override { return 2; }
 
-  bool isActive(ocs2::scalar_t) const override { return active_; }
+  bool isActive(ocs2::scalar_t) const override {
+    ++numActivityChecks_;
+    return active_;
+  }
 
   void setActivity(bool active) { active_ = active; }
 
+  size_t getNumActivityChecks() const { return numActivityChecks_; }
+
   ocs2::vector_t getValue(ocs2::scalar_t time, const ocs2::vector_t& state, const ocs2::vector_t& input,
                           const ocs2::PreComputation&) const override {
     ocs2::vector_t constraintValues(2);
@@ -103,6 +108,7 @@ class TestDummyConstraint final : public ocs2::StateInputConstraint {
 
  private:
   bool active_ = true;
+  mutable size_t numActivityChecks_ = 0;
 };
 
 /** Dummy state-only constraint with 2 entries */
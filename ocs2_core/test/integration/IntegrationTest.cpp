@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <memory>
 
+#include <unsupported/Eigen/MatrixFunctions>
+
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_core/integration/Integrator.h>
@@ -117,6 +119,133 @@ TEST(IntegrationTest, SecondOrderSystem_AdamsBashfortMoulton) {
 
 #endif
 
+TEST(IntegrationTest, SecondOrderSystem_RadauIIA5) {
+  testSecondOrderSystem(IntegratorType::RADAU_IIA5);
+}
+
+TEST(IntegrationTest, SecondOrderSystem_BDF2) {
+  testSecondOrderSystem(IntegratorType::BDF2);
+}
+
+/**
+ * Stiff linear system with time constants 1 and 1e-4. The implicit integrators should match the exact solution with a
+ * fraction of the function calls of the explicit ODE45.
+ */
+void testStiffSystem(IntegratorType integratorType, scalar_t tolerance) {
+  matrix_t A(2, 2);
+  A << -1.0, 1.0,  // clang-format off
+        0.0, -1e4;  // clang-format on
+  LinearSystemDynamics sys(A, matrix_t::Zero(2, 1));
+  LinearController controller({0.0}, {vector_t::Zero(1)}, {matrix_t::Zero(1, 2)});
+  sys.setController(&controller);
+
+  const scalar_t t0 = 0.0;
+  const scalar_t t1 = 5.0;
+  const vector_t x0 = vector_t::Ones(2);
+  const vector_t xFinal = (A * (t1 - t0)).exp() * x0;
+
+  const auto integrate = [&](IntegratorType type) {
+    sys.resetNumFunctionCalls();
+    ocs2::scalar_array_t timeTrajectory;
+    ocs2::vector_array_t stateTrajectory;
+    auto observer = ocs2::Observer(&stateTrajectory, &timeTrajectory);
+    newIntegrator(type)->integrateAdaptive(sys, observer, x0, t0, t1, 1e-3, 1e-9, 1e-6);
+    EXPECT_NEAR(timeTrajectory.back(), t1, 1e-9);
+    EXPECT_TRUE(stateTrajectory.back().isApprox(xFinal, tolerance)) << stateTrajectory.back().transpose();
+    return sys.getNumFunctionCalls();
+  };
+
+  const auto numFunctionCallsODE45 = integrate(IntegratorType::ODE45);
+  const auto numFunctionCalls = integrate(integratorType);
+  EXPECT_LT(10 * numFunctionCalls, numFunctionCallsODE45);
+
+  // Equidistant time integration with a time step far beyond the stability limit of explicit integrators
+  ocs2::scalar_array_t timeTrajectory;
+  ocs2::vector_array_t stateTrajectory;
+  auto observer = ocs2::Observer(&stateTrajectory, &timeTrajectory);
+  newIntegrator(integratorType)->integrateConst(sys, observer, x0, t0, t1, 1e-2);
+  EXPECT_NEAR(timeTrajectory.back(), t1, 1e-9);
+  EXPECT_TRUE(stateTrajectory.back().isApprox(xFinal, tolerance)) << stateTrajectory.back().transpose();
+}
+
+TEST(IntegrationTest, StiffSystem_RadauIIA5) {
+  testStiffSystem(IntegratorType::RADAU_IIA5, 1e-5);
+}
+
+TEST(IntegrationTest, StiffSystem_BDF2) {
+  testStiffSystem(IntegratorType::BDF2, 1e-3);
+}
+
+/**
+ * Integrates the same interval twice with the same integrator. The persistent steppers must not carry their history from the
+ * first integration into the second one. If the step-size warm start is enabled, the integrators with their own step-size
+ * control warm start the second one, otherwise the two integrations are identical.
+ */
+void testRepeatedIntegration(IntegratorType integratorType, bool useWarmStart, bool isWarmStarted) {
+  const scalar_t t0 = 0.0;
+  const scalar_t t1 = 10.0;
+  const vector_t x0 = vector_t::Zero(2);
+
+  auto sys = getSystem();
+  std::unique_ptr<IntegratorBase> integrator = newIntegrator(integratorType);
+  integrator->setStepSizeWarmStart(useWarmStart);
+
+  std::vector<vector_array_t> adaptiveTrajectories(2);
+  std::vector<vector_array_t> constTrajectories(2);
+  std::vector<size_t> numFunctionCalls(2);
+  for (size_t i = 0; i < 2; i++) {
+    sys->resetNumFunctionCalls();
+    auto observer = ocs2::Observer(&adaptiveTrajectories[i]);
+    integrator->integrateAdaptive(*sys, observer, x0, t0, t1, 1e-3);
+    numFunctionCalls[i] = sys->getNumFunctionCalls();
+
+    observer = ocs2::Observer(&constTrajectories[i]);
+    integrator->integrateConst(*sys, observer, x0, t0, t1, 0.05);
+  }
+
+  EXPECT_EQ(constTrajectories[0], constTrajectories[1]);
+  if (isWarmStarted) {
+    EXPECT_LT(numFunctionCalls[1], numFunctionCalls[0]);
+    EXPECT_TRUE(adaptiveTrajectories[1].back().isApprox(adaptiveTrajectories[0].back(), 1e-3));
+  } else {
+    EXPECT_EQ(numFunctionCalls[1], numFunctionCalls[0]);
+    EXPECT_EQ(adaptiveTrajectories[0], adaptiveTrajectories[1]);
+  }
+
+  // after a reset, the integration starts again from the user-defined initial step
+  integrator->resetStepSizeWarmStart();
+  vector_array_t adaptiveTrajectory;
+  auto observer = ocs2::Observer(&adaptiveTrajectory);
+  integrator->integrateAdaptive(*sys, observer, x0, t0, t1, 1e-3);
+  EXPECT_EQ(adaptiveTrajectory, adaptiveTrajectories[0]);
+}
+
+TEST(IntegrationTest, RepeatedIntegration_ODE45) {
+  testRepeatedIntegration(IntegratorType::ODE45, true, false);
+}
+
+TEST(IntegrationTest, RepeatedIntegration_ODE45_OCS2) {
+  testRepeatedIntegration(IntegratorType::ODE45_OCS2, false, false);
+  testRepeatedIntegration(IntegratorType::ODE45_OCS2, true, true);
+}
+
+TEST(IntegrationTest, RepeatedIntegration_AdamsBashfort) {
+  testRepeatedIntegration(IntegratorType::ADAMS_BASHFORTH, true, false);
+}
+
+#if (BOOST_VERSION / 100000 == 1 && BOOST_VERSION / 100 % 1000 > 55)
+
+TEST(IntegrationTest, RepeatedIntegration_AdamsBashfortMoulton) {
+  testRepeatedIntegration(IntegratorType::ADAMS_BASHFORTH_MOULTON, true, false);
+}
+
+#endif
+
+TEST(IntegrationTest, RepeatedIntegration_RadauIIA5) {
+  testRepeatedIntegration(IntegratorType::RADAU_IIA5, false, false);
+  testRepeatedIntegration(IntegratorType::RADAU_IIA5, true, true);
+}
+
 TEST(IntegrationTest, integratorType_from_string) {
   IntegratorType type = integrator_type::fromString("ODE45");
   EXPECT_EQ(type, IntegratorType::ODE45);
@@ -0,0 +1,163 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/integration/BatchRungeKuttaDormandPrince5.h>
+#include <ocs2_core/integration/Integrator.h>
+
+using namespace ocs2;
+
+namespace {
+
+class BatchLinearSystem final : public OdeBase {
+ public:
+  ~BatchLinearSystem() override = default;
+  vector_t computeFlowMap(scalar_t t, const vector_t& x) override {
+    const matrix_t A = (matrix_t(2, 2) << -2, -1,  // clang-format off
+                                           1,  0).finished();  // clang-format on
+    const vector_t B = (vector_t(2) << 1, 0).finished();
+    return A * x + B * std::sin(t);
+  }
+  void computeFlowMapBatch(const vector_t& times, const matrix_t& states, matrix_t& derivatives) override {
+    numEvaluatedTrajectories += states.cols();
+    OdeBase::computeFlowMapBatch(times, states, derivatives);
+  }
+  size_t numEvaluatedTrajectories = 0;
+};
+
+/** Integrates each column of the initial states with the single trajectory integrator. */
+std::pair<std::vector<scalar_array_t>, std::vector<vector_array_t>> integrateEach(OdeBase& system, const matrix_t& initialStates,
+                                                                                  scalar_t t0, scalar_t t1, scalar_t dt, bool adaptive) {
+  std::vector<scalar_array_t> timeTrajectories(initialStates.cols());
+  std::vector<vector_array_t> stateTrajectories(initialStates.cols());
+  for (Eigen::Index k = 0; k < initialStates.cols(); k++) {
+    // a fresh integrator per trajectory, such that each reference is independent of the other ones
+    auto integrator = newIntegrator(IntegratorType::ODE45_OCS2);
+    Observer observer(&stateTrajectories[k], &timeTrajectories[k]);
+    if (adaptive) {
+      integrator->integrateAdaptive(system, observer, initialStates.col(k), t0, t1, dt);
+    } else {
+      integrator->integrateConst(system, observer, initialStates.col(k), t0, t1, dt);
+    }
+  }
+  return {timeTrajectories, stateTrajectories};
+}
+
+/** Integrates the initial states with the batch integrator. */
+std::pair<std::vector<scalar_array_t>, std::vector<vector_array_t>> integrateBatch(OdeBase& system, const matrix_t& initialStates,
+                                                                                   scalar_t t0, scalar_t t1, scalar_t dt, bool adaptive) {
+  BatchRungeKuttaDormandPrince5 integrator;
+  std::vector<scalar_array_t> timeTrajectories(initialStates.cols());
+  std::vector<vector_array_t> stateTrajectories(initialStates.cols());
+  std::vector<Observer> observers;
+  for (Eigen::Index k = 0; k < initialStates.cols(); k++) {
+    observers.emplace_back(&stateTrajectories[k], &timeTrajectories[k]);
+  }
+  if (adaptive) {
+    integrator.integrateAdaptive(system, observers, initialStates, t0, t1, dt);
+  } else {
+    integrator.integrateConst(system, observers, initialStates, t0, t1, dt);
+  }
+  return {timeTrajectories, stateTrajectories};
+}
+
+void expectSameTrajectories(const std::pair<std::vector<scalar_array_t>, std::vector<vector_array_t>>& batch,
+                            const std::pair<std::vector<scalar_array_t>, std::vector<vector_array_t>>& expected) {
+  ASSERT_EQ(batch.first.size(), expected.first.size());
+  for (size_t k = 0; k < batch.first.size(); k++) {
+    ASSERT_EQ(batch.first[k].size(), expected.first[k].size());
+    for (size_t i = 0; i < batch.first[k].size(); i++) {
+      EXPECT_NEAR(batch.first[k][i], expected.first[k][i], 1e-9);
+      EXPECT_TRUE(batch.second[k][i].isApprox(expected.second[k][i], 1e-9));
+    }
+  }
+}
+
+}  // unnamed namespace
+
+TEST(BatchRungeKuttaDormandPrince5Test, integrateConst) {
+  BatchLinearSystem system;
+  const matrix_t initialStates = 10.0 * matrix_t::Random(2, 8);
+  expectSameTrajectories(integrateBatch(system, initialStates, 0.0, 5.0, 0.01, false),
+                         integrateEach(system, initialStates, 0.0, 5.0, 0.01, false));
+}
+
+TEST(BatchRungeKuttaDormandPrince5Test, integrateAdaptive) {
+  BatchLinearSystem system;
+  // the trajectories differ in magnitude, hence they take different steps
+  matrix_t initialStates = matrix_t::Random(2, 8);
+  for (Eigen::Index k = 0; k < initialStates.cols(); k++) {
+    initialStates.col(k) *= std::pow(10.0, k - 3.0);
+  }
+  const auto batch = integrateBatch(system, initialStates, 0.0, 5.0, 0.05, true);
+  expectSameTrajectories(batch, integrateEach(system, initialStates, 0.0, 5.0, 0.05, true));
+  EXPECT_NE(batch.first.front().size(), batch.first.back().size());
+}
+
+TEST(BatchRungeKuttaDormandPrince5Test, finishedTrajectories) {
+  BatchLinearSystem system;
+  matrix_t initialStates = matrix_t::Random(2, 8);
+  for (Eigen::Index k = 0; k < initialStates.cols(); k++) {
+    initialStates.col(k) *= std::pow(10.0, k - 3.0);
+  }
+  const auto batch = integrateBatch(system, initialStates, 0.0, 5.0, 0.05, true);
+
+  // the dynamics of the finished trajectories is not evaluated anymore
+  const auto numBatchEvaluations = system.getNumFunctionCalls();
+  EXPECT_LT(system.numEvaluatedTrajectories, numBatchEvaluations * initialStates.cols());
+  // one batch evaluation at the start and six per step of the longest trajectory
+  size_t maxNumSteps = 0;
+  for (const auto& timeTrajectory : batch.first) {
+    maxNumSteps = std::max(maxNumSteps, timeTrajectory.size() - 1);
+  }
+  EXPECT_GE(numBatchEvaluations, 1 + 6 * maxNumSteps);
+}
+
+TEST(BatchRungeKuttaDormandPrince5Test, integrateBackwards) {
+  BatchLinearSystem system;
+  const matrix_t initialStates = matrix_t::Random(2, 4);
+  expectSameTrajectories(integrateBatch(system, initialStates, 5.0, 0.0, -0.05, true),
+                         integrateEach(system, initialStates, 5.0, 0.0, -0.05, true));
+}
+
+TEST(BatchRungeKuttaDormandPrince5Test, controlledSystem) {
+  const matrix_t A = (matrix_t(2, 2) << -2, -1,  // clang-format off
+                                         1,  0).finished();  // clang-format on
+  const matrix_t B = (matrix_t(2, 1) << 1, 0).finished();
+  LinearSystemDynamics system(A, B);
+  LinearController controller({0.0}, {vector_t::Ones(1)}, {-matrix_t::Ones(1, 2)});
+  system.setController(&controller);
+
+  const matrix_t initialStates = matrix_t::Random(2, 6);
+  expectSameTrajectories(integrateBatch(system, initialStates, 0.0, 5.0, 0.05, true),
+                         integrateEach(system, initialStates, 0.0, 5.0, 0.05, true));
+}
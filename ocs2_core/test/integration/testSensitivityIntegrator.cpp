@@ -27,8 +27,12 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
+#include <unsupported/Eigen/MatrixFunctions>
+
 #include "ocs2_core/integration/Integrator.h"
 #include "ocs2_core/integration/SensitivityIntegrator.h"
 
@@ -45,6 +49,86 @@ std::unique_ptr<ocs2::LinearSystemDynamics> getSystem() {
   B << 1, 0;
   return std::unique_ptr<ocs2::LinearSystemDynamics>(new ocs2::LinearSystemDynamics(A, B));
 }
+
+/** A torque driven pendulum with state x = [q; v], dq/dt = v and dv/dt = -sin(q) + u. */
+class PendulumDynamics final : public ocs2::SystemDynamicsBase {
+ public:
+  PendulumDynamics() = default;
+  ~PendulumDynamics() override = default;
+  PendulumDynamics* clone() const override { return new PendulumDynamics(*this); }
+
+  size_t getConfigurationDimension() const override { return 1; }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    ocs2::vector_t dxdt(2);
+    dxdt << x(1), -std::sin(x(0)) + u(0);
+    return dxdt;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx.resize(2, 2);
+    approximation.dfdx << 0.0, 1.0, -std::cos(x(0)), 0.0;
+    approximation.dfdu.resize(2, 1);
+    approximation.dfdu << 0.0, 1.0;
+    return approximation;
+  }
+
+  static ocs2::scalar_t energy(const ocs2::vector_t& x) { return 0.5 * x(1) * x(1) + 1.0 - std::cos(x(0)); }
+};
+
+/** Returns the number of interval durations of which the matrix exponential is cached in the system. */
+size_t numCachedExponentials(ocs2::SystemDynamicsBase& system) {
+  const auto& entries = system.getExponentialDiscretizationCache().entries;
+  return std::count_if(entries.begin(), entries.end(), [](const ocs2::SystemDynamicsBase::ExponentialDiscretizationCache::Entry& entry) {
+    return entry.dt >= 0.0;
+  });
+}
+
+/** Checks the sensitivities of a discretization against central finite differences of its forward dynamics. */
+void checkAgainstFiniteDifferences(ocs2::SensitivityIntegratorType type, ocs2::SystemDynamicsBase& system) {
+  auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto discretization = ocs2::selectDynamicsDiscretization(type);
+
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::scalar_t dt = 0.1;
+  const ocs2::scalar_t eps = 1e-6;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+
+  const auto linearizedDynamics = sensitivityDiscretization(system, t, x, u, dt);
+  ASSERT_TRUE(discretization(system, t, x, u, dt).isApprox(linearizedDynamics.f, 1e-9));
+
+  ocs2::matrix_t dfdx(2, 2);
+  for (int i = 0; i < 2; ++i) {
+    const ocs2::vector_t dx = eps * ocs2::vector_t::Unit(2, i);
+    dfdx.col(i) = (discretization(system, t, x + dx, u, dt) - discretization(system, t, x - dx, u, dt)) / (2.0 * eps);
+  }
+  const ocs2::vector_t du = eps * ocs2::vector_t::Ones(1);
+  const ocs2::vector_t dfdu = (discretization(system, t, x, u + du, dt) - discretization(system, t, x, u - du, dt)) / (2.0 * eps);
+  ASSERT_TRUE(linearizedDynamics.dfdx.isApprox(dfdx, 1e-6));
+  ASSERT_TRUE(linearizedDynamics.dfdu.isApprox(dfdu, 1e-6));
+}
+
+/** Returns the largest relative energy error of the unforced pendulum along numSteps steps of the discretization. */
+ocs2::scalar_t maxEnergyError(ocs2::SensitivityIntegratorType type, size_t numSteps) {
+  PendulumDynamics system;
+  auto discretization = ocs2::selectDynamicsDiscretization(type);
+  const ocs2::scalar_t dt = 0.1;
+  const ocs2::vector_t u = ocs2::vector_t::Zero(1);
+  ocs2::vector_t x(2);
+  x << 1.0, 0.0;
+
+  const ocs2::scalar_t initialEnergy = PendulumDynamics::energy(x);
+  ocs2::scalar_t maxError = 0.0;
+  for (size_t k = 0; k < numSteps; ++k) {
+    x = discretization(system, k * dt, x, u, dt);
+    maxError = std::max(maxError, std::abs(PendulumDynamics::energy(x) - initialEnergy) / initialEnergy);
+  }
+  return maxError;
+}
 }  // namespace
 
 TEST(test_sensitivity_integrator, eulerSensitivity) {
@@ -209,4 +293,218 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
 
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
-}
\ No newline at end of file
+}
+
+TEST(test_sensitivity_integrator, exponentialSensitivity) {
+  auto type = ocs2::SensitivityIntegratorType::EXPONENTIAL;
+  auto exponentialSensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto exponentialDiscretization = ocs2::selectDynamicsDiscretization(type);
+
+  auto system = getSystem();
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  // Exact zero-order-hold discretization: expm([A B; 0 0] * dt) = [Ad Bd; 0 I]
+  const auto exactDiscretization = [&]() {
+    const ocs2::PreComputation preComp;
+    const auto continuousApproximation = system->linearApproximation(t, x, u, preComp);
+    ocs2::matrix_t augmented = ocs2::matrix_t::Zero(3, 3);
+    augmented.topLeftCorner(2, 2) = continuousApproximation.dfdx * dt;
+    augmented.topRightCorner(2, 1) = continuousApproximation.dfdu * dt;
+    const ocs2::matrix_t augmentedExponential = augmented.exp();
+
+    ocs2::VectorFunctionLinearApproximation discreteApproximation;
+    discreteApproximation.dfdx = augmentedExponential.topLeftCorner(2, 2);
+    discreteApproximation.dfdu = augmentedExponential.topRightCorner(2, 1);
+    discreteApproximation.f = discreteApproximation.dfdx * x + discreteApproximation.dfdu * u;
+    return discreteApproximation;
+  }();
+
+  // The linear system is discretized exactly from the first evaluation on
+  for (int i = 0; i < 2; ++i) {
+    const auto exponentialLinearizedDynamics = exponentialSensitivityDiscretization(*system, t, x, u, dt);
+    ASSERT_TRUE(exponentialLinearizedDynamics.f.isApprox(exactDiscretization.f, 1e-12));
+    ASSERT_TRUE(exponentialLinearizedDynamics.dfdx.isApprox(exactDiscretization.dfdx, 1e-12));
+    ASSERT_TRUE(exponentialLinearizedDynamics.dfdu.isApprox(exactDiscretization.dfdu, 1e-12));
+    const auto exponentialForwardDynamics = exponentialDiscretization(*system, t, x, u, dt);
+    ASSERT_TRUE(exponentialForwardDynamics.isApprox(exactDiscretization.f, 1e-12));
+  }
+
+  // A clone computes its own exponential
+  std::unique_ptr<ocs2::LinearSystemDynamics> clonedSystem(system->clone());
+  ASSERT_EQ(numCachedExponentials(*clonedSystem), 0);
+  ASSERT_TRUE(exponentialDiscretization(*clonedSystem, t, x, u, dt).isApprox(exactDiscretization.f, 1e-12));
+
+  // A different interval duration recomputes the exponential
+  const auto halfStepDynamics = exponentialSensitivityDiscretization(*system, t, x, u, dt / 2.0);
+  const auto fullStepDynamics = exponentialSensitivityDiscretization(*system, t, halfStepDynamics.f, u, dt / 2.0);
+  ASSERT_TRUE(fullStepDynamics.f.isApprox(exactDiscretization.f, 1e-12));
+  ASSERT_TRUE((fullStepDynamics.dfdx * halfStepDynamics.dfdx).isApprox(exactDiscretization.dfdx, 1e-12));
+
+  // An irregular grid keeps the exponentials of its most recent interval durations
+  ASSERT_EQ(numCachedExponentials(*system), 2);
+  const ocs2::scalar_array_t irregularIntervals{dt, dt / 4.0, dt / 2.0, dt / 4.0, dt, dt / 2.0};
+  for (const auto interval : irregularIntervals) {
+    const auto expected = exponentialSensitivityDiscretization(*clonedSystem, t, x, u, interval);
+    const auto result = exponentialSensitivityDiscretization(*system, t, x, u, interval);
+    ASSERT_TRUE(result.f.isApprox(expected.f, 1e-12));
+    ASSERT_TRUE(result.dfdx.isApprox(expected.dfdx, 1e-12));
+    ASSERT_TRUE(result.dfdu.isApprox(expected.dfdu, 1e-12));
+  }
+  ASSERT_EQ(numCachedExponentials(*system), 3);
+}
+
+TEST(test_sensitivity_integrator, exponentialFallback) {
+  // The pendulum is not linear time-invariant, hence it is discretized with RK4 even if the state Jacobian does not change
+  PendulumDynamics system;
+  auto exponentialSensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::EXPONENTIAL);
+  auto exponentialDiscretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::EXPONENTIAL);
+  auto rk4SensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::RK4);
+  auto rk4Discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::RK4);
+
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  for (int i = 0; i < 2; ++i) {
+    const auto expected = rk4SensitivityDiscretization(system, t, x, u, dt);
+    const auto result = exponentialSensitivityDiscretization(system, t, x, u, dt);
+    ASSERT_TRUE(result.f.isApprox(expected.f));
+    ASSERT_TRUE(result.dfdx.isApprox(expected.dfdx));
+    ASSERT_TRUE(result.dfdu.isApprox(expected.dfdu));
+    ASSERT_TRUE(exponentialDiscretization(system, t, x, u, dt).isApprox(rk4Discretization(system, t, x, u, dt)));
+  }
+  ASSERT_EQ(numCachedExponentials(system), 0);
+}
+
+TEST(test_sensitivity_integrator, implicitEulerSensitivity) {
+  auto type = ocs2::SensitivityIntegratorType::IMPLICIT_EULER;
+  auto implicitEulerSensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto implicitEulerDiscretization = ocs2::selectDynamicsDiscretization(type);
+
+  auto system = getSystem();
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  // Closed form for linear dynamics: x_{k+1} = (I - dt * A)^{-1} * (x_{k} + dt * B * u_{k})
+  const auto implicitEulerDynamics_check = [&]() {
+    const ocs2::PreComputation preComp;
+    const auto continuousApproximation = system->linearApproximation(t, x, u, preComp);
+    const ocs2::matrix_t inverse = (ocs2::matrix_t::Identity(2, 2) - dt * continuousApproximation.dfdx).inverse();
+
+    ocs2::VectorFunctionLinearApproximation discreteApproximation;
+    discreteApproximation.dfdx = inverse;
+    discreteApproximation.dfdu = dt * inverse * continuousApproximation.dfdu;
+    discreteApproximation.f = discreteApproximation.dfdx * x + discreteApproximation.dfdu * u;
+    return discreteApproximation;
+  }();
+
+  const auto implicitEulerForwardDynamics = implicitEulerDiscretization(*system, t, x, u, dt);
+  ASSERT_TRUE(implicitEulerForwardDynamics.isApprox(implicitEulerDynamics_check.f, 1e-9));
+  const auto implicitEulerLinearizedDynamics = implicitEulerSensitivityDiscretization(*system, t, x, u, dt);
+  ASSERT_TRUE(implicitEulerLinearizedDynamics.f.isApprox(implicitEulerDynamics_check.f, 1e-9));
+  ASSERT_TRUE(implicitEulerLinearizedDynamics.dfdx.isApprox(implicitEulerDynamics_check.dfdx, 1e-9));
+  ASSERT_TRUE(implicitEulerLinearizedDynamics.dfdu.isApprox(implicitEulerDynamics_check.dfdu, 1e-9));
+}
+
+TEST(test_sensitivity_integrator, radauIIA5Sensitivity) {
+  auto type = ocs2::SensitivityIntegratorType::RADAU_IIA5;
+  auto radauSensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto radauDiscretization = ocs2::selectDynamicsDiscretization(type);
+
+  // A stiff linear system for which the explicit discretizations are unstable at this step size
+  ocs2::matrix_t A(2, 2);
+  A << -1, 1,  // clang-format off
+       0, -1e3;  // clang-format on
+  ocs2::matrix_t B(2, 1);
+  B << 0, 1e3;
+  ocs2::LinearSystemDynamics system(A, B);
+
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  // Exact zero-order-hold discretization: expm([A B; 0 0] * dt) = [Ad Bd; 0 I]
+  ocs2::matrix_t augmented = ocs2::matrix_t::Zero(3, 3);
+  augmented.topLeftCorner(2, 2) = A * dt;
+  augmented.topRightCorner(2, 1) = B * dt;
+  const ocs2::matrix_t augmentedExponential = augmented.exp();
+  const ocs2::matrix_t Ad = augmentedExponential.topLeftCorner(2, 2);
+  const ocs2::matrix_t Bd = augmentedExponential.topRightCorner(2, 1);
+  const ocs2::vector_t xNext = Ad * x + Bd * u;
+
+  // Radau IIA is L-stable: the stiff mode is damped instead of amplified, while the slow mode stays accurate
+  auto rk4SensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::RK4);
+  ASSERT_GT(std::abs(rk4SensitivityDiscretization(system, t, x, u, dt).dfdx(1, 1)), 1.0);
+  const auto radauLinearizedDynamics = radauSensitivityDiscretization(system, t, x, u, dt);
+  ASSERT_LT(std::abs(radauLinearizedDynamics.dfdx(1, 1)), 0.05);
+  ASSERT_NEAR(radauLinearizedDynamics.dfdx(0, 0), Ad(0, 0), 1e-9);
+  ASSERT_NEAR(radauLinearizedDynamics.dfdx(1, 0), 0.0, 1e-9);
+  ASSERT_TRUE(radauLinearizedDynamics.f.isApprox(xNext, 0.1));
+
+  const auto radauForwardDynamics = radauDiscretization(system, t, x, u, dt);
+  ASSERT_TRUE(radauForwardDynamics.isApprox(radauLinearizedDynamics.f, 1e-9));
+
+  // 5th order accuracy on the non-stiff system
+  auto nonStiffSystem = getSystem();
+  const auto nonStiffApproximation = nonStiffSystem->linearApproximation(t, x, u, ocs2::PreComputation());
+  augmented.topLeftCorner(2, 2) = nonStiffApproximation.dfdx * dt;
+  augmented.topRightCorner(2, 1) = nonStiffApproximation.dfdu * dt;
+  const ocs2::matrix_t nonStiffExponential = augmented.exp();
+  const auto nonStiffLinearizedDynamics = radauSensitivityDiscretization(*nonStiffSystem, t, x, u, dt);
+  ASSERT_TRUE(nonStiffLinearizedDynamics.dfdx.isApprox(nonStiffExponential.topLeftCorner(2, 2), 1e-8));
+  ASSERT_TRUE(nonStiffLinearizedDynamics.dfdu.isApprox(nonStiffExponential.topRightCorner(2, 1), 1e-6));
+}
+
+TEST(test_sensitivity_integrator, symplecticEulerSensitivity) {
+  PendulumDynamics system;
+  checkAgainstFiniteDifferences(ocs2::SensitivityIntegratorType::SYMPLECTIC_EULER, system);
+
+  // The discrete flow is symplectic: the determinant of the state sensitivity is one
+  auto symplecticEulerSensitivityDiscretization =
+      ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::SYMPLECTIC_EULER);
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const auto linearizedDynamics = symplecticEulerSensitivityDiscretization(system, 0.0, x, u, 0.1);
+  ASSERT_NEAR(linearizedDynamics.dfdx.determinant(), 1.0, 1e-12);
+
+  // Requires a (q, v) split of the state
+  auto linearSystem = getSystem();
+  ASSERT_THROW(symplecticEulerSensitivityDiscretization(*linearSystem, 0.0, x, u, 0.1), std::runtime_error);
+}
+
+TEST(test_sensitivity_integrator, implicitMidpointSensitivity) {
+  PendulumDynamics system;
+  checkAgainstFiniteDifferences(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT, system);
+
+  // Closed form for linear dynamics: x_{k+1} = (I - dt/2 * A)^{-1} * ((I + dt/2 * A) * x_{k} + dt * B * u_{k})
+  auto linearSystem = getSystem();
+  const ocs2::scalar_t dt = 0.1;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const auto continuousApproximation = linearSystem->linearApproximation(0.0, x, u, ocs2::PreComputation());
+  const ocs2::matrix_t inverse = (ocs2::matrix_t::Identity(2, 2) - 0.5 * dt * continuousApproximation.dfdx).inverse();
+  const ocs2::matrix_t dfdx = inverse * (ocs2::matrix_t::Identity(2, 2) + 0.5 * dt * continuousApproximation.dfdx);
+  const ocs2::matrix_t dfdu = dt * inverse * continuousApproximation.dfdu;
+
+  auto implicitMidpointSensitivityDiscretization =
+      ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT);
+  const auto linearizedDynamics = implicitMidpointSensitivityDiscretization(*linearSystem, 0.0, x, u, dt);
+  ASSERT_TRUE(linearizedDynamics.dfdx.isApprox(dfdx, 1e-9));
+  ASSERT_TRUE(linearizedDynamics.dfdu.isApprox(dfdu, 1e-9));
+  ASSERT_TRUE(linearizedDynamics.f.isApprox(dfdx * x + dfdu * u, 1e-9));
+}
+
+TEST(test_sensitivity_integrator, symplecticEnergyBehavior) {
+  // Symplectic discretizations keep the energy error bounded over long horizons, while explicit euler drifts
+  constexpr size_t numSteps = 2000;
+  ASSERT_LT(maxEnergyError(ocs2::SensitivityIntegratorType::SYMPLECTIC_EULER, numSteps), 0.1);
+  ASSERT_LT(maxEnergyError(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT, numSteps), 0.01);
+  ASSERT_GT(maxEnergyError(ocs2::SensitivityIntegratorType::EULER, numSteps), 1.0);
+}
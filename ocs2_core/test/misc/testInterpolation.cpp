@@ -132,3 +132,30 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testTimeSegmentWithHint) {
+  // includes an event time
+  const std::vector<double> time{0.0, 0.5, 1.0, 1.0, 1.5, 2.0};
+  const std::vector<double> queries{-1.0, 0.0, 0.2, 0.5, 0.7, 1.0, 1.2, 1.5, 2.0, 3.0};
+  for (int hint = -1; hint <= static_cast<int>(time.size()); hint++) {
+    for (const auto t : queries) {
+      const auto expected = ocs2::LinearInterpolation::timeSegment(t, time);
+      const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(t, time, hint);
+      EXPECT_EQ(indexAlpha.first, expected.first);
+      EXPECT_DOUBLE_EQ(indexAlpha.second, expected.second);
+    }
+  }
+}
+
+TEST(testLinearInterpolation, testInterpolationToOutput) {
+  using Data_T = Eigen::MatrixXd;
+  const std::vector<Data_T> data = {Data_T::Zero(2, 3), Data_T::Ones(2, 3)};
+  const auto accessFun = [](const std::vector<Data_T>& array, size_t index) -> const Data_T& { return array[index]; };
+
+  Data_T result(2, 3);
+  const auto* resultData = result.data();
+  ocs2::LinearInterpolation::interpolate({0, 0.25}, data, accessFun, result);
+  EXPECT_TRUE(result.isApprox(ocs2::LinearInterpolation::interpolate({0, 0.25}, data, accessFun)));
+  // no reallocation
+  EXPECT_EQ(result.data(), resultData);
+}
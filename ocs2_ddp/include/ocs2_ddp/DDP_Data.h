@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/model_data/ModelData.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/rollout/TimeGrid.h>
 #include "ocs2_ddp/riccati_equations/RiccatiModification.h"
 
 #include <ocs2_core/control/LinearController.h>
@@ -53,17 +54,21 @@ struct PrimalDataContainer {
   std::vector<ModelData> modelDataTrajectory;
   // event times model data
   std::vector<ModelData> modelDataEventTimes;
+  // time grid adapted to the primal solution for the next rollouts, see rollout::Settings::reuseTimeGrid
+  rollout::TimeGrid timeGrid;
 
   void swap(PrimalDataContainer& other) {
     primalSolution.swap(other.primalSolution);
     modelDataTrajectory.swap(other.modelDataTrajectory);
     modelDataEventTimes.swap(other.modelDataEventTimes);
+    timeGrid.swap(other.timeGrid);
   }
 
   void clear() {
     primalSolution.clear();
     modelDataTrajectory.clear();
     modelDataEventTimes.clear();
+    timeGrid.clear();
   }
 };
 
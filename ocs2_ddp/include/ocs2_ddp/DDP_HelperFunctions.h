@@ -29,9 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_data/Metrics.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
@@ -71,11 +75,73 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
  * @param [in, out] primalSolution: The resulting primal solution. Make sure that primalSolution::controllerPtr is set since
  *                                  the rollout is performed based on the controller stored in primalSolution. Moreover,
  *                                  except for StateTriggeredRollout, one should also set primalSolution::modeSchedule.
+ * @param [in] timeGrid: The time grid on which the rollout is observed. @see RolloutBase::runOnTimeGrid()
  *
  * @return average time step.
  */
 scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
-                           PrimalSolution& primalSolution);
+                           PrimalSolution& primalSolution, const rollout::TimeGrid& timeGrid = rollout::TimeGrid());
+
+/**
+ * Forward integrate the system dynamics with given controller like RolloutBase::run(), but splits the time period into partitions
+ * which are integrated in parallel, multiple-shooting style. Each partition starts from the nominal state at its start time. The
+ * partition boundaries are placed on the nodes of the nominal trajectory which are not adjacent to an event. Each partition is also
+ * linearized in parallel, i.e., the closed loop of the dynamics and the feedback policy, along its trajectory. Afterwards, a
+ * sequential defect-correction sweep propagates the deviation of the start state of each partition from the final state of the
+ * preceding partition through the linearized closed loop. A partition is only re-integrated if the error estimate of the shifted
+ * trajectory exceeds the defect tolerance. If the nominal trajectory does not provide any boundary, it falls back to the sequential
+ * rollout with the first rollout instance.
+ *
+ * @note The partitions work on copies of the mode schedule, therefore rollouts which modify it, e.g., StateTriggeredRollout, are
+ * not supported.
+ *
+ * @param [in] threadPool: A reference to the thread pool.
+ * @param [in] rolloutRefStock: An array of references to the rollout. Its size determines the maximum number of partitions and
+ *                              partition i is always integrated by rollout i.
+ * @param [in] problemRefStock: An array of references to the optimal control problem, at least one per rollout. Partition i is
+ *                              linearized with the dynamics of problem i.
+ * @param [in] nominalPrimalSolution: The nominal trajectories which provide the start states of the partitions.
+ * @param [in] defectTolerance: The tolerance on the infinity norm of the state defect at the partition boundaries and on the
+ *                              error estimate of a partition which is shifted by its defect.
+ * @param [in] initTime: The initial time.
+ * @param [in] initState: The initial state.
+ * @param [in] finalTime: The final time.
+ * @param [in] controller: The control policy.
+ * @param [in] modeSchedule: The mode schedule.
+ * @param [out] timeTrajectory: The time trajectory stamp.
+ * @param [out] postEventIndices: The indices of the post-event nodes.
+ * @param [out] stateTrajectory: The state trajectory.
+ * @param [out] inputTrajectory: The control input trajectory.
+ *
+ * @return The final state.
+ */
+vector_t partitionedRollout(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                            const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                            const PrimalSolution& nominalPrimalSolution, scalar_t defectTolerance, scalar_t initTime,
+                            const vector_t& initState, scalar_t finalTime, ControllerBase* controller, ModeSchedule& modeSchedule,
+                            scalar_array_t& timeTrajectory, size_array_t& postEventIndices, vector_array_t& stateTrajectory,
+                            vector_array_t& inputTrajectory);
+
+/**
+ * Forward integrate the system dynamics with given controller like rolloutTrajectory(), but with the partitioned rollout.
+ * @see partitionedRollout()
+ *
+ * @param [in] threadPool: A reference to the thread pool.
+ * @param [in] rolloutRefStock: An array of references to the rollout. Its size determines the maximum number of partitions.
+ * @param [in] problemRefStock: An array of references to the optimal control problem, at least one per rollout.
+ * @param [in] nominalPrimalSolution: The nominal trajectories which provide the start states of the partitions.
+ * @param [in] defectTolerance: The tolerance on the infinity norm of the state defect at the partition boundaries.
+ * @param [in] initTime: The initial time.
+ * @param [in] initState: The initial state.
+ * @param [in] finalTime: The final time.
+ * @param [in, out] primalSolution: The resulting primal solution. The same requirements as for rolloutTrajectory() apply.
+ *
+ * @return average time step.
+ */
+scalar_t rolloutTrajectory(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                           const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                           const PrimalSolution& nominalPrimalSolution, scalar_t defectTolerance, scalar_t initTime,
+                           const vector_t& initState, scalar_t finalTime, PrimalSolution& primalSolution);
 
 /**
  * Computes the integral of the squared (IS) norm of the controller update.
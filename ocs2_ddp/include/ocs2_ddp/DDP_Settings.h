@@ -107,6 +107,17 @@ struct Settings {
   /** If true, terms of the Riccati equation will be precomputed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
 
+  /**
+   * If true, the forward rollouts of the initialization and the Levenberg-Marquardt strategy are split into nThreads_ time
+   * partitions. The partitions are integrated and linearized in parallel from the cached nominal trajectory, followed by a
+   * sequential defect correction through the linearized closed loop. Rollouts which modify the mode schedule, such as
+   * StateTriggeredRollout, are not supported.
+   */
+  bool partitionedRollout_ = false;
+  /** The tolerance on the state defect at the boundaries of the partitioned rollout and on the error estimate of its linear
+   *  correction, above which a partition is re-integrated. */
+  scalar_t partitionedRolloutDefectTolerance_ = 1e-6;
+
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
 
@@ -66,9 +66,11 @@ class GaussNewtonDDP : public SolverBase {
    * @param [in] rollout: The rollout class used for simulating the system dynamics.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: An optional thread pool shared with other solvers. If it is not provided, the solver creates its own
+   * pool with (nThreads - 1) workers.
    */
   GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-                 const Initializer& initializer);
+                 const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   /**
    * Destructor.
@@ -81,6 +83,10 @@ class GaussNewtonDDP : public SolverBase {
 
   scalar_t getFinalTime() const override { return finalTime_; }
 
+  /**
+   * Gets the performance index of the returned primal solution. After an interrupted run, both refer to the latest accepted iterate,
+   * while the value function and the Lagrangians still refer to the LQ model of the last complete iteration.
+   */
   const PerformanceIndex& getPerformanceIndeces() const override { return performanceIndex_; }
 
   const std::vector<PerformanceIndex>& getIterationsLog() const override { return performanceIndexHistory_; }
@@ -93,6 +99,16 @@ class GaussNewtonDDP : public SolverBase {
 
   ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override;
 
+  /**
+   * Computes the derivatives of the cost with respect to the event times of the nominal trajectories with the adjoint method. The
+   * costate is the gradient of the value function of the last complete LQ model, hence no sensitivity equations are integrated
+   * and the derivative of an event time is the jump of the Hamiltonian, L + dVdx' * f, across it. The events are evaluated in
+   * parallel. Time-dependent pre-jump costs and violated state-input equality constraints are not accounted for.
+   *
+   * @return The derivative for each event time within the horizon, in the order of primalSolution().postEventIndices_.
+   */
+  scalar_array_t getEventTimesDerivatives();
+
   vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override {
     return getStateInputEqualityConstraintLagrangianImpl(time, state, nominalPrimalData_, dualData_);
   }
@@ -180,6 +196,17 @@ class GaussNewtonDDP : public SolverBase {
   virtual void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                       const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
+  /**
+   * Checks whether the solver is interrupted while the given primal data contains a controller to fall back on. Without such a
+   * controller, the interrupt is ignored until the first controller update.
+   *
+   * @param [in] primalData: The primal data which is returned on interrupt.
+   * @return True if the solver should terminate.
+   */
+  bool isInterruptedWithController(const PrimalDataContainer& primalData) const {
+    return !primalData.primalSolution.controllerPtr_->empty() && isInterrupted();
+  }
+
  private:
   /**
    * Get the State Input Equality Constraint Lagrangian Impl object
@@ -238,6 +265,12 @@ class GaussNewtonDDP : public SolverBase {
    */
   std::vector<std::pair<int, int>> getPartitionIntervalsFromTimeTrajectory(const scalar_array_t& timeTrajectory, int numWorkers);
 
+  /** Gets references to the rollout instances of the forward pass, one per thread. */
+  std::vector<std::reference_wrapper<RolloutBase>> getDynamicsForwardRolloutRefStock();
+
+  /** Gets references to the optimal control problem instances, one per thread. */
+  std::vector<std::reference_wrapper<OptimalControlProblem>> getOptimalControlProblemRefStock();
+
   /**
    * Forward integrate the system dynamics with given controller and operating trajectories. In general, it uses the
    * given control policies and initial state, to integrate the system dynamics in the time period [initTime, finalTime].
@@ -344,6 +377,14 @@ class GaussNewtonDDP : public SolverBase {
   void runSearchStrategy(scalar_t lqModelExpectedCost, const LinearController& unoptimizedController, PrimalDataContainer& primalData,
                          PerformanceIndex& performanceIndex, MetricsCollection& metrics);
 
+  /**
+   * Adapts the time grid of the primal data to its rollout if rollout::Settings::reuseTimeGrid is set, otherwise clears it. It is
+   * called after each accepted rollout of the nominal trajectories, such that the next rollouts are observed on the same grid.
+   *
+   * @param [in, out] primalData: The primal data container of the accepted rollout.
+   */
+  void updateTimeGrid(PrimalDataContainer& primalData) const;
+
   /**
    * swap both primal and dual data cache
    */
@@ -351,14 +392,16 @@ class GaussNewtonDDP : public SolverBase {
 
   /**
    * Runs the initialization method for Gauss-Newton DDP.
+   * @return Whether the initialization is completed. It is false if the solver is interrupted before the controller is updated.
    */
-  void runInit();
+  bool runInit();
 
   /**
    * Runs a single iteration of Gauss-Newton DDP.
    * @param [in] lqModelExpectedCost: The expected cost based on the LQ model optimization.
+   * @return Whether the iteration is completed. It is false if the solver is interrupted before the controller is updated.
    */
-  void runIteration(scalar_t lqModelExpectedCost);
+  bool runIteration(scalar_t lqModelExpectedCost);
 
   /**
    * Checks convergence of the main loop of DDP.
@@ -406,7 +449,7 @@ class GaussNewtonDDP : public SolverBase {
  private:
   const ddp::Settings ddpSettings_;
 
-  ThreadPool threadPool_;
+  std::shared_ptr<ThreadPool> threadPoolPtr_;
 
   unsigned long long int totalNumIterations_{0};
 
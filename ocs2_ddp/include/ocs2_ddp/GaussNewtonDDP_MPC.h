@@ -50,16 +50,18 @@ class GaussNewtonDDP_MPC final : public MPC_BASE {
    * @param [in] rollout: The rollout class used for simulating the system dynamics.
    * @param [in] optimalControlProblem: The optimal control problem definition.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: An optional thread pool shared with other solvers, e.g., the worker pool of an MPC_Host.
    */
   GaussNewtonDDP_MPC(mpc::Settings mpcSettings, ddp::Settings ddpSettings, const RolloutBase& rollout,
-                     const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
+                     const OptimalControlProblem& optimalControlProblem, const Initializer& initializer,
+                     std::shared_ptr<ThreadPool> threadPoolPtr = nullptr)
       : MPC_BASE(std::move(mpcSettings)) {
     switch (ddpSettings.algorithm_) {
       case ddp::Algorithm::SLQ:
-        ddpPtr_.reset(new SLQ(std::move(ddpSettings), rollout, optimalControlProblem, initializer));
+        ddpPtr_.reset(new SLQ(std::move(ddpSettings), rollout, optimalControlProblem, initializer, std::move(threadPoolPtr)));
         break;
       case ddp::Algorithm::ILQR:
-        ddpPtr_.reset(new ILQR(std::move(ddpSettings), rollout, optimalControlProblem, initializer));
+        ddpPtr_.reset(new ILQR(std::move(ddpSettings), rollout, optimalControlProblem, initializer, std::move(threadPoolPtr)));
         break;
       default:
         throw std::runtime_error("Undefined ddp::Algorithm type!");
@@ -49,9 +49,11 @@ class SLQ final : public GaussNewtonDDP {
    * @param [in] rollout: The rollout class used for simulating the system dynamics.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: An optional thread pool shared with other solvers. If it is not provided, the solver creates its own
+   * pool with (nThreads - 1) workers.
    */
   SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-      const Initializer& initializer);
+      const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   /**
    * Default destructor.
@@ -237,6 +237,7 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   const std::vector<ModelData>* modelDataEventTimesPtr_ = nullptr;
   const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
   scalar_array_t eventTimes_;
+  int timeSegmentHint_ = 0;
 
   ContinuousTimeRiccatiData continuousTimeRiccatiData_;
 };
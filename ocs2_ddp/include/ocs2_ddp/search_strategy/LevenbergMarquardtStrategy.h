@@ -57,12 +57,18 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
    *
    * @param [in] baseSettings: The basic settings for the search strategy algorithms.
    * @param [in] settings: The Levenberg Marquardt settings.
-   * @param [in] rolloutRef: A reference to the rollout.
-   * @param [in] optimalControlProblemRef: A reference to the optimal control problem.
+   * @param [in] threadPoolRef: A reference to the thread pool instance, used by the partitioned rollout.
+   * @param [in] rolloutRefStock: An array of references to the rollout. The first one is used for the sequential rollout while the
+   *                              partitioned rollout uses one per partition. The incoming solution trajectories of run() seed
+   *                              the partitions.
+   * @param [in] optimalControlProblemRefStock: An array of references to the optimal control problem. The first one is used for
+   *                                            the metrics while the partitioned rollout linearizes each partition with its own.
    * @param [in] meritFunc: the merit function which gets the PerformanceIndex and returns the merit function value.
    */
-  LevenbergMarquardtStrategy(search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings, RolloutBase& rolloutRefStock,
-                             OptimalControlProblem& optimalControlProblemRef, std::function<scalar_t(const PerformanceIndex&)> meritFunc);
+  LevenbergMarquardtStrategy(search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings, ThreadPool& threadPoolRef,
+                             std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
+                             std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock,
+                             std::function<scalar_t(const PerformanceIndex&)> meritFunc);
 
   ~LevenbergMarquardtStrategy() override = default;
   LevenbergMarquardtStrategy(const LevenbergMarquardtStrategy&) = delete;
@@ -71,7 +77,8 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
   void reset() override;
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-           const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) override;
+           const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, const rollout::TimeGrid& timeGrid,
+           search_strategy::SolutionRef solution) override;
 
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
@@ -93,8 +100,9 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
   const levenberg_marquardt::Settings settings_;
   LevenbergMarquardtModule levenbergMarquardtModule_;
 
-  RolloutBase& rolloutRef_;
-  OptimalControlProblem& optimalControlProblemRef_;
+  ThreadPool& threadPoolRef_;
+  std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
+  std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
 
   scalar_t avgTimeStepFP_ = 0.0;
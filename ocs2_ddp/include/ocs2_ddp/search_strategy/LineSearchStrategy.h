@@ -57,7 +57,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
    * @param [in] baseSettings: The basic settings for the search strategy algorithms.
    * @param [in] settings: The line search settings.
    * @param [in] threadPoolRef: A reference to the thread pool instance.
-   * @param [in] rolloutRefStock: An array of references to the rollout.
+   * @param [in] rolloutRefStock: An array of references to the rollout. Its size determines the number of line search workers.
    * @param [in] optimalControlProblemRef: An array of references to the optimal control problem.
    * @param [in] meritFunc: the merit function which gets the PerformanceIndex and returns the merit function value.
    */
@@ -73,7 +73,8 @@ class LineSearchStrategy final : public SearchStrategyBase {
   void reset() override {}
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-           const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) override;
+           const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, const rollout::TimeGrid& timeGrid,
+           search_strategy::SolutionRef solution) override;
 
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
@@ -89,6 +90,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
     const vector_t* initStatePtr;
     const LinearController* unoptimizedControllerPtr;
     const ModeSchedule* modeSchedulePtr;
+    const rollout::TimeGrid* timeGridPtr;
   };
 
   /** number of line search iterations (the if statements order is important) */
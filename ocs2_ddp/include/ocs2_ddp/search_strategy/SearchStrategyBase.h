@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_data/Metrics.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
+#include <ocs2_oc/rollout/TimeGrid.h>
 
 #include "ocs2_ddp/search_strategy/StrategySettings.h"
 
@@ -80,11 +81,13 @@ class SearchStrategyBase {
    * @param [in] expectedCost: The expected cost based on the LQ model optimization.
    * @param [in] unoptimizedController: The unoptimized controller which search will be performed.
    * @param [in] ModeSchedule The current mode schedule.
+   * @param [in] timeGrid: The time grid adapted to the latest accepted rollout. The sequential rollouts of the search are observed on
+   *                       it, see rollout::Settings::reuseTimeGrid.
    * @param [out] solution: Output of search (primalSolution, performanceIndex, metrics, avgTimeStep)
    * @return whether the search was successful or failed.
    */
   virtual bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-                   const LinearController& unoptimizedController, const ModeSchedule& modeSchedule,
+                   const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, const rollout::TimeGrid& timeGrid,
                    search_strategy::SolutionRef solution) = 0;
 
   /**
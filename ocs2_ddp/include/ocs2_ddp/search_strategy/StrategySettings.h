@@ -72,6 +72,10 @@ struct Settings {
   scalar_t minRelCost = 1e-3;
   /** This value determines the tolerance of constraint's ISE (Integral of Square Error). */
   scalar_t constraintTolerance = 1e-3;
+  /** Use the partitioned rollout if the strategy supports it. @see ddp::Settings::partitionedRollout_ */
+  bool partitionedRollout = false;
+  /** The tolerance on the state defect at the boundaries of the partitioned rollout. */
+  scalar_t partitionedRolloutDefectTolerance = 1e-6;
 };  // end of Settings
 
 }  // namespace search_strategy
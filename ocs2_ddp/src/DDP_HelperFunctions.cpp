@@ -30,10 +30,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 
+#include <unsupported/Eigen/MatrixFunctions>
+
+#include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 #include <ocs2_oc/oc_data/Metrics.h>
 
@@ -147,11 +152,273 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
-                           PrimalSolution& primalSolution) {
+                           PrimalSolution& primalSolution, const rollout::TimeGrid& timeGrid) {
+  // rollout with controller
+  const auto xCurrent =
+      rollout.runOnTimeGrid(timeGrid, initTime, initState, finalTime, primalSolution.controllerPtr_.get(), primalSolution.modeSchedule_,
+                            primalSolution.timeTrajectory_, primalSolution.postEventIndices_, primalSolution.stateTrajectory_,
+                            primalSolution.inputTrajectory_);
+
+  if (!xCurrent.allFinite()) {
+    throw std::runtime_error("[rolloutTrajectory] System became unstable during the rollout!");
+  }
+
+  // average time step
+  return (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
+}
+
+namespace {
+
+/** The trajectories of a partition of the partitioned rollout. */
+struct RolloutPartition {
+  scalar_t initTime;
+  scalar_t finalTime;
+  vector_t initState;
+  bool isValid = false;
+  ModeSchedule modeSchedule;
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  // the closed-loop flow map and the sensitivity of the state to the start state of the partition
+  vector_array_t flowMapTrajectory;
+  matrix_array_t stateSensitivityTrajectory;
+};
+
+/** Returns the state feedback gain of the controller at the given time, or zero if it has no feedback. */
+matrix_t getFeedbackGain(const ControllerBase& controller, scalar_t time, size_t stateDim, size_t inputDim) {
+  if (controller.getType() != ControllerType::LINEAR || controller.empty()) {
+    return matrix_t::Zero(inputDim, stateDim);
+  }
+  const auto& linearController = static_cast<const LinearController&>(controller);
+  return LinearInterpolation::interpolate(time, linearController.timeStamp_, linearController.gainArray_);
+}
+
+/**
+ * Linearizes the closed loop along the partition and computes the sensitivity of the state to the start state of the partition.
+ * In between two nodes, the sensitivity is propagated with the matrix exponential of the average closed-loop state matrix, and
+ * at an event with the state derivative of the jump map.
+ */
+void linearizePartition(OptimalControlProblem& problem, ControllerBase& controller, RolloutPartition& partition) {
+  auto& dynamics = *problem.dynamicsPtr;
+  const auto& timeTrajectory = partition.timeTrajectory;
+  const auto& stateTrajectory = partition.stateTrajectory;
+  const size_t numNodes = timeTrajectory.size();
+
+  partition.flowMapTrajectory.resize(numNodes);
+  partition.stateSensitivityTrajectory.resize(numNodes);
+  matrix_t previousClosedLoopMatrix;
+  for (size_t k = 0; k < numNodes; k++) {
+    const auto& t = timeTrajectory[k];
+    const auto& x = stateTrajectory[k];
+    const auto dynamicsApproximation = dynamics.linearApproximation(t, x, controller.computeInput(t, x));
+    const auto inputDim = dynamicsApproximation.dfdu.cols();
+    const matrix_t closedLoopMatrix =
+        dynamicsApproximation.dfdx + dynamicsApproximation.dfdu * getFeedbackGain(controller, t, x.size(), inputDim);
+    partition.flowMapTrajectory[k] = dynamicsApproximation.f;
+
+    auto& stateSensitivity = partition.stateSensitivityTrajectory[k];
+    if (k == 0) {
+      stateSensitivity.setIdentity(x.size(), x.size());
+    } else if (std::binary_search(partition.postEventIndices.begin(), partition.postEventIndices.end(), k)) {
+      const auto jumpMapApproximation = dynamics.jumpMapLinearApproximation(timeTrajectory[k - 1], stateTrajectory[k - 1]);
+      stateSensitivity = jumpMapApproximation.dfdx * partition.stateSensitivityTrajectory[k - 1];
+    } else {
+      const scalar_t dt = t - timeTrajectory[k - 1];
+      const matrix_t averageClosedLoopMatrix = 0.5 * dt * (previousClosedLoopMatrix + closedLoopMatrix);
+      stateSensitivity = averageClosedLoopMatrix.exp() * partition.stateSensitivityTrajectory[k - 1];
+    }
+    previousClosedLoopMatrix = closedLoopMatrix;
+  }
+}
+
+/**
+ * Shifts the trajectories of a linearized partition by the propagation of its start state defect through the linearized closed
+ * loop. The error of the shifted state trajectory is estimated by the accumulated difference between the trapezoidal integral of
+ * the closed-loop flow map and the state increment over each interval, relative to the same difference of the integrated
+ * trajectory.
+ *
+ * @return The estimated error of the shifted state trajectory.
+ */
+scalar_t shiftPartition(OptimalControlProblem& problem, ControllerBase& controller, const vector_t& defect, RolloutPartition& partition) {
+  auto& dynamics = *problem.dynamicsPtr;
+  const auto& timeTrajectory = partition.timeTrajectory;
+  const size_t numNodes = timeTrajectory.size();
+
+  scalar_t error = 0.0;
+  vector_t previousFlowMapShift;
+  for (size_t k = 0; k < numNodes; k++) {
+    const auto& t = timeTrajectory[k];
+    const vector_t stateShift = partition.stateSensitivityTrajectory[k] * defect;
+    partition.stateTrajectory[k] += stateShift;
+    vector_t input = controller.computeInput(t, partition.stateTrajectory[k]);
+    const vector_t flowMapShift = dynamics.computeFlowMap(t, partition.stateTrajectory[k], input) - partition.flowMapTrajectory[k];
+    if (!partition.inputTrajectory.empty()) {
+      partition.inputTrajectory[k] = std::move(input);
+    }
+    const bool isPostEvent = std::binary_search(partition.postEventIndices.begin(), partition.postEventIndices.end(), k);
+    if (k > 0 && !isPostEvent) {
+      const vector_t previousStateShift = partition.stateSensitivityTrajectory[k - 1] * defect;
+      const scalar_t dt = t - timeTrajectory[k - 1];
+      error += (stateShift - previousStateShift - 0.5 * dt * (previousFlowMapShift + flowMapShift)).lpNorm<Eigen::Infinity>();
+    }
+    previousFlowMapShift = flowMapShift;
+  }
+  partition.initState += defect;
+
+  return error;
+}
+
+/**
+ * Selects the nodes of the nominal trajectory at which the rollout is partitioned. The boundaries are spread equally in time and
+ * skip the pre-event and post-event nodes, such that no event happens at a partition boundary.
+ */
+size_array_t getPartitionBoundaryIndices(const PrimalSolution& nominalPrimalSolution, scalar_t initTime, scalar_t finalTime,
+                                         size_t numPartitions) {
+  const auto& timeTrajectory = nominalPrimalSolution.timeTrajectory_;
+  const auto& postEventIndices = nominalPrimalSolution.postEventIndices_;
+  const auto isEventNode = [&](size_t k) {
+    return std::binary_search(postEventIndices.begin(), postEventIndices.end(), k) ||
+           std::binary_search(postEventIndices.begin(), postEventIndices.end(), k + 1);
+  };
+
+  size_array_t boundaryIndices;
+  const scalar_t partitionDuration = (finalTime - initTime) / static_cast<scalar_t>(numPartitions);
+  for (size_t p = 1; p < numPartitions; p++) {
+    const auto desiredTime = initTime + p * partitionDuration;
+    const auto k = static_cast<size_t>(
+        std::distance(timeTrajectory.begin(), std::lower_bound(timeTrajectory.begin(), timeTrajectory.end(), desiredTime)));
+    if (k >= timeTrajectory.size()) {
+      break;
+    }
+    const auto previousTime = boundaryIndices.empty() ? initTime : timeTrajectory[boundaryIndices.back()];
+    if (timeTrajectory[k] > previousTime + numeric_traits::weakEpsilon<scalar_t>() &&
+        timeTrajectory[k] < finalTime - numeric_traits::weakEpsilon<scalar_t>() && !isEventNode(k)) {
+      boundaryIndices.push_back(k);
+    }
+  }
+  return boundaryIndices;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t partitionedRollout(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                            const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                            const PrimalSolution& nominalPrimalSolution, scalar_t defectTolerance, scalar_t initTime,
+                            const vector_t& initState, scalar_t finalTime, ControllerBase* controller, ModeSchedule& modeSchedule,
+                            scalar_array_t& timeTrajectory, size_array_t& postEventIndices, vector_array_t& stateTrajectory,
+                            vector_array_t& inputTrajectory) {
+  if (problemRefStock.size() < rolloutRefStock.size()) {
+    throw std::runtime_error("[partitionedRollout] An optimal control problem is required for each rollout!");
+  }
+
+  const auto boundaryIndices = getPartitionBoundaryIndices(nominalPrimalSolution, initTime, finalTime, rolloutRefStock.size());
+  if (boundaryIndices.empty()) {
+    return rolloutRefStock.front().get().run(initTime, initState, finalTime, controller, modeSchedule, timeTrajectory, postEventIndices,
+                                             stateTrajectory, inputTrajectory);
+  }
+
+  // partitions start from the nominal trajectory
+  const size_t numPartitions = boundaryIndices.size() + 1;
+  std::vector<RolloutPartition> partitions(numPartitions);
+  for (size_t p = 0; p < numPartitions; p++) {
+    auto& partition = partitions[p];
+    partition.initTime = (p == 0) ? initTime : nominalPrimalSolution.timeTrajectory_[boundaryIndices[p - 1]];
+    partition.finalTime = (p + 1 == numPartitions) ? finalTime : nominalPrimalSolution.timeTrajectory_[boundaryIndices[p]];
+    partition.initState = (p == 0) ? initState : nominalPrimalSolution.stateTrajectory_[boundaryIndices[p - 1]];
+    partition.modeSchedule = modeSchedule;
+  }
+
+  const auto rolloutPartition = [&](size_t p) {
+    auto& partition = partitions[p];
+    RolloutBase& rollout = rolloutRefStock[p];
+    const auto xFinal = rollout.run(partition.initTime, partition.initState, partition.finalTime, controller, partition.modeSchedule,
+                                    partition.timeTrajectory, partition.postEventIndices, partition.stateTrajectory,
+                                    partition.inputTrajectory);
+    partition.isValid = xFinal.allFinite();
+  };
+
+  // integrate and linearize all partitions in parallel. A partition which fails from its nominal start state is re-integrated in
+  // the sweep.
+  std::atomic_size_t nextPartition{0};
+  threadPool.runParallel(
+      [&](int) {
+        size_t p;
+        while ((p = nextPartition++) < numPartitions) {
+          try {
+            rolloutPartition(p);
+            if (p > 0 && partitions[p].isValid) {
+              linearizePartition(problemRefStock[p], *controller, partitions[p]);
+            }
+          } catch (const std::exception&) {
+            partitions[p].isValid = false;
+          }
+        }
+      },
+      numPartitions);
+
+  // Sequential defect-correction sweep. The start state defect of a partition is propagated through its linearized closed loop and
+  // the partition is only re-integrated if the error estimate of the shifted trajectory exceeds the tolerance.
+  if (!partitions.front().isValid) {
+    throw std::runtime_error("[partitionedRollout] System became unstable during the rollout!");
+  }
+  for (size_t p = 1; p < numPartitions; p++) {
+    const auto& xFinalPrevious = partitions[p - 1].stateTrajectory.back();
+    auto& partition = partitions[p];
+    const vector_t defect = xFinalPrevious - partition.initState;
+    if (partition.isValid && defect.lpNorm<Eigen::Infinity>() <= defectTolerance) {
+      continue;
+    }
+    if (partition.isValid) {
+      RolloutPartition shiftedPartition = partition;
+      if (shiftPartition(problemRefStock[p], *controller, defect, shiftedPartition) <= defectTolerance &&
+          shiftedPartition.stateTrajectory.back().allFinite()) {
+        partition = std::move(shiftedPartition);
+        continue;
+      }
+    }
+    partition.initState = xFinalPrevious;
+    rolloutPartition(p);
+    if (!partition.isValid) {
+      throw std::runtime_error("[partitionedRollout] System became unstable during the rollout!");
+    }
+  }
+
+  // concatenate the partitions, the first node of a partition coincides with the last node of the preceding one
+  timeTrajectory.clear();
+  postEventIndices.clear();
+  stateTrajectory.clear();
+  inputTrajectory.clear();
+  for (size_t p = 0; p < numPartitions; p++) {
+    const auto& partition = partitions[p];
+    const size_t firstIndex = (p == 0) ? 0 : 1;
+    const size_t offset = timeTrajectory.size();
+    for (const auto index : partition.postEventIndices) {
+      postEventIndices.push_back(offset + index - firstIndex);
+    }
+    timeTrajectory.insert(timeTrajectory.end(), partition.timeTrajectory.begin() + firstIndex, partition.timeTrajectory.end());
+    stateTrajectory.insert(stateTrajectory.end(), partition.stateTrajectory.begin() + firstIndex, partition.stateTrajectory.end());
+    inputTrajectory.insert(inputTrajectory.end(), partition.inputTrajectory.begin() + firstIndex, partition.inputTrajectory.end());
+  }
+
+  return stateTrajectory.back();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t rolloutTrajectory(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                           const std::vector<std::reference_wrapper<OptimalControlProblem>>& problemRefStock,
+                           const PrimalSolution& nominalPrimalSolution, scalar_t defectTolerance, scalar_t initTime,
+                           const vector_t& initState, scalar_t finalTime, PrimalSolution& primalSolution) {
   // rollout with controller
-  const auto xCurrent = rollout.run(initTime, initState, finalTime, primalSolution.controllerPtr_.get(), primalSolution.modeSchedule_,
-                                    primalSolution.timeTrajectory_, primalSolution.postEventIndices_, primalSolution.stateTrajectory_,
-                                    primalSolution.inputTrajectory_);
+  const auto xCurrent = partitionedRollout(threadPool, rolloutRefStock, problemRefStock, nominalPrimalSolution, defectTolerance, initTime,
+                                           initState, finalTime, primalSolution.controllerPtr_.get(), primalSolution.modeSchedule_,
+                                           primalSolution.timeTrajectory_, primalSolution.postEventIndices_,
+                                           primalSolution.stateTrajectory_, primalSolution.inputTrajectory_);
 
   if (!xCurrent.allFinite()) {
     throw std::runtime_error("[rolloutTrajectory] System became unstable during the rollout!");
@@ -93,6 +93,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
 
+  loadData::loadPtreeValue(pt, settings.partitionedRollout_, fieldName + ".partitionedRollout", verbose);
+  loadData::loadPtreeValue(pt, settings.partitionedRolloutDefectTolerance_, fieldName + ".partitionedRolloutDefectTolerance", verbose);
+
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
   loadData::loadPtreeValue(pt, settings.riskSensitiveCoeff_, fieldName + ".riskSensitiveCoeff", verbose);
@@ -52,8 +52,12 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-                               const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+                               const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
+    : ddpSettings_(std::move(ddpSettings)), threadPoolPtr_(std::move(threadPoolPtr)) {
+  if (threadPoolPtr_ == nullptr) {
+    threadPoolPtr_ = std::make_shared<ThreadPool>(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_);
+  }
+
   // check OCP
   if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
     throw std::runtime_error(
@@ -97,26 +101,21 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
     s.debugPrintRollout = ddpSettings_.debugPrintRollout_;
     s.minRelCost = ddpSettings_.minRelCost_;
     s.constraintTolerance = ddpSettings_.constraintTolerance_;
+    s.partitionedRollout = ddpSettings_.partitionedRollout_;
+    s.partitionedRolloutDefectTolerance = ddpSettings_.partitionedRolloutDefectTolerance_;
     return s;
   }();
   auto meritFunc = [this](const PerformanceIndex& p) { return calculateRolloutMerit(p); };
   switch (ddpSettings_.strategy_) {
     case search_strategy::Type::LINE_SEARCH: {
-      std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
-      std::vector<std::reference_wrapper<OptimalControlProblem>> problemRefStock;
-      for (size_t i = 0; i < ddpSettings_.nThreads_; i++) {
-        rolloutRefStock.emplace_back(*dynamicsForwardRolloutPtrStock_[i]);
-        problemRefStock.emplace_back(optimalControlProblemStock_[i]);
-      }  // end of i loop
-      searchStrategyPtr_.reset(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_, threadPool_,
-                                                      std::move(rolloutRefStock), std::move(problemRefStock), meritFunc));
+      searchStrategyPtr_.reset(new LineSearchStrategy(basicStrategySettings, ddpSettings_.lineSearch_, *threadPoolPtr_,
+                                                      getDynamicsForwardRolloutRefStock(), getOptimalControlProblemRefStock(), meritFunc));
       break;
     }
     case search_strategy::Type::LEVENBERG_MARQUARDT: {
-      constexpr size_t threadID = 0;
-      searchStrategyPtr_.reset(new LevenbergMarquardtStrategy(basicStrategySettings, ddpSettings_.levenbergMarquardt_,
-                                                              *dynamicsForwardRolloutPtrStock_[threadID],
-                                                              optimalControlProblemStock_[threadID], meritFunc));
+      searchStrategyPtr_.reset(new LevenbergMarquardtStrategy(basicStrategySettings, ddpSettings_.levenbergMarquardt_, *threadPoolPtr_,
+                                                              getDynamicsForwardRolloutRefStock(), getOptimalControlProblemRefStock(),
+                                                              meritFunc));
       break;
     }
   }  // end of switch-case
@@ -182,6 +181,11 @@ void GaussNewtonDDP::reset() {
   dualData_.clear();
   cachedDualData_.clear();
 
+  // the state that the rollouts carry between iterations, e.g., the step-size warm start of the integrators
+  for (auto& rolloutPtr : dynamicsForwardRolloutPtrStock_) {
+    rolloutPtr->resetRollout();
+  }
+
   // initialize Augmented Lagrangian parameters
   initializeConstraintPenalties();
 
@@ -335,6 +339,47 @@ ScalarFunctionQuadraticApproximation GaussNewtonDDP::getHamiltonian(scalar_t tim
   return hamiltonian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_array_t GaussNewtonDDP::getEventTimesDerivatives() {
+  const auto& primalSolution = nominalPrimalData_.primalSolution;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+  const auto& valueFunctionTrajectory = dualData_.valueFunctionTrajectory;
+  if (valueFunctionTrajectory.size() != primalSolution.timeTrajectory_.size()) {
+    throw std::runtime_error("[GaussNewtonDDP::getEventTimesDerivatives] The value function of the nominal trajectories is not available!");
+  }
+
+  // the Hamiltonian at a node of the nominal trajectories where the costate is the gradient of the value function
+  auto hamiltonian = [&](size_t taskId, size_t timeIndex) {
+    const auto modelData =
+        ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], primalSolution.timeTrajectory_[timeIndex],
+                                        primalSolution.stateTrajectory_[timeIndex], primalSolution.inputTrajectory_[timeIndex]);
+    return modelData.cost.f + valueFunctionTrajectory[timeIndex].dfdx.dot(modelData.dynamics.f);
+  };
+
+  scalar_array_t eventTimesDerivatives(postEventIndices.size());
+  if (postEventIndices.empty()) {
+    return eventTimesDerivatives;
+  }
+
+  nextTimeIndex_ = 0;
+  nextTaskId_ = 0;
+  auto task = [&]() {
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+    size_t eventIndex;
+    // get next event index (atomic)
+    while ((eventIndex = nextTimeIndex_++) < postEventIndices.size()) {
+      // extending the pre-event mode by dt changes the cost by (H^- - H^+) * dt, the jump map is included in the pre-event costate
+      const size_t postEventIndex = postEventIndices[eventIndex];
+      eventTimesDerivatives[eventIndex] = hamiltonian(taskId, postEventIndex - 1) - hamiltonian(taskId, postEventIndex);
+    }
+  };
+  runParallel(task, std::min(ddpSettings_.nThreads_, postEventIndices.size()));
+
+  return eventTimesDerivatives;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -404,7 +449,31 @@ std::vector<std::pair<int, int>> GaussNewtonDDP::getPartitionIntervalsFromTimeTr
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::runParallel(std::function<void(void)> taskFunction, size_t N) {
-  threadPool_.runParallel([&](int) { taskFunction(); }, N);
+  threadPoolPtr_->runParallel([&](int) { taskFunction(); }, N);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::reference_wrapper<RolloutBase>> GaussNewtonDDP::getDynamicsForwardRolloutRefStock() {
+  std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
+  rolloutRefStock.reserve(dynamicsForwardRolloutPtrStock_.size());
+  for (auto& rolloutPtr : dynamicsForwardRolloutPtrStock_) {
+    rolloutRefStock.emplace_back(*rolloutPtr);
+  }
+  return rolloutRefStock;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::reference_wrapper<OptimalControlProblem>> GaussNewtonDDP::getOptimalControlProblemRefStock() {
+  std::vector<std::reference_wrapper<OptimalControlProblem>> problemRefStock;
+  problemRefStock.reserve(optimalControlProblemStock_.size());
+  for (auto& problem : optimalControlProblemStock_) {
+    problemRefStock.emplace_back(problem);
+  }
+  return problemRefStock;
 }
 
 /******************************************************************************************************/
@@ -444,9 +513,18 @@ void GaussNewtonDDP::rolloutInitialTrajectory(PrimalDataContainer& primalData, C
   // rollout with controller
   vector_t xCurrent = initState_;
   if (controllerRolloutFromTo.first < controllerRolloutFromTo.second) {
-    xCurrent = dynamicsForwardRolloutPtrStock_[workerIndex]->run(controllerRolloutFromTo.first, initState_, controllerRolloutFromTo.second,
-                                                                 controller, modeSchedule, timeTrajectory, postEventIndices,
-                                                                 stateTrajectory, inputTrajectory);
+    if (ddpSettings_.partitionedRollout_) {
+      // the partitions start from the nominal trajectories of the previous call, which are cached at this point
+      xCurrent = partitionedRollout(*threadPoolPtr_, getDynamicsForwardRolloutRefStock(), getOptimalControlProblemRefStock(),
+                                    cachedPrimalData_.primalSolution, ddpSettings_.partitionedRolloutDefectTolerance_,
+                                    controllerRolloutFromTo.first, initState_, controllerRolloutFromTo.second, controller, modeSchedule,
+                                    timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+    } else {
+      // the time grid of the previous call is cached at this point as well. It is ignored if the horizon has moved.
+      xCurrent = dynamicsForwardRolloutPtrStock_[workerIndex]->runOnTimeGrid(
+          cachedPrimalData_.timeGrid, controllerRolloutFromTo.first, initState_, controllerRolloutFromTo.second, controller, modeSchedule,
+          timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+    }
   }
 
   // finish rollout with operating points
@@ -485,6 +563,11 @@ void GaussNewtonDDP::rolloutInitialTrajectory(PrimalDataContainer& primalData, C
     throw std::runtime_error("[GaussNewtonDDP::rolloutInitialTrajectory] System became unstable during the initial rollout!");
   }
 
+  // the operating trajectories do not resolve the dynamics, hence only a controller rollout over the whole horizon adapts the time grid
+  if (operatingPointsFromTo.first >= operatingPointsFromTo.second) {
+    updateTimeGrid(primalData);
+  }
+
   // debug print
   if (ddpSettings_.debugPrintRollout_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++\n";
@@ -894,17 +977,35 @@ void GaussNewtonDDP::runSearchStrategy(scalar_t lqModelExpectedCost, const Linea
                                        PrimalDataContainer& primalData, PerformanceIndex& performanceIndex, MetricsCollection& metrics) {
   const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
 
+  // the latest accepted nominal data is cached during an iteration and it is the nominal one in the final search
+  const bool isFinalSearch = (&primalData != &nominalPrimalData_);
+  const auto& latestPrimalData = isFinalSearch ? nominalPrimalData_ : cachedPrimalData_;
+
+  // The partitioned rollout of the Levenberg-Marquardt strategy starts from the incoming trajectories, i.e., the latest nominal ones
+  if (ddpSettings_.partitionedRollout_ && ddpSettings_.strategy_ == search_strategy::Type::LEVENBERG_MARQUARDT) {
+    primalData.primalSolution.timeTrajectory_ = latestPrimalData.primalSolution.timeTrajectory_;
+    primalData.primalSolution.postEventIndices_ = latestPrimalData.primalSolution.postEventIndices_;
+    primalData.primalSolution.stateTrajectory_ = latestPrimalData.primalSolution.stateTrajectory_;
+  }
+
   // Primal solution controller is now optimized.
   scalar_t avgTimeStep;
   search_strategy::SolutionRef solution(primalData.primalSolution, performanceIndex, metrics, avgTimeStep);
-  const bool success =
-      searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController, modeSchedule, solution);
+  const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController,
+                                               modeSchedule, latestPrimalData.timeGrid, solution);
   avgTimeStepFP_ = 0.9 * avgTimeStepFP_ + 0.1 * avgTimeStep;
 
+  // the next rollouts are observed on the time grid of the accepted nominal trajectories
+  if (success && !isFinalSearch) {
+    updateTimeGrid(primalData);
+  }
+
   // If fail, copy the entire cache back. To keep the consistency of cached data, all cache should be left untouched.
   if (!success) {
     primalData = cachedPrimalData_;
     performanceIndex = performanceIndexHistory_.back();
+    // the metrics of the rejected trial are replaced, such that they always describe the same iterate as the performance index
+    computeRolloutMetrics(optimalControlProblemStock_[0], primalData.primalSolution, metrics);
   }
 }
 
@@ -933,6 +1034,20 @@ void GaussNewtonDDP::updateConstraintPenalties(scalar_t equalityConstraintsSSE)
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateTimeGrid(PrimalDataContainer& primalData) const {
+  const auto& rollout = *dynamicsForwardRolloutPtrStock_.front();
+  if (rollout.settings().reuseTimeGrid) {
+    const auto& primalSolution = primalData.primalSolution;
+    primalData.timeGrid = rollout.adaptTimeGrid(initTime_, finalTime_, primalSolution.modeSchedule_, primalSolution.timeTrajectory_,
+                                                primalSolution.postEventIndices_, primalSolution.stateTrajectory_);
+  } else {
+    primalData.timeGrid.clear();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -944,7 +1059,7 @@ void GaussNewtonDDP::swapDataToCache() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GaussNewtonDDP::runInit() {
+bool GaussNewtonDDP::runInit() {
   // disable Eigen multi-threading
   Eigen::setNbThreads(1);
 
@@ -989,6 +1104,12 @@ void GaussNewtonDDP::runInit() {
   approximateOptimalControlProblem();
   linearQuadraticApproximationTimer_.endTimer();
 
+  // the LQ approximation might be incomplete
+  if (isInterruptedWithController(nominalPrimalData_)) {
+    Eigen::setNbThreads(0);
+    return false;
+  }
+
   // solve Riccati equations
   backwardPassTimer_.startTimer();
   avgTimeStepBP_ = solveSequentialRiccatiEquations(heuristics_);
@@ -1009,12 +1130,14 @@ void GaussNewtonDDP::runInit() {
   // TODO(mspieler): this is not exception safe
   // restore default Eigen thread number
   Eigen::setNbThreads(0);
+
+  return true;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
+bool GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   // disable Eigen multi-threading
   Eigen::setNbThreads(1);
 
@@ -1026,11 +1149,23 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   // update the constraint penalty coefficients
   updateConstraintPenalties(performanceIndex_.equalityConstraintsSSE);
 
+  // the accepted iterate of the search is kept, but the LQ model and the controller are not updated anymore
+  if (isInterrupted()) {
+    Eigen::setNbThreads(0);
+    return false;
+  }
+
   // linearizing the dynamics and quadratizing the cost function along nominal trajectories
   linearQuadraticApproximationTimer_.startTimer();
   approximateOptimalControlProblem();
   linearQuadraticApproximationTimer_.endTimer();
 
+  // the LQ approximation might be incomplete
+  if (isInterrupted()) {
+    Eigen::setNbThreads(0);
+    return false;
+  }
+
   // solve Riccati equations
   backwardPassTimer_.startTimer();
   avgTimeStepBP_ = solveSequentialRiccatiEquations(heuristics_);
@@ -1051,6 +1186,8 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   // TODO(mspieler): this is not exception safe
   // restore default Eigen thread number
   Eigen::setNbThreads(0);
+
+  return true;
 }
 
 /******************************************************************************************************/
@@ -1109,7 +1246,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   // swap nominal trajectories (time, state, input, ...) to cache before new rollout
   swapDataToCache();
   // run DDP initializer and update the member variables
-  runInit();
+  bool isIterationComplete = runInit();
 
   // increment iteration counter
   totalNumIterations_++;
@@ -1119,7 +1256,8 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   std::string convergenceInfo;
 
   // DDP main loop
-  while (!isConverged && (totalNumIterations_ - initIteration) < ddpSettings_.maxNumIterations_) {
+  while (isIterationComplete && !isConverged && (totalNumIterations_ - initIteration) < ddpSettings_.maxNumIterations_ &&
+         !isInterrupted()) {
     // display the iteration's input update norm (before caching the old nominals)
     if (ddpSettings_.displayInfo_) {
       std::cerr << "\n###################";
@@ -1138,11 +1276,15 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     // cache the nominal trajectories before the new rollout (time, state, input, ...)
     swapDataToCache();
-    runIteration(lqModelExpectedCost);
+    isIterationComplete = runIteration(lqModelExpectedCost);
 
     // increment iteration counter
     totalNumIterations_++;
 
+    if (!isIterationComplete) {
+      break;
+    }
+
     // check convergence
     std::tie(isConverged, convergenceInfo) =
         searchStrategyPtr_->checkConvergence(unreliableControllerIncrement, performanceIndexHistory_.back(), performanceIndex_);
@@ -1159,13 +1301,25 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   performanceIndexHistory_.push_back(performanceIndex_);
 
-  // finding the final optimal stepLength and getting the optimal trajectories and controller
-  searchStrategyTimer_.startTimer();
-  const scalar_t lqModelExpectedCost = dualData_.valueFunctionTrajectory.front().f;
-  runSearchStrategy(lqModelExpectedCost, unoptimizedController_, optimizedPrimalData_, performanceIndex_, metrics_);
-  searchStrategyTimer_.endTimer();
+  // On interrupt, the latest accepted iterate is returned as long as it contains a controller. Otherwise, the final search is still
+  // required to get a policy. The performance index and the metrics are already the ones of this iterate, since they are only
+  // written by the rollout of runInit() and by the search together with the nominal primal solution.
+  if (isInterruptedWithController(nominalPrimalData_)) {
+    optimizedPrimalData_.primalSolution = nominalPrimalData_.primalSolution;
+    // the LQ model of an incomplete iteration is not consistent with the nominal trajectories, so the previous one is restored
+    if (!isIterationComplete) {
+      swapDataToCache();
+    }
 
-  performanceIndexHistory_.push_back(performanceIndex_);
+  } else {
+    // finding the final optimal stepLength and getting the optimal trajectories and controller
+    searchStrategyTimer_.startTimer();
+    const scalar_t lqModelExpectedCost = dualData_.valueFunctionTrajectory.front().f;
+    runSearchStrategy(lqModelExpectedCost, unoptimizedController_, optimizedPrimalData_, performanceIndex_, metrics_);
+    searchStrategyTimer_.endTimer();
+
+    performanceIndexHistory_.push_back(performanceIndex_);
+  }
 
   // display
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
@@ -1179,6 +1333,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     if (isConverged) {
       std::cerr << convergenceInfo << std::endl;
+    } else if (getInterruptStatus() != InterruptStatus::NONE) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The solver has been interrupted (i.e., " << toString(getInterruptStatus()) << ")." << std::endl;
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
@@ -36,8 +36,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-           const Initializer& initializer)
-    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer) {
+           const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
+    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer, std::move(threadPoolPtr)) {
   if (settings().algorithm_ != ddp::Algorithm::ILQR) {
     throw std::runtime_error("[ILQR] In DDP setting the algorithm name is set \"" + ddp::toAlgorithmName(settings().algorithm_) +
                              "\" while ILQR is instantiated!");
@@ -54,6 +54,10 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
       case IntegratorType::ODE45_OCS2:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+      case IntegratorType::RADAU_IIA5:
+        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RADAU_IIA5);
+      case IntegratorType::BDF2:
+        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::IMPLICIT_EULER);
       default:
         throw std::runtime_error("[ILQR] Integrator of type " + integrator_type::toString(settings().backwardPassIntegratorType_) +
                                  " is not supported for sensitivity discretization! Modify ddp::Settings::backwardPassIntegratorType_.");
@@ -94,9 +98,9 @@ void ILQR::approximateIntermediateLQ(PrimalDataContainer& primalData) {
 
     ModelData continuousTimeModelData;
 
-    // get next time index is atomic
+    // get next time index is atomic. An interrupt leaves the remaining nodes unapproximated.
     size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
+    while (!isInterruptedWithController(primalData) && (timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
       // approximate continuous LQ for the given time index
       ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
                                       inputTrajectory[timeIndex], continuousTimeModelData);
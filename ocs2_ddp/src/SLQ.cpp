@@ -38,8 +38,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
-         const Initializer& initializer)
-    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer) {
+         const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
+    : GaussNewtonDDP(std::move(ddpSettings), rollout, optimalControlProblem, initializer, std::move(threadPoolPtr)) {
   if (settings().algorithm_ != ddp::Algorithm::SLQ) {
     throw std::runtime_error("[SLQ] In DDP setting the algorithm name is set \"" + ddp::toAlgorithmName(settings().algorithm_) +
                              "\" while SLQ is instantiated!");
@@ -91,9 +91,9 @@ void SLQ::approximateIntermediateLQ(PrimalDataContainer& primalData) {
   auto task = [&]() {
     const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
 
-    // get next time index is atomic
+    // get next time index is atomic. An interrupt leaves the remaining nodes unapproximated.
     size_t timeIndex;
-    while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
+    while (!isInterruptedWithController(primalData) && (timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
       // approximate LQ for the given time index
       ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
                                       inputTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
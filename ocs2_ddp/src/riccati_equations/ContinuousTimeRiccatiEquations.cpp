@@ -121,6 +121,7 @@ void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr,
   projectedModelDataPtr_ = projectedModelDataPtr;
   modelDataEventTimesPtr_ = modelDataEventTimesPtr;
   riccatiModificationPtr_ = riccatiModificationPtr;
+  timeSegmentHint_ = 0;
 
   eventTimes_.clear();
   eventTimes_.reserve(eventsPastTheEndIndecesPtr->size());
@@ -152,7 +153,9 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector_t& allSs) {
   // index
   const scalar_t t = -z;  // denormalized time
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
+  // the integration queries close times in sequence, hence the search starts from the previous interval
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_, timeSegmentHint_);
+  timeSegmentHint_ = indexAlpha.first;
 
   convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
@@ -181,27 +184,27 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
    */
 
   // Hv
-  creCache.projectedHv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias, creCache.projectedHv_);
   // Am
-  creCache.projectedAm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx, creCache.projectedAm_);
   // Bm
-  creCache.projectedBm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu, creCache.projectedBm_);
   // q
-  ds = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_f);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_f, ds);
   // Qv
-  dSv = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx, dSv);
   // Qm
-  dSm = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx, dSm);
   // Rv
-  creCache.projectedGv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu, creCache.projectedGv_);
   // Pm
-  creCache.projectedGm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux, creCache.projectedGm_);
   // delatQm
-  creCache.deltaQm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm);
+  LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm, creCache.deltaQm_);
   // delatGm
-  creCache.projectedKm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGm);
+  LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGm, creCache.projectedKm_);
   // delatGv
-  creCache.projectedLv_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv);
+  LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv, creCache.projectedLv_);
 
   // projectedGm = projectedPm + projectedBm^T * Sm [COMPLEXITY: nx^2 * np]
   creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * Sm;
@@ -220,7 +223,7 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
   if (!reducedFormRiccati_) {
     // Rm
-    creCache.projectedRm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu);
+    LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu, creCache.projectedRm_);
     // [COMPLEXITY: nx * np^2]
     creCache.projectedRm_projectedKm_.noalias() = creCache.projectedRm_ * creCache.projectedKm_;
     // [COMPLEXITY: np^2]
@@ -300,7 +303,7 @@ void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t>
   computeFlowMapSLQ(indexAlpha, Sm, Sv, s, creCache, dSm, dSv, ds);
 
   // Sigma
-  creCache.dynamicsCovariance_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance);
+  LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance, creCache.dynamicsCovariance_);
 
   creCache.Sigma_Sv_.noalias() = creCache.dynamicsCovariance_ * Sv;
   creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * Sm;
@@ -37,13 +37,16 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings,
-                                                       RolloutBase& rolloutRef, OptimalControlProblem& optimalControlProblemRef,
-                                                       std::function<scalar_t(const PerformanceIndex&)> meritFunc)
+LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(
+    search_strategy::Settings baseSettings, levenberg_marquardt::Settings settings, ThreadPool& threadPoolRef,
+    std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock,
+    std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock,
+    std::function<scalar_t(const PerformanceIndex&)> meritFunc)
     : SearchStrategyBase(std::move(baseSettings)),
       settings_(std::move(settings)),
-      rolloutRef_(rolloutRef),
-      optimalControlProblemRef_(optimalControlProblemRef),
+      threadPoolRef_(threadPoolRef),
+      rolloutRefStock_(std::move(rolloutRefStock)),
+      optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
       meritFunc_(std::move(meritFunc)) {}
 
 /******************************************************************************************************/
@@ -58,7 +61,8 @@ void LevenbergMarquardtStrategy::reset() {
 /******************************************************************************************************/
 bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
                                      const scalar_t expectedCost, const LinearController& unoptimizedController,
-                                     const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) {
+                                     const ModeSchedule& modeSchedule, const rollout::TimeGrid& timeGrid,
+                                     search_strategy::SolutionRef solution) {
   constexpr size_t taskId = 0;
 
   // previous merit and the expected reduction
@@ -72,10 +76,22 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
     // compute primal solution
     solution.primalSolution.modeSchedule_ = modeSchedule;
     incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
-    solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
+    if (baseSettings_.partitionedRollout) {
+      // the incoming trajectories are the nominal ones which seed the partitions
+      PrimalSolution nominalPrimalSolution;
+      nominalPrimalSolution.timeTrajectory_.swap(solution.primalSolution.timeTrajectory_);
+      nominalPrimalSolution.postEventIndices_.swap(solution.primalSolution.postEventIndices_);
+      nominalPrimalSolution.stateTrajectory_.swap(solution.primalSolution.stateTrajectory_);
+      solution.avgTimeStep = rolloutTrajectory(threadPoolRef_, rolloutRefStock_, optimalControlProblemRefStock_, nominalPrimalSolution,
+                                               baseSettings_.partitionedRolloutDefectTolerance, timePeriod.first, initState,
+                                               timePeriod.second, solution.primalSolution);
+    } else {
+      solution.avgTimeStep =
+          rolloutTrajectory(rolloutRefStock_.front(), timePeriod.first, initState, timePeriod.second, solution.primalSolution, timeGrid);
+    }
 
     // compute metrics
-    computeRolloutMetrics(optimalControlProblemRef_, solution.primalSolution, solution.metrics);
+    computeRolloutMetrics(optimalControlProblemRefStock_.front(), solution.primalSolution, solution.metrics);
 
     // compute performanceIndex
     solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.metrics);
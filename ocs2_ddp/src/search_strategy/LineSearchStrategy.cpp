@@ -44,7 +44,7 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
     : SearchStrategyBase(std::move(baseSettings)),
       settings_(std::move(settings)),
       threadPoolRef_(threadPoolRef),
-      workersSolution_(threadPoolRef.numThreads() + 1),
+      workersSolution_(rolloutRefStock.size()),
       rolloutRefStock_(std::move(rolloutRefStock)),
       optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
       meritFunc_(std::move(meritFunc)) {
@@ -87,7 +87,8 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
   solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution,
+                                           *lineSearchInputRef_.timeGridPtr);
 
   // compute metrics
   computeRolloutMetrics(problem, solution.primalSolution, solution.metrics);
@@ -110,12 +111,13 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
 /******************************************************************************************************/
 bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
                              const LinearController& unoptimizedController, const ModeSchedule& modeSchedule,
-                             search_strategy::SolutionRef solutionRef) {
+                             const rollout::TimeGrid& timeGrid, search_strategy::SolutionRef solutionRef) {
   // initialize lineSearchModule inputs
   lineSearchInputRef_.timePeriodPtr = &timePeriod;
   lineSearchInputRef_.initStatePtr = &initState;
   lineSearchInputRef_.unoptimizedControllerPtr = &unoptimizedController;
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
+  lineSearchInputRef_.timeGridPtr = &timeGrid;
   bestSolutionRef_ = &solutionRef;
 
   // perform a rollout with steplength zero.
@@ -142,8 +144,10 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
+  // the number of line search workers is set by the solver resources, not by the (possibly shared) thread pool
+  const int numWorkers = static_cast<int>(rolloutRefStock_.size()) - 1;
   auto task = [&](int) { lineSearchTask(nextTaskId_++); };
-  threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  threadPoolRef_.runParallel(task, numWorkers);
 
   // revitalize all integrators
   for (RolloutBase& rollout : rolloutRefStock_) {
@@ -28,18 +28,92 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 #include <ocs2_oc/test/EXP0.h>
 
+#include <ocs2_ddp/DDP_HelperFunctions.h>
 #include <ocs2_ddp/ILQR.h>
 #include <ocs2_ddp/SLQ.h>
 
+/** A rollout which counts its runs. */
+class CountingRollout : public ocs2::RolloutBase {
+ public:
+  explicit CountingRollout(const ocs2::RolloutBase& rollout) : ocs2::RolloutBase(rollout.settings()), rolloutPtr_(rollout.clone()) {}
+  CountingRollout* clone() const override { return new CountingRollout(*rolloutPtr_); }
+
+  ocs2::vector_t run(ocs2::scalar_t initTime, const ocs2::vector_t& initState, ocs2::scalar_t finalTime, ocs2::ControllerBase* controller,
+                     ocs2::ModeSchedule& modeSchedule, ocs2::scalar_array_t& timeTrajectory, ocs2::size_array_t& postEventIndices,
+                     ocs2::vector_array_t& stateTrajectory, ocs2::vector_array_t& inputTrajectory) override {
+    numRuns++;
+    return rolloutPtr_->run(initTime, initState, finalTime, controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory,
+                            inputTrajectory);
+  }
+
+  size_t numRuns = 0;
+
+ private:
+  std::unique_ptr<ocs2::RolloutBase> rolloutPtr_;
+};
+
+/** A rollout which records the number of nodes of its runs and the number of its resets. The clones share the record. */
+class RecordingRollout : public ocs2::RolloutBase {
+ public:
+  struct Record {
+    std::mutex mutex;
+    std::vector<size_t> numNodes;
+    size_t numResets = 0;
+  };
+
+  RecordingRollout(const ocs2::RolloutBase& rollout, std::shared_ptr<Record> recordPtr)
+      : ocs2::RolloutBase(rollout.settings()), rolloutPtr_(rollout.clone()), recordPtr_(std::move(recordPtr)) {}
+  RecordingRollout* clone() const override { return new RecordingRollout(*rolloutPtr_, recordPtr_); }
+
+  void resetRollout() override {
+    rolloutPtr_->resetRollout();
+    std::lock_guard<std::mutex> lock(recordPtr_->mutex);
+    recordPtr_->numResets++;
+  }
+
+  ocs2::vector_t run(ocs2::scalar_t initTime, const ocs2::vector_t& initState, ocs2::scalar_t finalTime, ocs2::ControllerBase* controller,
+                     ocs2::ModeSchedule& modeSchedule, ocs2::scalar_array_t& timeTrajectory, ocs2::size_array_t& postEventIndices,
+                     ocs2::vector_array_t& stateTrajectory, ocs2::vector_array_t& inputTrajectory) override {
+    return runOnTimeGrid(ocs2::rollout::TimeGrid(), initTime, initState, finalTime, controller, modeSchedule, timeTrajectory,
+                         postEventIndices, stateTrajectory, inputTrajectory);
+  }
+
+  ocs2::vector_t runOnTimeGrid(const ocs2::rollout::TimeGrid& timeGrid, ocs2::scalar_t initTime, const ocs2::vector_t& initState,
+                               ocs2::scalar_t finalTime, ocs2::ControllerBase* controller, ocs2::ModeSchedule& modeSchedule,
+                               ocs2::scalar_array_t& timeTrajectory, ocs2::size_array_t& postEventIndices,
+                               ocs2::vector_array_t& stateTrajectory, ocs2::vector_array_t& inputTrajectory) override {
+    const auto finalState = rolloutPtr_->runOnTimeGrid(timeGrid, initTime, initState, finalTime, controller, modeSchedule, timeTrajectory,
+                                                       postEventIndices, stateTrajectory, inputTrajectory);
+    std::lock_guard<std::mutex> lock(recordPtr_->mutex);
+    recordPtr_->numNodes.push_back(timeTrajectory.size());
+    return finalState;
+  }
+
+  ocs2::rollout::TimeGrid adaptTimeGrid(ocs2::scalar_t initTime, ocs2::scalar_t finalTime, const ocs2::ModeSchedule& modeSchedule,
+                                        const ocs2::scalar_array_t& timeTrajectory, const ocs2::size_array_t& postEventIndices,
+                                        const ocs2::vector_array_t& stateTrajectory) const override {
+    return rolloutPtr_->adaptTimeGrid(initTime, finalTime, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory);
+  }
+
+ private:
+  std::unique_ptr<ocs2::RolloutBase> rolloutPtr_;
+  std::shared_ptr<Record> recordPtr_;
+};
+
 class Exp0 : public testing::Test {
  protected:
   static constexpr size_t STATE_DIM = 2;
@@ -295,6 +369,295 @@ TEST_F(Exp0, ddp_hamiltonian) {
   EXPECT_FALSE(dHdu3.isZero(precision)) << "MESSAGE for test 3: Derivative of Hamiltonian w.r.t. to u is zero: " << dHdu3.transpose();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_interrupt) {
+  // ddp settings
+  constexpr size_t numThreads = 2;
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // the reported performance index has to belong to the returned primal solution
+  auto evaluationProblem = problem;
+  evaluationProblem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+  auto checkPerformanceIndex = [&](const ocs2::PrimalSolution& primalSolution) {
+    ocs2::MetricsCollection metrics;
+    ocs2::computeRolloutMetrics(evaluationProblem, primalSolution, metrics);
+    const auto performanceIndex = ocs2::computeRolloutPerformanceIndex(primalSolution.timeTrajectory_, metrics);
+    EXPECT_NEAR(performanceIndex.cost, ddp.getPerformanceIndeces().cost, 1e-9);
+  };
+
+  // a request before run is discarded
+  ddp.requestInterrupt();
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getInterruptStatus(), ocs2::InterruptStatus::NONE);
+  const auto optimalCost = ddp.getPerformanceIndeces().cost;
+
+  // cold start with a passed deadline: the solver still needs one iteration to provide a policy
+  ddp.reset();
+  ddp.setDeadline(std::chrono::steady_clock::now());
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getInterruptStatus(), ocs2::InterruptStatus::DEADLINE);
+  EXPECT_EQ(ddp.getNumIterations(), size_t(1));
+  auto solution = ddp.primalSolution(finalTime);
+  ASSERT_FALSE(solution.controllerPtr_->empty());
+  EXPECT_DOUBLE_EQ(solution.timeTrajectory_.back(), finalTime);
+  checkPerformanceIndex(solution);
+
+  // warm start with a passed deadline: the warm-start iterate is returned without any further iteration
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getInterruptStatus(), ocs2::InterruptStatus::DEADLINE);
+  EXPECT_EQ(ddp.getNumIterations(), size_t(2));
+  solution = ddp.primalSolution(finalTime);
+  ASSERT_FALSE(solution.controllerPtr_->empty());
+  EXPECT_DOUBLE_EQ(solution.timeTrajectory_.back(), finalTime);
+  EXPECT_GE(ddp.getPerformanceIndeces().cost, optimalCost - 10 * ddpSettings.minRelCost_);
+  checkPerformanceIndex(solution);
+
+  // after clearing the deadline, the solver converges to the optimal solution
+  ddp.clearDeadline();
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getInterruptStatus(), ocs2::InterruptStatus::NONE);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_reset_rollouts) {
+  // ddp settings
+  constexpr size_t numThreads = 2;
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // dynamics and rollout with the step-size warm start
+  auto settings = rolloutSettings();
+  settings.useStepSizeWarmStart = true;
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout timeTriggeredRollout(systemDynamics, settings);
+  auto recordPtr = std::make_shared<RecordingRollout::Record>();
+  RecordingRollout rollout(timeTriggeredRollout, recordPtr);
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // the warm start is kept across runs and it is cleared for each rollout of the solver on reset
+  ddp.run(startTime, initState, finalTime);
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(recordPtr->numResets, 0);
+  ddp.reset();
+  EXPECT_EQ(recordPtr->numResets, numThreads);
+
+  // the solver converges to the same solution after the reset
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_shared_thread_pool) {
+  // ddp settings: each solver requests more parallel tasks than the shared pool has threads
+  constexpr size_t numThreads = 3;
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+  auto threadPoolPtr = std::make_shared<ocs2::ThreadPool>(1);
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // an independent copy of the problem for the second solver
+  const auto& modeSchedule = referenceManagerPtr->getModeSchedule();
+  auto otherReferenceManagerPtr = ocs2::getExp0ReferenceManager(modeSchedule.eventTimes, modeSchedule.modeSequence);
+  const auto otherProblem = ocs2::createExp0Problem(otherReferenceManagerPtr);
+  ocs2::EXP0_System otherSystemDynamics(otherReferenceManagerPtr);
+  ocs2::TimeTriggeredRollout otherRollout(otherSystemDynamics, rolloutSettings());
+
+  // instantiate two solvers which share the pool
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr, threadPoolPtr);
+  ocs2::SLQ otherDdp(ddpSettings, otherRollout, otherProblem, *initializerPtr, threadPoolPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  otherDdp.setReferenceManager(otherReferenceManagerPtr);
+
+  // run the solvers concurrently
+  std::thread otherThread([&]() { otherDdp.run(startTime, initState, finalTime); });
+  ddp.run(startTime, initState, finalTime);
+  otherThread.join();
+
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  performanceIndexTest(ddpSettings, otherDdp.getPerformanceIndeces());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_partitioned_rollout) {
+  // ddp settings
+  constexpr size_t numThreads = 4;
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, numThreads, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT);
+  ddpSettings.partitionedRollout_ = true;
+  ddpSettings.partitionedRolloutDefectTolerance_ = 1e-6;
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // run ddp, the second run starts the initial rollout from the cached trajectories of the first one
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+
+  // the stitched trajectories are consistent with a sequential rollout of the same policy
+  const auto solution = ddp.primalSolution(finalTime);
+  EXPECT_TRUE(std::is_sorted(solution.timeTrajectory_.begin(), solution.timeTrajectory_.end()));
+  EXPECT_DOUBLE_EQ(solution.timeTrajectory_.back(), finalTime);
+  ASSERT_EQ(solution.postEventIndices_.size(), 1);
+  EXPECT_NEAR(solution.timeTrajectory_[solution.postEventIndices_.front()], referenceManagerPtr->getModeSchedule().eventTimes.front(),
+              1e-6);
+
+  ocs2::PrimalSolution sequentialSolution;
+  sequentialSolution.modeSchedule_ = solution.modeSchedule_;
+  sequentialSolution.controllerPtr_.reset(solution.controllerPtr_->clone());
+  ocs2::rolloutTrajectory(rollout, startTime, initState, finalTime, sequentialSolution);
+  EXPECT_TRUE(solution.stateTrajectory_.back().isApprox(sequentialSolution.stateTrajectory_.back(), 1e-4));
+
+  // a perturbation of the policy is propagated through the linearized closed loop, such that few partitions are re-integrated
+  std::vector<std::unique_ptr<CountingRollout>> countingRolloutPtrs;
+  std::vector<std::reference_wrapper<ocs2::RolloutBase>> rolloutRefStock;
+  std::vector<ocs2::OptimalControlProblem> problemStock(numThreads, problem);
+  std::vector<std::reference_wrapper<ocs2::OptimalControlProblem>> problemRefStock;
+  for (size_t i = 0; i < numThreads; i++) {
+    countingRolloutPtrs.emplace_back(new CountingRollout(rollout));
+    rolloutRefStock.emplace_back(*countingRolloutPtrs.back());
+    problemRefStock.emplace_back(problemStock[i]);
+  }
+  ocs2::ThreadPool threadPool(numThreads - 1);
+
+  std::unique_ptr<ocs2::LinearController> perturbedControllerPtr(static_cast<ocs2::LinearController*>(solution.controllerPtr_->clone()));
+  for (auto& bias : perturbedControllerPtr->biasArray_) {
+    bias.array() += 1e-3;
+  }
+  ocs2::PrimalSolution partitionedSolution;
+  partitionedSolution.modeSchedule_ = solution.modeSchedule_;
+  partitionedSolution.controllerPtr_.reset(perturbedControllerPtr->clone());
+  ocs2::rolloutTrajectory(threadPool, rolloutRefStock, problemRefStock, solution, ddpSettings.partitionedRolloutDefectTolerance_,
+                          startTime, initState, finalTime, partitionedSolution);
+  sequentialSolution.controllerPtr_.reset(perturbedControllerPtr->clone());
+  ocs2::rolloutTrajectory(rollout, startTime, initState, finalTime, sequentialSolution);
+
+  size_t numPartitions = 0;
+  size_t numRuns = 0;
+  for (const auto& countingRolloutPtr : countingRolloutPtrs) {
+    numPartitions += (countingRolloutPtr->numRuns > 0) ? 1 : 0;
+    numRuns += countingRolloutPtr->numRuns;
+  }
+  const size_t numReintegrations = numRuns - numPartitions;
+  EXPECT_GT(numPartitions, 1);
+  EXPECT_LT(numReintegrations, numPartitions);
+  EXPECT_TRUE(partitionedSolution.stateTrajectory_.back().isApprox(sequentialSolution.stateTrajectory_.back(), 1e-5));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_reuse_time_grid) {
+  constexpr size_t maxNumTimeGridNodes = 60;
+  for (const auto strategy : {ocs2::search_strategy::Type::LINE_SEARCH, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT}) {
+    // ddp settings
+    const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, strategy);
+    const auto testName = getTestName(ddpSettings);
+
+    // dynamics and rollout
+    auto settings = rolloutSettings();
+    settings.reuseTimeGrid = true;
+    settings.maxNumTimeGridNodes = maxNumTimeGridNodes;
+    ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout timeTriggeredRollout(systemDynamics, settings);
+    auto recordPtr = std::make_shared<RecordingRollout::Record>();
+    RecordingRollout rollout(timeTriggeredRollout, recordPtr);
+
+    // instantiate
+    ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+
+    // the first run starts from the operating trajectories, hence its first search is adaptive and exceeds the node budget
+    ddp.run(startTime, initState, finalTime);
+    const auto& numNodes = recordPtr->numNodes;
+    EXPECT_GT(*std::max_element(numNodes.begin(), numNodes.end()), maxNumTimeGridNodes) << "MESSAGE: " << testName;
+    EXPECT_LE(numNodes.back(), maxNumTimeGridNodes) << "MESSAGE: " << testName;
+
+    // the second run starts from the time grid of the first one, hence all of its rollouts stay within the node budget
+    recordPtr->numNodes.clear();
+    ddp.run(startTime, initState, finalTime);
+    ASSERT_GT(numNodes.size(), 1) << "MESSAGE: " << testName;
+    EXPECT_LE(*std::max_element(numNodes.begin(), numNodes.end()), maxNumTimeGridNodes) << "MESSAGE: " << testName;
+
+    // the cost on the coarse time grid is less accurate, hence the policy is evaluated with an adaptive rollout. The policy is slightly
+    // suboptimal since it is designed on the coarse grid as well.
+    const auto solution = ddp.primalSolution(finalTime);
+    EXPECT_LE(solution.timeTrajectory_.size(), maxNumTimeGridNodes) << "MESSAGE: " << testName;
+    ocs2::PrimalSolution adaptiveSolution;
+    adaptiveSolution.modeSchedule_ = solution.modeSchedule_;
+    adaptiveSolution.controllerPtr_.reset(solution.controllerPtr_->clone());
+    ocs2::TimeTriggeredRollout adaptiveRollout(systemDynamics, rolloutSettings());
+    ocs2::rolloutTrajectory(adaptiveRollout, startTime, initState, finalTime, adaptiveSolution);
+
+    auto evaluationProblem = problem;
+    evaluationProblem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+    ocs2::MetricsCollection metrics;
+    ocs2::computeRolloutMetrics(evaluationProblem, adaptiveSolution, metrics);
+    const auto performanceIndex = ocs2::computeRolloutPerformanceIndex(adaptiveSolution.timeTrajectory_, metrics);
+    EXPECT_NEAR(performanceIndex.cost, expectedCost, 0.01 * expectedCost) << "MESSAGE: " << testName;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ddp_event_times_derivatives) {
+  // ddp settings
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 2, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.minRelCost_ = 1e-9;
+  ddpSettings.maxNumIterations_ = 50;
+
+  // the optimal cost for the given event time and its derivative
+  auto solve = [&](ocs2::scalar_t eventTime) {
+    auto referenceManagerPtr = ocs2::getExp0ReferenceManager({eventTime}, {0, 1});
+    auto problem = ocs2::createExp0Problem(referenceManagerPtr);
+    ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+    ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+    ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(startTime, initState, finalTime);
+    const auto eventTimesDerivatives = ddp.getEventTimesDerivatives();
+    EXPECT_EQ(eventTimesDerivatives.size(), 1);
+    return std::make_pair(ddp.getPerformanceIndeces().cost, eventTimesDerivatives.front());
+  };
+
+  // the derivative matches the central finite difference of the optimal cost
+  constexpr ocs2::scalar_t eventTime = 0.5;
+  constexpr ocs2::scalar_t delta = 1e-2;
+  const auto derivative = solve(eventTime).second;
+  const auto finiteDifference = (solve(eventTime + delta).first - solve(eventTime - delta).first) / (2.0 * delta);
+  EXPECT_NEAR(derivative, finiteDifference, 1e-2 * std::abs(finiteDifference));
+
+  // the derivative vanishes at the optimal event time
+  EXPECT_NEAR(solve(0.1897).second, 0.0, 5e-2 * std::abs(finiteDifference));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
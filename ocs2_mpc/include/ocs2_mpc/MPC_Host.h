@@ -0,0 +1,166 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_mpc/MPC_MRT_Interface.h"
+
+namespace ocs2 {
+namespace mpc {
+
+/**
+ * The order in which the MPC host dispatches its instances. If a period budget is set, the instances at the end of the order are the ones
+ * which are deferred to the next period.
+ */
+enum class SchedulingPolicy {
+  FAIR_SHARE,  // the instance with the least accumulated solve time first, such that deferred instances are dispatched first next period
+  PRIORITY,    // the instance with the highest priority first, ties are resolved by FAIR_SHARE. Low priority instances may starve.
+};
+
+/** Returns the name of the scheduling policy. */
+std::string toString(SchedulingPolicy policy);
+
+/** Timing statistics of an MPC instance in the host. */
+struct InstanceMetrics {
+  size_t numRuns = 0;
+  size_t numDeadlineHits = 0;  // number of runs which were interrupted by the solver deadline
+  size_t numDeferrals = 0;     // number of periods in which the instance was not run because of the period budget
+  scalar_t totalTime = 0.0;    // accumulated wall time of the runs [s]
+  scalar_t maxTime = 0.0;      // the longest run [s]
+
+  scalar_t getAverageTime() const { return (numRuns > 0) ? totalTime / numRuns : 0.0; }
+};
+
+}  // namespace mpc
+
+/**
+ * This class hosts many MPC instances in one process. Instead of each solver owning a private thread pool, all solvers inject their
+ * parallel work into one worker pool owned by the host, while a fixed number of instance threads run the MPC iterations. This bounds the
+ * total number of threads to (numInstanceThreads + numWorkerThreads) independent of the number of instances.
+ *
+ * The solvers should be constructed with the shared worker pool (see getWorkerPool()), e.g.,
+ *   GaussNewtonDDP_MPC mpc(mpcSettings, ddpSettings, rollout, problem, initializer, host.getWorkerPool());
+ * Per-instance deadlines are set through mpc::Settings::solverTimeLimit_ of each MPC.
+ *
+ * Each call of advanceAll() is one period. Without a period budget, all the instances are run in every period and the scheduling policy
+ * only determines the order in which they start. With a period budget (see setPeriodBudget()), an instance is only started if its
+ * expected completion time, i.e., the time elapsed in the period plus its average run time, is within the budget. Otherwise it is
+ * deferred to the next period.
+ */
+class MPC_Host {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] numInstanceThreads: The maximum number of MPC instances that are solved concurrently (at least one).
+   * @param [in] numWorkerThreads: The number of threads in the worker pool shared by all the solvers.
+   * @param [in] policy: The policy which determines the order in which the instances are dispatched.
+   * @param [in] threadPriority: The priority of the instance and worker threads.
+   */
+  MPC_Host(size_t numInstanceThreads, size_t numWorkerThreads, mpc::SchedulingPolicy policy = mpc::SchedulingPolicy::FAIR_SHARE,
+           int threadPriority = 0);
+
+  /** Default destructor. */
+  ~MPC_Host() = default;
+
+  /** Gets the worker pool which should be shared by the solvers of the hosted instances. */
+  std::shared_ptr<ThreadPool> getWorkerPool() const { return workerPoolPtr_; }
+
+  /**
+   * Adds an MPC instance to the host. The instance is not owned by the host.
+   * @note addInstance() must not be called while advanceAll() is running.
+   *
+   * @param [in] mpcInterface: The MPC-MRT interface of the instance.
+   * @param [in] priority: The priority of the instance, used by SchedulingPolicy::PRIORITY (higher is more important).
+   * @return The index of the instance in the host.
+   */
+  size_t addInstance(MPC_MRT_Interface& mpcInterface, int priority = 0);
+
+  /**
+   * Sets the wall-time budget of each call of advanceAll(). The first instance in the dispatch order is always run, such that every
+   * period makes progress.
+   * @note setPeriodBudget() must not be called while advanceAll() is running.
+   *
+   * @param [in] periodBudget: The budget of a period [s]. A non-positive value disables the budget, i.e., all the instances are run.
+   */
+  void setPeriodBudget(scalar_t periodBudget) { periodBudget_ = periodBudget; }
+
+  /** Gets the number of hosted instances. */
+  size_t numInstances() const { return instances_.size(); }
+
+  /**
+   * Runs one period: an MPC iteration (MPC_MRT_Interface::advanceMpc) for every hosted instance which fits in the period budget on the
+   * instance threads. The instances are dispatched in the order given by the scheduling policy. This is a blocking call which returns
+   * when all the dispatched instances are done.
+   *
+   * @return The number of instances which were run, the others were deferred.
+   */
+  size_t advanceAll();
+
+  /** Gets the dispatch order of the instances in the last period. */
+  const std::vector<size_t>& getDispatchOrder() const { return dispatchOrder_; }
+
+  /** Gets the timing statistics of an instance. */
+  const mpc::InstanceMetrics& getMetrics(size_t index) const { return instances_.at(index).metrics; }
+
+  /** Gets the timing statistics aggregated over all instances. */
+  mpc::InstanceMetrics getAggregatedMetrics() const;
+
+  /** Gets the timing statistics as a string. */
+  std::string getBenchmarkingInformation() const;
+
+ private:
+  struct Instance {
+    MPC_MRT_Interface* interfacePtr;
+    int priority;
+    mpc::InstanceMetrics metrics;
+  };
+
+  /** Runs an MPC iteration of the given instance and records its statistics. */
+  void advanceInstance(Instance& instance);
+
+  const size_t numInstanceThreads_;
+  const mpc::SchedulingPolicy policy_;
+  scalar_t periodBudget_ = 0.0;
+
+  std::vector<Instance> instances_;
+  std::vector<size_t> dispatchOrder_;
+
+  ThreadPool instancePool_;
+  std::shared_ptr<ThreadPool> workerPoolPtr_;
+};
+
+}  // namespace ocs2
@@ -63,6 +63,11 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   void setCurrentObservation(const SystemObservation& currentObservation) override;
 
+  /**
+   * Gets the underlying MPC.
+   */
+  const MPC_BASE& getMpc() const { return mpc_; }
+
   /*
    * Gets the ReferenceManager which manages both ModeSchedule and TargetTrajectories.
    */
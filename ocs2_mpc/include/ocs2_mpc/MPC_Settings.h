@@ -49,6 +49,12 @@ struct Settings {
    * */
   scalar_t solutionTimeWindow_ = -1;
 
+  /**
+   * The maximum wall time in seconds for each solver call. When it is exceeded, the solver is interrupted and the best iterate found
+   * so far is used as the MPC solution. Any non-positive number will be interpreted as no time limit.
+   */
+  scalar_t solverTimeLimit_ = -1;
+
   /** This value determines to display the log output of MPC. */
   bool debugPrint_ = false;
 
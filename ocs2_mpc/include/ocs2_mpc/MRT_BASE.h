@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_mpc/CommandData.h"
 #include "ocs2_mpc/MrtObserver.h"
 #include "ocs2_mpc/SystemObservation.h"
+#include "ocs2_mpc/TabulatedPolicy.h"
 
 namespace ocs2 {
 
@@ -116,6 +117,15 @@ class MRT_BASE {
    */
   void initRollout(const RolloutBase* rolloutPtr);
 
+  /**
+   * @brief Enables the tabulated policy. On each policy update, the active policy is resampled on a uniform time grid such that
+   * evaluatePolicy() reduces to an index computation and a linear interpolation of precomputed tables. Policies which can not
+   * be tabulated (see TabulatedPolicy) are evaluated through the generic controller interface.
+   *
+   * @param [in] timeStep: The sampling period of the table, e.g., the period of the control loop.
+   */
+  void enableTabulatedPolicy(scalar_t timeStep);
+
   /**
    * @brief Evaluates the controller
    *
@@ -190,6 +200,7 @@ class MRT_BASE {
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  std::unique_ptr<TabulatedPolicy> tabulatedPolicyPtr_;
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
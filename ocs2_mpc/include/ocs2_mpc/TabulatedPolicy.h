@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+
+/**
+ * This class resamples the policy of a PrimalSolution on a time grid and stores the nominal state, the feedforward input, the feedback
+ * gains, and the active mode in dense contiguous tables. The grid is uniform except at the event times of the mode schedule, where
+ * the pre-event and the post-event values are sampled separately such that no value is interpolated across a mode switch. Evaluating
+ * the policy then reduces to an index computation and a linear interpolation between two neighbouring samples, without any search or
+ * memory allocation (as long as the output vectors have the correct size).
+ *
+ * The evaluation follows the conventions of the PrimalSolution: at an event time, the pre-event values and mode are returned.
+ *
+ * Only LinearController and FeedforwardController policies with constant state and input dimensions are tabulated. For other policies,
+ * the table remains empty.
+ */
+class TabulatedPolicy {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] timeStep: The sampling period of the table, e.g., the period of the control loop.
+   */
+  explicit TabulatedPolicy(scalar_t timeStep);
+
+  /**
+   * Resamples the policy of the given primal solution. The memory of the tables is reused if the number of samples does not grow.
+   *
+   * @param [in] primalSolution: The primal solution which contains the policy.
+   */
+  void update(const PrimalSolution& primalSolution);
+
+  /** Clears the tables. */
+  void clear();
+
+  /** Whether the table contains a policy. */
+  bool empty() const { return sampleTimes_.empty(); }
+
+  /** Gets the sampling period of the table. */
+  scalar_t getTimeStep() const { return timeStep_; }
+
+  /** Gets the sample times of the table. At an event time, the pre-event and the post-event samples have the same time. */
+  const scalar_array_t& getSampleTimes() const { return sampleTimes_; }
+
+  /**
+   * Evaluates the tabulated policy. The query time is clamped to the time interval of the table.
+   *
+   * @param [in] time: The query time.
+   * @param [in] state: The query state.
+   * @param [out] mpcState: The nominal state of the policy.
+   * @param [out] mpcInput: The input of the policy.
+   * @param [out] mode: The active mode.
+   */
+  void evaluate(scalar_t time, const vector_t& state, vector_t& mpcState, vector_t& mpcInput, size_t& mode) const;
+
+ private:
+  const scalar_t timeStep_;
+
+  int stateDim_ = 0;
+  int inputDim_ = 0;
+  bool hasFeedbackGain_ = false;
+  scalar_t startTime_ = 0.0;
+  scalar_t finalTime_ = 0.0;
+
+  scalar_array_t sampleTimes_;       // numSamples
+  std::vector<size_t> modeTable_;    // numSamples - 1: the active mode of each cell between two consecutive samples
+  std::vector<int> firstCellIndex_;  // the index of the cell which contains the start of each uniform interval of length timeStep
+
+  matrix_t stateTable_;        // stateDim x numSamples
+  matrix_t feedforwardTable_;  // inputDim x numSamples
+  matrix_t gainTable_;         // inputDim x (stateDim * numSamples)
+};
+
+}  // namespace ocs2
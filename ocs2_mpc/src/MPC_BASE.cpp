@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <algorithm>
+#include <chrono>
 
 #include <ocs2_mpc/MPC_BASE.h>
 
@@ -71,6 +72,13 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     mpcTimer_.startTimer();
   }
 
+  // set the solver deadline
+  if (mpcSettings_.solverTimeLimit_ > 0.0) {
+    const auto timeLimit = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<scalar_t>(mpcSettings_.solverTimeLimit_));
+    getSolverPtr()->setDeadline(std::chrono::steady_clock::now() + timeLimit);
+  }
+
   // calculate the MPC policy
   calculateController(currentTime, currentState, finalTime);
 
@@ -0,0 +1,167 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_Host.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace mpc {
+
+std::string toString(SchedulingPolicy policy) {
+  switch (policy) {
+    case SchedulingPolicy::FAIR_SHARE:
+      return "FAIR_SHARE";
+    case SchedulingPolicy::PRIORITY:
+      return "PRIORITY";
+    default:
+      throw std::runtime_error("[mpc::toString] Undefined SchedulingPolicy!");
+  }
+}
+
+}  // namespace mpc
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_Host::MPC_Host(size_t numInstanceThreads, size_t numWorkerThreads, mpc::SchedulingPolicy policy, int threadPriority)
+    : numInstanceThreads_(std::max(numInstanceThreads, size_t(1))),
+      policy_(policy),
+      instancePool_(numInstanceThreads_ - 1, threadPriority),  // the calling thread is also an instance thread
+      workerPoolPtr_(std::make_shared<ThreadPool>(numWorkerThreads, threadPriority)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MPC_Host::addInstance(MPC_MRT_Interface& mpcInterface, int priority) {
+  instances_.push_back(Instance{&mpcInterface, priority, mpc::InstanceMetrics()});
+  dispatchOrder_.push_back(dispatchOrder_.size());
+  return instances_.size() - 1;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MPC_Host::advanceAll() {
+  // dispatch order
+  const auto lessServed = [&](size_t i, size_t j) { return instances_[i].metrics.totalTime < instances_[j].metrics.totalTime; };
+  switch (policy_) {
+    case mpc::SchedulingPolicy::FAIR_SHARE:
+      std::stable_sort(dispatchOrder_.begin(), dispatchOrder_.end(), lessServed);
+      break;
+    case mpc::SchedulingPolicy::PRIORITY:
+      std::stable_sort(dispatchOrder_.begin(), dispatchOrder_.end(), [&](size_t i, size_t j) {
+        return (instances_[i].priority != instances_[j].priority) ? instances_[i].priority > instances_[j].priority : lessServed(i, j);
+      });
+      break;
+  }
+
+  // each instance thread takes the next instance in the dispatch order and defers it if it does not fit in the period budget
+  const auto periodStartTime = std::chrono::steady_clock::now();
+  std::atomic_size_t nextInstance{0};
+  std::atomic_size_t numAdvancedInstances{0};
+  auto task = [&](int) {
+    size_t k;
+    while ((k = nextInstance++) < dispatchOrder_.size()) {
+      auto& instance = instances_[dispatchOrder_[k]];
+      if (k > 0 && periodBudget_ > 0.0) {
+        const scalar_t elapsedTime = std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - periodStartTime).count();
+        if (elapsedTime + instance.metrics.getAverageTime() > periodBudget_) {
+          instance.metrics.numDeferrals++;
+          continue;
+        }
+      }
+      advanceInstance(instance);
+      numAdvancedInstances++;
+    }
+  };
+  instancePool_.runParallel(task, std::min(numInstanceThreads_, instances_.size()));
+
+  return numAdvancedInstances;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Host::advanceInstance(Instance& instance) {
+  const auto startTime = std::chrono::steady_clock::now();
+  instance.interfacePtr->advanceMpc();
+  const auto endTime = std::chrono::steady_clock::now();
+
+  const scalar_t runTime = std::chrono::duration<scalar_t>(endTime - startTime).count();
+  auto& metrics = instance.metrics;
+  metrics.numRuns++;
+  metrics.totalTime += runTime;
+  metrics.maxTime = std::max(metrics.maxTime, runTime);
+  if (instance.interfacePtr->getMpc().getSolverPtr()->getInterruptStatus() == InterruptStatus::DEADLINE) {
+    metrics.numDeadlineHits++;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+mpc::InstanceMetrics MPC_Host::getAggregatedMetrics() const {
+  mpc::InstanceMetrics aggregated;
+  for (const auto& instance : instances_) {
+    aggregated.numRuns += instance.metrics.numRuns;
+    aggregated.numDeadlineHits += instance.metrics.numDeadlineHits;
+    aggregated.numDeferrals += instance.metrics.numDeferrals;
+    aggregated.totalTime += instance.metrics.totalTime;
+    aggregated.maxTime = std::max(aggregated.maxTime, instance.metrics.maxTime);
+  }
+  return aggregated;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string MPC_Host::getBenchmarkingInformation() const {
+  std::stringstream infoStream;
+  infoStream << "\n########################################################################\n";
+  infoStream << "The MPC host benchmarking (" << mpc::toString(policy_) << ", " << numInstanceThreads_ << " instance threads, "
+             << workerPoolPtr_->numThreads() << " worker threads, period budget " << 1e3 * periodBudget_ << " [ms]):\n";
+  for (size_t i = 0; i < instances_.size(); i++) {
+    const auto& metrics = instances_[i].metrics;
+    infoStream << "\tInstance " << i << " (priority " << instances_[i].priority << "): runs " << metrics.numRuns << ", average "
+               << 1e3 * metrics.getAverageTime() << " [ms], maximum " << 1e3 * metrics.maxTime << " [ms], deadline hits "
+               << metrics.numDeadlineHits << ", deferrals " << metrics.numDeferrals << "\n";
+  }
+  const auto aggregated = getAggregatedMetrics();
+  infoStream << "\tTotal: runs " << aggregated.numRuns << ", average " << 1e3 * aggregated.getAverageTime() << " [ms], maximum "
+             << 1e3 * aggregated.maxTime << " [ms], deadline hits " << aggregated.numDeadlineHits << ", deferrals "
+             << aggregated.numDeferrals << "\n";
+  return infoStream.str();
+}
+
+}  // namespace ocs2
@@ -56,6 +56,10 @@ void MRT_BASE::reset() {
   bufferPrimalSolutionPtr_.reset();
   activePerformanceIndicesPtr_.reset();
   bufferPerformanceIndicesPtr_.reset();
+
+  if (tabulatedPolicyPtr_ != nullptr) {
+    tabulatedPolicyPtr_->clear();
+  }
 }
 
 /******************************************************************************************************/
@@ -98,6 +102,16 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
   rolloutPtr_.reset(rolloutPtr->clone());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::enableTabulatedPolicy(scalar_t timeStep) {
+  tabulatedPolicyPtr_.reset(new TabulatedPolicy(timeStep));
+  if (activePrimalSolutionPtr_ != nullptr) {
+    tabulatedPolicyPtr_->update(*activePrimalSolutionPtr_);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -111,6 +125,11 @@ void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState
               << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
   }
 
+  if (tabulatedPolicyPtr_ != nullptr && !tabulatedPolicyPtr_->empty()) {
+    tabulatedPolicyPtr_->evaluate(currentTime, currentState, mpcState, mpcInput, mode);
+    return;
+  }
+
   mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
   mpcState =
       LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
@@ -165,6 +184,9 @@ bool MRT_BASE::updatePolicy() {
       newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
 
       modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
+      if (tabulatedPolicyPtr_ != nullptr) {
+        tabulatedPolicyPtr_->update(*activePrimalSolutionPtr_);
+      }
       return true;
     } else {
       return false;  // No policy update: the buffer contains nothing new.
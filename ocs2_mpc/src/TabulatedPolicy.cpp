@@ -0,0 +1,204 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/TabulatedPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TabulatedPolicy::TabulatedPolicy(scalar_t timeStep) : timeStep_(timeStep) {
+  if (timeStep_ <= 0.0) {
+    throw std::runtime_error("[TabulatedPolicy] timeStep should be positive!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TabulatedPolicy::update(const PrimalSolution& primalSolution) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = primalSolution.stateTrajectory_;
+  const auto& inputTrajectory = primalSolution.inputTrajectory_;
+  auto* controllerPtr = primalSolution.controllerPtr_.get();
+
+  if (timeTrajectory.empty() || controllerPtr == nullptr || controllerPtr->empty()) {
+    clear();
+    return;
+  }
+
+  // supported policies
+  const auto controllerType = controllerPtr->getType();
+  if (controllerType != ControllerType::LINEAR && controllerType != ControllerType::FEEDFORWARD) {
+    clear();
+    return;
+  }
+
+  // dimensions should be constant over the horizon
+  const int stateDim = stateTrajectory.front().size();
+  const int inputDim = inputTrajectory.front().size();
+  const bool hasConstantStateDim =
+      std::all_of(stateTrajectory.cbegin(), stateTrajectory.cend(), [&](const vector_t& x) { return x.size() == stateDim; });
+  const bool hasConstantInputDim =
+      std::all_of(inputTrajectory.cbegin(), inputTrajectory.cend(), [&](const vector_t& u) { return u.size() == inputDim; });
+  if (!hasConstantStateDim || !hasConstantInputDim) {
+    clear();
+    return;
+  }
+
+  startTime_ = timeTrajectory.front();
+  finalTime_ = timeTrajectory.back();
+  stateDim_ = stateDim;
+  inputDim_ = inputDim;
+  hasFeedbackGain_ = (controllerType == ControllerType::LINEAR);
+
+  // uniform samples from the initial time where the last one is clamped to the final time. The event times within the horizon
+  // break the grid and they are sampled twice: once for the pre-event and once for the post-event values.
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+  auto eventTimeItr = std::upper_bound(modeSchedule.eventTimes.cbegin(), modeSchedule.eventTimes.cend(), startTime_);
+  const int numIntervals = std::max(static_cast<int>(std::ceil((finalTime_ - startTime_) / timeStep_)), 1);
+  sampleTimes_.clear();
+  sampleTimes_.push_back(startTime_);
+  for (int k = 1; k <= numIntervals; k++) {
+    const scalar_t gridTime = std::min(startTime_ + k * timeStep_, finalTime_);
+    for (; eventTimeItr != modeSchedule.eventTimes.cend() && *eventTimeItr <= gridTime && *eventTimeItr < finalTime_; ++eventTimeItr) {
+      sampleTimes_.push_back(*eventTimeItr);
+      sampleTimes_.push_back(*eventTimeItr);
+    }
+    if (gridTime > sampleTimes_.back()) {
+      sampleTimes_.push_back(gridTime);
+    }
+  }
+  if (sampleTimes_.size() < 2) {
+    sampleTimes_.push_back(finalTime_);
+  }
+  const int numSamples = sampleTimes_.size();
+  const int numCells = numSamples - 1;
+
+  // the active mode of each cell
+  modeTable_.resize(numCells);
+  for (int j = 0; j < numCells; j++) {
+    modeTable_[j] = modeSchedule.modeAtTime(0.5 * (sampleTimes_[j] + sampleTimes_[j + 1]));
+  }
+
+  // the first cell of each uniform interval
+  firstCellIndex_.resize(numIntervals);
+  int cellIndex = 0;
+  for (int k = 0; k < numIntervals; k++) {
+    const scalar_t intervalStartTime = startTime_ + k * timeStep_;
+    while (cellIndex < numCells - 1 && intervalStartTime > sampleTimes_[cellIndex + 1]) {
+      cellIndex++;
+    }
+    firstCellIndex_[k] = cellIndex;
+  }
+
+  stateTable_.resize(stateDim_, numSamples);
+  feedforwardTable_.resize(inputDim_, numSamples);
+  if (hasFeedbackGain_) {
+    gainTable_.resize(inputDim_, stateDim_ * numSamples);
+  }
+
+  vector_t bias;
+  matrix_t gain;
+  for (int j = 0; j < numSamples; j++) {
+    // the trajectories select the pre-event values at an event time, the post-event samples are evaluated right after it
+    const bool isPostEventSample = (j > 0 && sampleTimes_[j] == sampleTimes_[j - 1]);
+    const scalar_t time = isPostEventSample ? std::nextafter(sampleTimes_[j], finalTime_) : sampleTimes_[j];
+    stateTable_.col(j) = LinearInterpolation::interpolate(time, timeTrajectory, stateTrajectory);
+
+    if (hasFeedbackGain_) {
+      const auto& linearController = static_cast<const LinearController&>(*controllerPtr);
+      linearController.getBias(time, bias);
+      linearController.getFeedbackGain(time, gain);
+      feedforwardTable_.col(j) = bias;
+      gainTable_.middleCols(j * stateDim_, stateDim_) = gain;
+    } else {
+      feedforwardTable_.col(j) = controllerPtr->computeInput(time, stateTable_.col(j));
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TabulatedPolicy::clear() {
+  stateDim_ = 0;
+  inputDim_ = 0;
+  hasFeedbackGain_ = false;
+  sampleTimes_.clear();
+  modeTable_.clear();
+  firstCellIndex_.clear();
+  stateTable_.resize(0, 0);
+  feedforwardTable_.resize(0, 0);
+  gainTable_.resize(0, 0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TabulatedPolicy::evaluate(scalar_t time, const vector_t& state, vector_t& mpcState, vector_t& mpcInput, size_t& mode) const {
+  if (empty()) {
+    throw std::runtime_error("[TabulatedPolicy::evaluate] The table is empty!");
+  }
+
+  // index of the cell. The uniform interval gives the first candidate, the following cells are only visited at the event times.
+  const scalar_t clampedTime = std::min(std::max(time, startTime_), finalTime_);
+  const int numIntervals = firstCellIndex_.size();
+  const int numCells = sampleTimes_.size() - 1;
+  const int intervalIndex = std::min(static_cast<int>((clampedTime - startTime_) / timeStep_), numIntervals - 1);
+  int index = firstCellIndex_[intervalIndex];
+  while (index > 0 && clampedTime <= sampleTimes_[index]) {
+    index--;
+  }
+  while (index < numCells - 1 && clampedTime > sampleTimes_[index + 1]) {
+    index++;
+  }
+
+  const scalar_t cellDuration = sampleTimes_[index + 1] - sampleTimes_[index];
+  const scalar_t alpha = (cellDuration > 0.0) ? (clampedTime - sampleTimes_[index]) / cellDuration : 0.0;
+  const scalar_t beta = 1.0 - alpha;
+
+  mpcState = beta * stateTable_.col(index) + alpha * stateTable_.col(index + 1);
+  mpcInput = beta * feedforwardTable_.col(index) + alpha * feedforwardTable_.col(index + 1);
+  if (hasFeedbackGain_) {
+    mpcInput.noalias() += beta * gainTable_.middleCols(index * stateDim_, stateDim_) * state;
+    mpcInput.noalias() += alpha * gainTable_.middleCols((index + 1) * stateDim_, stateDim_) * state;
+  }
+
+  mode = modeTable_[index];
+}
+
+}  // namespace ocs2
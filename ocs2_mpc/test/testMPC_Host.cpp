@@ -0,0 +1,220 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/MPC_Host.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Records the order in which the dummy solvers are run. */
+class RunLog {
+ public:
+  void push_back(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ids_.push_back(id);
+  }
+  std::vector<size_t> getAndClear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<size_t> ids;
+    ids.swap(ids_);
+    return ids;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<size_t> ids_;
+};
+
+/** A solver which sleeps for a fixed time and returns a constant policy. */
+class DummySolver final : public SolverBase {
+ public:
+  DummySolver(size_t id, scalar_t runTime, RunLog& runLog) : id_(id), runTime_(runTime), runLog_(runLog) {}
+  ~DummySolver() override = default;
+
+  void reset() override {}
+  const PerformanceIndex& getPerformanceIndeces() const override { return performanceIndex_; }
+  size_t getNumIterations() const override { return 1; }
+  const std::vector<PerformanceIndex>& getIterationsLog() const override { return iterationsLog_; }
+  scalar_t getFinalTime() const override { return finalTime_; }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override {
+    primalSolutionPtr->clear();
+    primalSolutionPtr->timeTrajectory_ = {initTime_, finalTime};
+    primalSolutionPtr->stateTrajectory_ = {vector_t::Zero(1), vector_t::Zero(1)};
+    primalSolutionPtr->inputTrajectory_ = {vector_t::Zero(1), vector_t::Zero(1)};
+    primalSolutionPtr->controllerPtr_.reset(
+        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+  }
+  ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override { return {}; }
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override { return {}; }
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override { return {}; }
+
+ private:
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    runLog_.push_back(id_);
+    initTime_ = initTime;
+    finalTime_ = finalTime;
+    std::this_thread::sleep_for(std::chrono::duration<scalar_t>(runTime_));
+  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase*) override {
+    runImpl(initTime, initState, finalTime);
+  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution&) override {
+    runImpl(initTime, initState, finalTime);
+  }
+
+  const size_t id_;
+  const scalar_t runTime_;
+  RunLog& runLog_;
+  scalar_t initTime_ = 0.0;
+  scalar_t finalTime_ = 0.0;
+  PerformanceIndex performanceIndex_;
+  std::vector<PerformanceIndex> iterationsLog_;
+};
+
+/** An MPC around the dummy solver. */
+class DummyMpc final : public MPC_BASE {
+ public:
+  DummyMpc(size_t id, scalar_t runTime, RunLog& runLog) : MPC_BASE(getSettings()), solver_(id, runTime, runLog) {}
+  ~DummyMpc() override = default;
+
+  DummySolver* getSolverPtr() override { return &solver_; }
+  const DummySolver* getSolverPtr() const override { return &solver_; }
+
+ private:
+  static mpc::Settings getSettings() {
+    mpc::Settings settings;
+    settings.timeHorizon_ = 1.0;
+    return settings;
+  }
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    solver_.run(initTime, initState, finalTime);
+  }
+
+  DummySolver solver_;
+};
+
+class MPC_HostTest : public testing::Test {
+ protected:
+  /** Adds instances with the given run times [s] and priorities to the host. */
+  void addInstances(MPC_Host& host, const scalar_array_t& runTimes, const std::vector<int>& priorities) {
+    for (size_t i = 0; i < runTimes.size(); i++) {
+      mpcPtrs_.emplace_back(new DummyMpc(i, runTimes[i], runLog_));
+      interfacePtrs_.emplace_back(new MPC_MRT_Interface(*mpcPtrs_.back()));
+      SystemObservation observation;
+      observation.state = vector_t::Zero(1);
+      observation.input = vector_t::Zero(1);
+      interfacePtrs_.back()->setCurrentObservation(observation);
+      EXPECT_EQ(host.addInstance(*interfacePtrs_.back(), priorities[i]), i);
+    }
+  }
+
+  RunLog runLog_;
+  std::vector<std::unique_ptr<DummyMpc>> mpcPtrs_;
+  std::vector<std::unique_ptr<MPC_MRT_Interface>> interfacePtrs_;
+};
+
+}  // unnamed namespace
+
+TEST_F(MPC_HostTest, priorityOrder) {
+  MPC_Host host(1, 1, mpc::SchedulingPolicy::PRIORITY);
+  addInstances(host, {0.001, 0.001, 0.001}, {0, 2, 1});
+
+  for (size_t period = 0; period < 3; period++) {
+    EXPECT_EQ(host.advanceAll(), 3);
+    EXPECT_EQ(runLog_.getAndClear(), std::vector<size_t>({1, 2, 0}));
+  }
+
+  for (size_t i = 0; i < host.numInstances(); i++) {
+    EXPECT_EQ(host.getMetrics(i).numRuns, 3);
+    EXPECT_EQ(host.getMetrics(i).numDeferrals, 0);
+    EXPECT_GE(host.getMetrics(i).maxTime, 0.001);
+    EXPECT_TRUE(interfacePtrs_[i]->updatePolicy());
+  }
+  EXPECT_EQ(host.getAggregatedMetrics().numRuns, 9);
+}
+
+TEST_F(MPC_HostTest, fairShareOrder) {
+  MPC_Host host(1, 1, mpc::SchedulingPolicy::FAIR_SHARE);
+  addInstances(host, {0.006, 0.002, 0.004}, {0, 0, 0});
+
+  // no statistics in the first period: the order of addition
+  EXPECT_EQ(host.advanceAll(), 3);
+  EXPECT_EQ(runLog_.getAndClear(), std::vector<size_t>({0, 1, 2}));
+
+  // the least served instance first
+  EXPECT_EQ(host.advanceAll(), 3);
+  EXPECT_EQ(runLog_.getAndClear(), std::vector<size_t>({1, 2, 0}));
+  EXPECT_EQ(host.getDispatchOrder(), std::vector<size_t>({1, 2, 0}));
+
+  const auto aggregated = host.getAggregatedMetrics();
+  EXPECT_EQ(aggregated.numRuns, 6);
+  EXPECT_GE(aggregated.totalTime, 2.0 * (0.006 + 0.002 + 0.004));
+  EXPECT_GE(aggregated.maxTime, 0.006);
+}
+
+TEST_F(MPC_HostTest, periodBudget) {
+  MPC_Host host(1, 1, mpc::SchedulingPolicy::FAIR_SHARE);
+  addInstances(host, {0.03, 0.035, 0.04}, {0, 0, 0});
+
+  // collect the statistics
+  EXPECT_EQ(host.advanceAll(), 3);
+  runLog_.getAndClear();
+  host.setPeriodBudget(0.06);
+
+  // only one instance fits in the budget, the deferred instances are dispatched first in the next periods
+  EXPECT_EQ(host.advanceAll(), 1);
+  EXPECT_EQ(runLog_.getAndClear(), std::vector<size_t>({0}));
+  EXPECT_EQ(host.advanceAll(), 1);
+  EXPECT_EQ(runLog_.getAndClear(), std::vector<size_t>({1}));
+  EXPECT_EQ(host.advanceAll(), 1);
+  EXPECT_EQ(runLog_.getAndClear(), std::vector<size_t>({2}));
+
+  for (size_t i = 0; i < host.numInstances(); i++) {
+    EXPECT_EQ(host.getMetrics(i).numRuns, 2);
+    EXPECT_EQ(host.getMetrics(i).numDeferrals, 2);
+  }
+
+  // without a budget all the instances are run again
+  host.setPeriodBudget(0.0);
+  EXPECT_EQ(host.advanceAll(), 3);
+  EXPECT_EQ(host.getAggregatedMetrics().numDeferrals, 6);
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_mpc/TabulatedPolicy.h>
+
+using namespace ocs2;
+
+namespace {
+
+/**
+ * Creates a primal solution over [0.13, 1.37] with three mode switches inside the horizon. The state, the bias and the feedback gain
+ * are affine in time within each mode and they jump at the event times.
+ */
+PrimalSolution getPrimalSolutionWithEvents(bool isLinearPolicy) {
+  constexpr size_t nx = 3;
+  constexpr size_t nu = 2;
+  const scalar_t initTime = 0.13;
+  const scalar_t finalTime = 1.37;
+
+  PrimalSolution primalSolution;
+  primalSolution.modeSchedule_ = ModeSchedule({0.05, 0.5, 0.8333, 1.2, 2.0}, {0, 1, 2, 3, 4, 5});
+
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+  scalar_array_t modeBreaks{initTime, eventTimes[1], eventTimes[2], eventTimes[3], finalTime};
+
+  scalar_array_t timeTrajectory;
+  vector_array_t stateTrajectory, inputTrajectory, biasTrajectory;
+  matrix_array_t gainTrajectory;
+  for (size_t i = 0; i + 1 < modeBreaks.size(); i++) {
+    if (i > 0) {
+      primalSolution.postEventIndices_.push_back(timeTrajectory.size());
+    }
+    const auto mode = static_cast<scalar_t>(i + 1);
+    const int numNodes = std::ceil((modeBreaks[i + 1] - modeBreaks[i]) / 0.011) + 1;
+    for (int k = 0; k < numNodes; k++) {
+      const scalar_t t = modeBreaks[i] + k * (modeBreaks[i + 1] - modeBreaks[i]) / (numNodes - 1);
+      timeTrajectory.push_back(t);
+      stateTrajectory.push_back(vector_t::LinSpaced(nx, mode, -mode) * t + vector_t::Constant(nx, mode));
+      inputTrajectory.push_back(vector_t::Constant(nu, mode * t));
+      biasTrajectory.push_back(vector_t::LinSpaced(nu, 2.0 * mode, 1.0) * t - vector_t::Constant(nu, mode));
+      gainTrajectory.push_back(matrix_t::Constant(nu, nx, -mode * t) + matrix_t::Identity(nu, nx));
+    }
+  }
+
+  primalSolution.timeTrajectory_ = timeTrajectory;
+  primalSolution.stateTrajectory_ = stateTrajectory;
+  primalSolution.inputTrajectory_ = inputTrajectory;
+  if (isLinearPolicy) {
+    primalSolution.controllerPtr_.reset(new LinearController(timeTrajectory, biasTrajectory, gainTrajectory));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(timeTrajectory, inputTrajectory));
+  }
+  return primalSolution;
+}
+
+/** Compares the tabulated policy against the evaluation of the primal solution. */
+void checkAgainstPrimalSolution(const TabulatedPolicy& tabulatedPolicy, const PrimalSolution& primalSolution) {
+  const auto& eventTimes = primalSolution.modeSchedule_.eventTimes;
+  scalar_array_t queryTimes{eventTimes[1], eventTimes[2], eventTimes[3]};
+  for (scalar_t t = primalSolution.timeTrajectory_.front(); t <= primalSolution.timeTrajectory_.back(); t += 0.00731) {
+    queryTimes.push_back(t);
+  }
+  for (const auto t : eventTimes) {
+    queryTimes.push_back(t - 1e-6);
+    queryTimes.push_back(t + 1e-6);
+  }
+  queryTimes.push_back(primalSolution.timeTrajectory_.back());
+
+  const vector_t state = vector_t::LinSpaced(primalSolution.stateTrajectory_.front().size(), -1.0, 2.0);
+  vector_t mpcState, mpcInput;
+  size_t mode;
+  for (const auto t : queryTimes) {
+    if (t < primalSolution.timeTrajectory_.front() || t > primalSolution.timeTrajectory_.back()) {
+      continue;
+    }
+    tabulatedPolicy.evaluate(t, state, mpcState, mpcInput, mode);
+
+    const vector_t expectedState = LinearInterpolation::interpolate(t, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+    const vector_t expectedInput = primalSolution.controllerPtr_->computeInput(t, state);
+    EXPECT_TRUE(mpcState.isApprox(expectedState, 1e-8)) << "time: " << t;
+    EXPECT_TRUE(mpcInput.isApprox(expectedInput, 1e-8)) << "time: " << t;
+    EXPECT_EQ(mode, primalSolution.modeSchedule_.modeAtTime(t)) << "time: " << t;
+  }
+}
+
+}  // unnamed namespace
+
+TEST(testTabulatedPolicy, linearPolicy) {
+  const auto primalSolution = getPrimalSolutionWithEvents(true);
+  TabulatedPolicy tabulatedPolicy(0.05);
+  tabulatedPolicy.update(primalSolution);
+  ASSERT_FALSE(tabulatedPolicy.empty());
+
+  // every event time inside the horizon breaks the grid
+  const auto& sampleTimes = tabulatedPolicy.getSampleTimes();
+  for (size_t i = 1; i < 4; i++) {
+    const auto eventTime = primalSolution.modeSchedule_.eventTimes[i];
+    EXPECT_EQ(std::count(sampleTimes.cbegin(), sampleTimes.cend(), eventTime), 2);
+  }
+
+  checkAgainstPrimalSolution(tabulatedPolicy, primalSolution);
+}
+
+TEST(testTabulatedPolicy, feedforwardPolicy) {
+  const auto primalSolution = getPrimalSolutionWithEvents(false);
+  TabulatedPolicy tabulatedPolicy(0.05);
+  tabulatedPolicy.update(primalSolution);
+  ASSERT_FALSE(tabulatedPolicy.empty());
+
+  checkAgainstPrimalSolution(tabulatedPolicy, primalSolution);
+}
+
+TEST(testTabulatedPolicy, clampedQueryTime) {
+  const auto primalSolution = getPrimalSolutionWithEvents(true);
+  TabulatedPolicy tabulatedPolicy(0.05);
+  tabulatedPolicy.update(primalSolution);
+
+  const vector_t state = vector_t::Ones(3);
+  vector_t mpcState, mpcInput, boundaryState, boundaryInput;
+  size_t mode, boundaryMode;
+
+  tabulatedPolicy.evaluate(0.0, state, mpcState, mpcInput, mode);
+  tabulatedPolicy.evaluate(primalSolution.timeTrajectory_.front(), state, boundaryState, boundaryInput, boundaryMode);
+  EXPECT_TRUE(mpcState.isApprox(boundaryState));
+  EXPECT_TRUE(mpcInput.isApprox(boundaryInput));
+  EXPECT_EQ(mode, boundaryMode);
+
+  tabulatedPolicy.evaluate(10.0, state, mpcState, mpcInput, mode);
+  tabulatedPolicy.evaluate(primalSolution.timeTrajectory_.back(), state, boundaryState, boundaryInput, boundaryMode);
+  EXPECT_TRUE(mpcState.isApprox(boundaryState));
+  EXPECT_TRUE(mpcInput.isApprox(boundaryInput));
+  EXPECT_EQ(mode, boundaryMode);
+}
+
+TEST(testTabulatedPolicy, unsupportedPolicy) {
+  auto primalSolution = getPrimalSolutionWithEvents(true);
+  TabulatedPolicy tabulatedPolicy(0.05);
+
+  // varying state dimension
+  primalSolution.stateTrajectory_.back() = vector_t::Zero(1);
+  tabulatedPolicy.update(primalSolution);
+  EXPECT_TRUE(tabulatedPolicy.empty());
+
+  // no policy
+  primalSolution = getPrimalSolutionWithEvents(true);
+  primalSolution.controllerPtr_.reset();
+  tabulatedPolicy.update(primalSolution);
+  EXPECT_TRUE(tabulatedPolicy.empty());
+
+  vector_t mpcState, mpcInput;
+  size_t mode;
+  EXPECT_THROW(tabulatedPolicy.evaluate(0.5, vector_t::Ones(3), mpcState, mpcInput, mode), std::runtime_error);
+}
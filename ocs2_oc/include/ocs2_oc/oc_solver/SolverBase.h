@@ -29,9 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include <ocs2_core/Types.h>
@@ -44,6 +48,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * The reason for which a solver run has been interrupted before meeting its termination criteria.
+ */
+enum class InterruptStatus { NONE, REQUESTED, DEADLINE };
+
+std::string toString(InterruptStatus interruptStatus);
+
 /**
  * This class is an interface class for the single-thread and multi-thread SLQ.
  */
@@ -98,6 +109,31 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution);
 
+  /**
+   * Sets a wall-clock deadline for the subsequent calls of run(). If the deadline is reached while the solver is running, the solver stops
+   * at its next check point and keeps the best iterate found so far as its solution. The deadline remains active until it is cleared.
+   *
+   * @param [in] deadline: The point in time at which the solver should terminate.
+   */
+  void setDeadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline.time_since_epoch().count(); }
+
+  /**
+   * Removes the deadline set by setDeadline().
+   */
+  void clearDeadline() { deadline_ = std::numeric_limits<std::chrono::steady_clock::rep>::max(); }
+
+  /**
+   * Requests the running solver to stop at its next check point and to keep the best iterate found so far as its solution. This method
+   * is thread-safe and meant to be called from another thread while run() is active. A pending request is discarded at the beginning of
+   * each run().
+   */
+  void requestInterrupt() { interruptRequested_ = true; }
+
+  /**
+   * Returns whether the last call of run() was interrupted, either by requestInterrupt() or by the deadline.
+   */
+  InterruptStatus getInterruptStatus() const { return interruptStatus_; }
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -213,6 +249,15 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /**
+   * Checks whether the solver should stop early because of an interrupt request or the deadline. The first positive check is latched in
+   * the interrupt status of the current run. This method is thread-safe, and it can be polled inside parallel tasks.
+   *
+   * @return True if the solver should terminate.
+   */
+  bool isInterrupted() const;
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -230,6 +275,10 @@ class SolverBase {
   mutable std::mutex outputDisplayGuardMutex_;
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
+
+  std::atomic_bool interruptRequested_{false};
+  std::atomic<std::chrono::steady_clock::rep> deadline_{std::numeric_limits<std::chrono::steady_clock::rep>::max()};
+  mutable std::atomic<InterruptStatus> interruptStatus_{InterruptStatus::NONE};
 };
 
 }  // namespace ocs2
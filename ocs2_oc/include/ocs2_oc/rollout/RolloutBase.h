@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_core/reference/ModeSchedule.h"
 
 #include "ocs2_oc/rollout/RolloutSettings.h"
+#include "ocs2_oc/rollout/TimeGrid.h"
 
 namespace ocs2 {
 
@@ -75,8 +76,8 @@ class RolloutBase {
   virtual void reactivateRollout() {}
 
   /**
-   * Resets the simulator state to the initial state in the next runImpl.
-   * @note This is relevant if a physics engine (e.g. RaiSim) is used.
+   * Resets the state which the rollout carries between its runs, e.g., the step-size warm start of the integrator or the
+   * simulator state, which is then set to the initial state in the next runImpl if a physics engine (e.g. RaiSim) is used.
    */
   virtual void resetRollout() {}
 
@@ -108,6 +109,49 @@ class RolloutBase {
                        ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
                        vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) = 0;
 
+  /**
+   * Forward integrate the system dynamics like run(), but observes the trajectories on the given time grid if
+   * rollout::Settings::reuseTimeGrid is set and the grid matches the active modes of [initTime, finalTime]. Otherwise, and by
+   * default, the grid is ignored.
+   *
+   * @param [in] timeGrid: The time grid, e.g. the one adapted to the nominal rollout of a solver by adaptTimeGrid().
+   * @param [in] initTime: The initial time.
+   * @param [in] initState: The initial state.
+   * @param [in] finalTime: The final time.
+   * @param [in] controller: control policy.
+   * @param [in, out] modeSchedule: Defines the sequence of modes and the associated event times.
+   * @param [out] timeTrajectory: The time trajectory stamp.
+   * @param [out] postEventIndices: Indices containing past-the-end index of events trigger.
+   * @param [out] stateTrajectory: The state trajectory.
+   * @param [out] inputTrajectory: The control input trajectory.
+   *
+   * @return The final state (state jump is considered if it took place)
+   */
+  virtual vector_t runOnTimeGrid(const rollout::TimeGrid& timeGrid, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                 ControllerBase* controller, ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory,
+                                 size_array_t& postEventIndices, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+    return run(initTime, initState, finalTime, controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory,
+               inputTrajectory);
+  }
+
+  /**
+   * Adapts a time grid to the given rollout for the next calls of runOnTimeGrid(). The result depends only on its arguments and
+   * the settings. By default, an empty time grid is returned.
+   *
+   * @param [in] initTime: The initial time of the rollout.
+   * @param [in] finalTime: The final time of the rollout.
+   * @param [in] modeSchedule: The mode schedule of the rollout.
+   * @param [in] timeTrajectory: The time trajectory stamp of the rollout.
+   * @param [in] postEventIndices: Indices containing past-the-end index of events trigger.
+   * @param [in] stateTrajectory: The state trajectory of the rollout.
+   * @return The adapted time grid.
+   */
+  virtual rollout::TimeGrid adaptTimeGrid(scalar_t initTime, scalar_t finalTime, const ModeSchedule& modeSchedule,
+                                          const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
+                                          const vector_array_t& stateTrajectory) const {
+    return rollout::TimeGrid();
+  }
+
   /**
    * Prints out the rollout.
    *
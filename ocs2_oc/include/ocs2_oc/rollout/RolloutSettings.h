@@ -58,6 +58,21 @@ struct Settings {
   bool checkNumericalStability = false;
   /** Whether to run controller again after integration to construct input trajectory */
   bool reconstructInputTrajectory = true;
+  /** Whether the adaptive integrator starts a rollout from the step size of its previous rollout over the same interval. This
+   *  saves function calls in the iterations of a solver, but the rollout then depends on the previous rollouts of the same
+   *  worker. The warm start is cleared by RolloutBase::resetRollout. */
+  bool useStepSizeWarmStart = false;
+
+  /** Whether TimeTriggeredRollout::runOnTimeGrid observes the rollout on the time grid given by the caller, e.g. the grid which
+   *  a solver adapts to its nominal rollout with RolloutBase::adaptTimeGrid. The dynamics are still integrated with the adaptive
+   *  integrator. The grid is bisected where the estimated linear interpolation error of the state trajectory exceeds
+   *  timeGridTolerance and coarsened where it is far below. */
+  bool reuseTimeGrid = false;
+  /** The maximum total number of nodes of the reused time grid. Each mode keeps its two end nodes and gets a share of the
+   *  remaining nodes proportional to its duration, hence the cap is only exceeded if it is less than two nodes per mode. */
+  size_t maxNumTimeGridNodes = 1000;
+  /** The mixed absolute and relative tolerance on the interpolation error of the state trajectory on the reused time grid. */
+  scalar_t timeGridTolerance = 1e-3;
 
   /** Which of the RootFinding algorithms to use in StateRollout
    * 		0:		Anderson & Björck		(default)
@@ -66,8 +81,8 @@ struct Settings {
    * 		3:		Regula Falsi
    */
   RootFinderType rootFindingAlgorithm = RootFinderType::ANDERSON_BJORCK;
-  /** This value determines the maximum number of iterations, per event, allowed in state triggered rollout to find
-   *  the guard surface zero crossing.  */
+  /** This value determines the maximum number of re-integrations, per event, allowed in state triggered rollout to find
+   *  the guard surface zero crossing. In between, the crossing is localized on the dense output of the bracketing step.  */
   int maxSingleEventIterations = 10;
   /** Whether to use the trajectory spreading controller in state triggered rollout */
   bool useTrajectorySpreadingController = false;
@@ -42,6 +42,10 @@ namespace ocs2 {
 
 /**
  * This class is an interface class for forward rollout of the system dynamics.
+ *
+ * Events are localized on a cubic Hermite interpolation (dense output) of the integration step that crosses the guard
+ * surfaces, after which the system is re-integrated only up to the estimated event time. All guard surfaces are checked
+ * at once and simultaneous crossings are merged into a single event.
  */
 class StateTriggeredRollout : public RolloutBase {
  public:
@@ -63,6 +67,7 @@ class StateTriggeredRollout : public RolloutBase {
 
   void abortRollout() override { systemEventHandlersPtr_->killIntegration_ = true; }
   void reactivateRollout() override { systemEventHandlersPtr_->killIntegration_ = false; }
+  void resetRollout() override { dynamicsIntegratorPtr_->resetStepSizeWarmStart(); }
 
   vector_t run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller, ModeSchedule& modeSchedule,
                scalar_array_t& timeTrajectory, size_array_t& postEventIndices, vector_array_t& stateTrajectory,
@@ -0,0 +1,75 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+namespace rollout {
+
+/**
+ * The time grid on which a rollout observes the trajectory of each mode interval. See rollout::Settings::reuseTimeGrid.
+ *
+ * The grid is owned by the caller, e.g. a solver keeps it with its nominal trajectories, such that all rollouts over it are
+ * observed on the same nodes regardless of the rollout instance which runs them.
+ */
+struct TimeGrid {
+  /** The start and final times of the active modes, as used by RolloutBase. */
+  std::vector<std::pair<scalar_t, scalar_t>> modeIntervals;
+  /** The time grid of each mode interval. */
+  std::vector<scalar_array_t> nodes;
+
+  bool empty() const { return modeIntervals.empty(); }
+
+  /** The total number of nodes of the time grid. */
+  size_t size() const {
+    size_t numNodes = 0;
+    for (const auto& modeNodes : nodes) {
+      numNodes += modeNodes.size();
+    }
+    return numNodes;
+  }
+
+  void swap(TimeGrid& other) {
+    modeIntervals.swap(other.modeIntervals);
+    nodes.swap(other.nodes);
+  }
+
+  void clear() {
+    modeIntervals.clear();
+    nodes.clear();
+  }
+};
+
+}  // namespace rollout
+}  // namespace ocs2
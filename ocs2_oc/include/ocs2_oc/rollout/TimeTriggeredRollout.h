@@ -42,6 +42,10 @@ namespace ocs2 {
 
 /**
  * This class is an interface class for forward rollout of the system dynamics.
+ *
+ * If rollout::Settings::reuseTimeGrid is set, runOnTimeGrid() observes the rollout on a time grid which the caller adapts to a
+ * previous rollout over the same mode intervals, such that the number of trajectory nodes stays predictable across the iterations
+ * of a solver.
  */
 class TimeTriggeredRollout : public RolloutBase {
  public:
@@ -63,11 +67,24 @@ class TimeTriggeredRollout : public RolloutBase {
 
   void abortRollout() override { systemEventHandlersPtr_->killIntegration_ = true; }
   void reactivateRollout() override { systemEventHandlersPtr_->killIntegration_ = false; }
+  void resetRollout() override { dynamicsIntegratorPtr_->resetStepSizeWarmStart(); }
 
   vector_t run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller, ModeSchedule& modeSchedule,
                scalar_array_t& timeTrajectory, size_array_t& postEventIndices, vector_array_t& stateTrajectory,
                vector_array_t& inputTrajectory) override;
 
+  vector_t runOnTimeGrid(const rollout::TimeGrid& timeGrid, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                         ControllerBase* controller, ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory,
+                         size_array_t& postEventIndices, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) override;
+
+  /**
+   * Adapts the time grid of each mode interval to the rollout observed on it. See rollout::Settings::reuseTimeGrid. The total
+   * number of nodes is capped by rollout::Settings::maxNumTimeGridNodes, except that each mode keeps its two end nodes.
+   */
+  rollout::TimeGrid adaptTimeGrid(scalar_t initTime, scalar_t finalTime, const ModeSchedule& modeSchedule,
+                                  const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
+                                  const vector_array_t& stateTrajectory) const override;
+
  private:
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
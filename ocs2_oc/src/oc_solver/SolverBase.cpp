@@ -38,6 +38,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(InterruptStatus interruptStatus) {
+  switch (interruptStatus) {
+    case InterruptStatus::NONE:
+      return "NONE";
+    case InterruptStatus::REQUESTED:
+      return "REQUESTED";
+    case InterruptStatus::DEADLINE:
+      return "DEADLINE";
+    default:
+      throw std::runtime_error("[toString] Unknown InterruptStatus!");
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -87,10 +103,30 @@ void SolverBase::printString(const std::string& text) const {
   std::cerr << text << '\n';
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SolverBase::isInterrupted() const {
+  if (interruptStatus_ != InterruptStatus::NONE) {
+    return true;
+  } else if (interruptRequested_) {
+    interruptStatus_ = InterruptStatus::REQUESTED;
+    return true;
+  } else if (std::chrono::steady_clock::now().time_since_epoch().count() >= deadline_) {
+    interruptStatus_ = InterruptStatus::DEADLINE;
+    return true;
+  } else {
+    return false;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  interruptRequested_ = false;
+  interruptStatus_ = InterruptStatus::NONE;
+
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
@@ -59,6 +59,10 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.checkNumericalStability, fieldName + ".checkNumericalStability", verbose);
   loadData::loadPtreeValue(pt, settings.reconstructInputTrajectory, fieldName + ".reconstructInputTrajectory", verbose);
+  loadData::loadPtreeValue(pt, settings.useStepSizeWarmStart, fieldName + ".useStepSizeWarmStart", verbose);
+  loadData::loadPtreeValue(pt, settings.reuseTimeGrid, fieldName + ".reuseTimeGrid", verbose);
+  loadData::loadPtreeValue(pt, settings.maxNumTimeGridNodes, fieldName + ".maxNumTimeGridNodes", verbose);
+  loadData::loadPtreeValue(pt, settings.timeGridTolerance, fieldName + ".timeGridTolerance", verbose);
 
   auto rootFindingAlgorithmName = static_cast<int>(settings.rootFindingAlgorithm);  // keep default
   loadData::loadPtreeValue(pt, rootFindingAlgorithmName, fieldName + ".rootFindingAlgorithm", verbose);
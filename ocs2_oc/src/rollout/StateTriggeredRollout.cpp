@@ -29,11 +29,85 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/rollout/StateTriggeredRollout.h"
 
+#include <limits>
+
 #include <ocs2_core/control/StateBasedLinearController.h>
 #include <ocs2_oc/rollout/RootFinder.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** A point of the state trajectory bracketing an event, together with the data needed for the dense output. */
+struct BracketPoint {
+  scalar_t time;
+  vector_t state;
+  vector_t flowMap;
+  vector_t guardSurfaces;
+};
+
+BracketPoint makeBracketPoint(OdeBase& system, scalar_t time, const vector_t& state) {
+  return {time, state, system.computeFlowMap(time, state), system.computeGuardSurfaces(time, state)};
+}
+
+/** Cubic Hermite interpolation between two consecutive integration points, i.e., the dense output of the step. */
+vector_t denseOutput(const BracketPoint& p0, const BracketPoint& p1, scalar_t time) {
+  const scalar_t h = p1.time - p0.time;
+  const scalar_t s = (time - p0.time) / h;
+  const scalar_t s2 = s * s;
+  const scalar_t s3 = s2 * s;
+  vector_t state = (2.0 * s3 - 3.0 * s2 + 1.0) * p0.state;
+  state += (h * (s3 - 2.0 * s2 + s)) * p0.flowMap;
+  state += (3.0 * s2 - 2.0 * s3) * p1.state;
+  state += (h * (s3 - s2)) * p1.flowMap;
+  return state;
+}
+
+/** The smallest guard surface value among the event candidates. Its first zero crossing is the first of all candidate events. */
+scalar_t minGuardSurface(const vector_t& guardSurfaces, const size_array_t& eventCandidates) {
+  scalar_t minGuard = std::numeric_limits<scalar_t>::max();
+  for (const auto i : eventCandidates) {
+    minGuard = std::min(minGuard, guardSurfaces[i]);
+  }
+  return minGuard;
+}
+
+/**
+ * Localizes the first zero crossing of the candidate guard surfaces on the dense output of the bracketing step. All guard
+ * surfaces are evaluated at once for each query and the system is not re-integrated.
+ *
+ * @param [in] system: The system dynamics.
+ * @param [in] preEvent: The bracket point before the event.
+ * @param [in] postEvent: The bracket point after the event.
+ * @param [in] eventCandidates: The indices of the guard surfaces that change sign over the bracket.
+ * @param [in] rootFindingAlgorithm: The root-finding algorithm.
+ * @param [in] tolerance: The accepted absolute guard surface value.
+ * @return The estimated event time.
+ */
+scalar_t locateEvent(OdeBase& system, const BracketPoint& preEvent, const BracketPoint& postEvent, const size_array_t& eventCandidates,
+                     RootFinderType rootFindingAlgorithm, scalar_t tolerance) {
+  constexpr int maxNumIterations = 100;
+
+  RootFinder rootFinder(rootFindingAlgorithm);
+  rootFinder.setInitBracket(preEvent.time, postEvent.time, minGuardSurface(preEvent.guardSurfaces, eventCandidates),
+                            minGuardSurface(postEvent.guardSurfaces, eventCandidates));
+
+  scalar_t query = rootFinder.getNewQuery();
+  for (int i = 0; i < maxNumIterations; i++) {
+    const vector_t guardSurfaces = system.computeGuardSurfaces(query, denseOutput(preEvent, postEvent, query));
+    const scalar_t queryGuard = minGuardSurface(guardSurfaces, eventCandidates);
+    if (std::abs(queryGuard) < tolerance) {
+      break;
+    }
+    rootFinder.updateBracket(query, queryGuard);
+    query = rootFinder.getNewQuery();
+  }
+
+  return query;
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -43,6 +117,7 @@ StateTriggeredRollout::StateTriggeredRollout(const ControlledSystemBase& systemD
       systemEventHandlersPtr_(new StateTriggeredEventHandler(this->settings().timeStep)) {
   // construct dynamicsIntegratorsPtr
   dynamicsIntegratorPtr_ = std::move(newIntegrator(this->settings().integratorType, systemEventHandlersPtr_));
+  dynamicsIntegratorPtr_->setStepSizeWarmStart(this->settings().useStepSizeWarmStart);
 }
 
 /******************************************************************************************************/
@@ -86,8 +161,6 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
   // reset the event class
   systemEventHandlersPtr_->reset();
 
-  RootFinder rootFinder(this->settings().rootFindingAlgorithm);  // root-finding algorithm
-
   // TODO: this should be the current mode
   size_t eventID = 0;
   scalar_t t0 = initTime;
@@ -95,10 +168,13 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
   vector_t x0 = initState;
   modeSchedule.modeSequence.push_back(eventID);
 
+  // The event is bracketed by the last integration point before and the first one after the zero crossing. The crossing is
+  // localized on the dense output of this step and the system is only re-integrated up to the estimated event time.
   bool refining = false;
-  int k_u = 0;                    // control input iterator
-  int singleEventIterations = 0;  // iterations for a single event
-  int numTotalIterations = 0;     // overall number of iterations
+  BracketPoint preEvent;
+  BracketPoint postEvent;
+  size_array_t eventCandidates;   // guard surfaces that change sign over the bracket
+  int singleEventIterations = 0;  // re-integrations for a single event
 
   while (true) {  // keeps looping until end time condition is fulfilled, after which the loop is broken
     bool triggered = false;
@@ -110,42 +186,71 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
       eventID = e;
       triggered = true;
     }
-    // calculate guard surface value of last query state and time
+
+    // end of simulation
+    if (!triggered && !refining) {
+      break;
+    }
+
+    const auto queryIndex = timeTrajectory.size() - 1;
     const scalar_t queryTime = timeTrajectory.back();
     const vector_t queryState = stateTrajectory.back();
-    const vector_t guardSurfaces = systemDynamicsPtr_->computeGuardSurfaces(queryTime, queryState);
-    const scalar_t queryGuard = guardSurfaces[eventID];
 
-    // accuracy conditions on the obtained query guard and width of time window
+    if (!refining) {
+      // the step before the crossing is cached as the lower end of the bracket
+      preEvent = makeBracketPoint(*systemDynamicsPtr_, timeTrajectory[queryIndex - 1], stateTrajectory[queryIndex - 1]);
+      postEvent = makeBracketPoint(*systemDynamicsPtr_, queryTime, queryState);
+      eventCandidates.clear();
+      for (Eigen::Index i = 0; i < postEvent.guardSurfaces.size(); i++) {
+        if (preEvent.guardSurfaces[i] > 0 && postEvent.guardSurfaces[i] <= 0) {
+          eventCandidates.push_back(i);
+        }
+      }
+      if (eventCandidates.empty()) {
+        eventCandidates.push_back(eventID);
+      }
+      refining = true;
+      singleEventIterations = 0;
+    } else {
+      BracketPoint query = makeBracketPoint(*systemDynamicsPtr_, queryTime, queryState);
+      if (minGuardSurface(query.guardSurfaces, eventCandidates) > 0) {
+        preEvent = std::move(query);
+      } else {
+        // a crossing before the queried time: the preceding integration point tightens the bracket from below
+        if (queryIndex > 0 && timeTrajectory[queryIndex - 1] > preEvent.time) {
+          BracketPoint previous = makeBracketPoint(*systemDynamicsPtr_, timeTrajectory[queryIndex - 1], stateTrajectory[queryIndex - 1]);
+          if (minGuardSurface(previous.guardSurfaces, eventCandidates) > 0) {
+            preEvent = std::move(previous);
+          }
+        }
+        postEvent = std::move(query);
+      }
+      singleEventIterations++;
+    }
+
+    // accuracy conditions on the obtained query guard and width of the bracket
+    const vector_t guardSurfaces = systemDynamicsPtr_->computeGuardSurfaces(queryTime, queryState);
+    const scalar_t queryGuard = minGuardSurface(guardSurfaces, eventCandidates);
     const bool guardAccuracyCondition = std::fabs(queryGuard) < this->settings().absTolODE;
-    const bool timeAccuracyCondition = std::fabs(t1 - t0) < this->settings().absTolODE;
+    const bool timeAccuracyCondition = std::fabs(postEvent.time - preEvent.time) < this->settings().absTolODE;
     const bool accuracyCondition = guardAccuracyCondition || timeAccuracyCondition;
     // condition to check whether max number of iterations has not been reached, to prevent an infinite loop
     const bool maxNumIterationsReached = singleEventIterations >= this->settings().maxSingleEventIterations;
 
-    // remove the element past the guard surface if the event handler was triggered
-    // (Due to checking in EventHandler this can only happen to the last element of the trajectory)
-    // Exception is when the element is outside the guardSurface but within tolerance
-    if (triggered && !accuracyCondition) {
-      stateTrajectory.pop_back();
-      timeTrajectory.pop_back();
-    }
-    triggered = false;
-
-    // compute control input trajectory and concatenate to inputTrajectory
-    if (this->settings().reconstructInputTrajectory) {
-      for (; k_u < timeTrajectory.size(); k_u++) {
-        inputTrajectory.emplace_back(systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k_u], stateTrajectory[k_u]));
-      }  // end of k_u loop
-    }
+    if (accuracyCondition || maxNumIterationsReached) {
+      // end time condition to detect end of simulation
+      if (numerics::almost_eq(finalTime, queryTime)) {
+        break;
+      }
 
-    // end time condition to detect end of simulation, means iteration procedure is done
-    if (numerics::almost_eq(finalTime, timeTrajectory.back())) {
-      break;
-    }
+      // simultaneous crossings are merged into a single event, identified by the most violated guard surface
+      eventID = eventCandidates.front();
+      for (const auto i : eventCandidates) {
+        if (guardSurfaces[i] < guardSurfaces[eventID]) {
+          eventID = i;
+        }
+      }
 
-    // accuracy condition for event refinement. If sufficiently accurate crossing location has been determined
-    if (accuracyCondition || maxNumIterationsReached) {
       // set new begin/end time and begin state
       t0 = queryTime + numeric_traits::weakEpsilon<scalar_t>();
       t1 = finalTime;
@@ -164,34 +269,31 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
       // updates the last event triggering times of Event Handler
       systemEventHandlersPtr_->setLastEvent(t0, guardSurfacesCross);
 
-      // reset relevant boolean and counter
       refining = false;
-      singleEventIterations = 0;
-    } else {           // otherwise keep or start refining
-      if (refining) {  // apply the rules of the root-finding method to continue refining
-        rootFinder.updateBracket(queryTime, queryGuard);
-      } else {  // properly configure root-finding method to start refining
-        const scalar_t& timeBefore = timeTrajectory.back();
-        const vector_t& stateBefore = stateTrajectory.back();
-        const vector_t guardSurfacesBefore = systemDynamicsPtr_->computeGuardSurfaces(timeBefore, stateBefore);
-        const scalar_t& guardBefore = guardSurfacesBefore[eventID];
-
-        rootFinder.setInitBracket(timeBefore, queryTime, guardBefore, queryGuard);
-        refining = true;
-      }
-      t1 = rootFinder.getNewQuery();
-      t0 = timeTrajectory.back();
-      x0 = stateTrajectory.back();
 
+    } else {
+      // remove the integration points past the lower end of the bracket, the integrator adds the initial point again
+      while (timeTrajectory.back() > preEvent.time) {
+        stateTrajectory.pop_back();
+        timeTrajectory.pop_back();
+      }
       stateTrajectory.pop_back();
       timeTrajectory.pop_back();
-      inputTrajectory.pop_back();
-      k_u--;
+
+      t0 = preEvent.time;
+      x0 = preEvent.state;
+      t1 = locateEvent(*systemDynamicsPtr_, preEvent, postEvent, eventCandidates, this->settings().rootFindingAlgorithm,
+                       this->settings().absTolODE);
     }
-    singleEventIterations++;
-    numTotalIterations++;
   }  // end of while loop
 
+  // compute control input trajectory, the controller does not change over the rollout
+  if (this->settings().reconstructInputTrajectory) {
+    for (size_t k = 0; k < timeTrajectory.size(); k++) {
+      inputTrajectory.emplace_back(systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k], stateTrajectory[k]));
+    }  // end of k loop
+  }
+
   // check for the numerical stability
   this->checkNumericalStability(*controller, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
 
@@ -29,8 +29,122 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/rollout/TimeTriggeredRollout.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Selects maxNumNodes nodes of a time grid, equidistant in their index, including the first and the last node.
+ */
+scalar_array_t thinTimeGrid(const scalar_array_t& timeGrid, size_t maxNumNodes) {
+  if (timeGrid.size() <= maxNumNodes) {
+    return timeGrid;
+  }
+  scalar_array_t thinnedTimeGrid(maxNumNodes);
+  const scalar_t stride = static_cast<scalar_t>(timeGrid.size() - 1) / static_cast<scalar_t>(maxNumNodes - 1);
+  for (size_t j = 0; j < maxNumNodes; j++) {
+    thinnedTimeGrid[j] = timeGrid[static_cast<size_t>(std::round(j * stride))];
+  }
+  return thinnedTimeGrid;
+}
+
+/**
+ * Adapts the time grid of a mode interval to the linear interpolation error of the state trajectory observed on it.
+ *
+ * The error of the interval [t_k, t_{k+1}] is estimated as h_k^2 / 8 * |x''| where x'' is the second divided difference at
+ * the adjacent nodes, scaled elementwise by tolerance * (1 + |x|). Intervals with an error above one are bisected, starting
+ * from the largest error while the node budget allows. An interior node is removed if the merged interval stays below a
+ * quarter of the tolerance, but never two adjacent nodes at once.
+ *
+ * @param [in] timeTrajectory: The time trajectory stamp.
+ * @param [in] stateTrajectory: The state trajectory.
+ * @param [in] beginIndex: The index of the first node of the mode interval.
+ * @param [in] endIndex: The past-the-end index of the mode interval.
+ * @param [in] tolerance: The interpolation error tolerance.
+ * @param [in] maxNumNodes: The maximum number of nodes of the time grid, at least two.
+ * @return The adapted time grid of the mode interval.
+ */
+scalar_array_t adaptModeTimeGrid(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory, size_t beginIndex,
+                                 size_t endIndex, scalar_t tolerance, size_t maxNumNodes) {
+  const size_t numNodes = endIndex - beginIndex;
+  const auto t = [&](size_t k) { return timeTrajectory[beginIndex + k]; };
+  const auto x = [&](size_t k) -> const vector_t& { return stateTrajectory[beginIndex + k]; };
+
+  if (numNodes < 3) {
+    return scalar_array_t(timeTrajectory.begin() + beginIndex, timeTrajectory.begin() + endIndex);
+  }
+
+  // scaled second derivative of the state at the nodes
+  scalar_array_t curvature(numNodes);
+  for (size_t k = 1; k + 1 < numNodes; k++) {
+    const scalar_t h0 = t(k) - t(k - 1);
+    const scalar_t h1 = t(k + 1) - t(k);
+    const vector_t secondDerivative = 2.0 / (h0 + h1) * ((x(k + 1) - x(k)) / h1 - (x(k) - x(k - 1)) / h0);
+    curvature[k] = (secondDerivative.array().abs() / (tolerance * (1.0 + x(k).array().abs()))).maxCoeff();
+  }
+  curvature.front() = curvature[1];
+  curvature.back() = curvature[numNodes - 2];
+
+  // estimated interpolation error of each interval, relative to the tolerance
+  scalar_array_t intervalError(numNodes - 1);
+  for (size_t k = 0; k + 1 < numNodes; k++) {
+    const scalar_t h = t(k + 1) - t(k);
+    intervalError[k] = h * h / 8.0 * std::max(curvature[k], curvature[k + 1]);
+  }
+
+  // coarsening
+  std::vector<bool> isRemoved(numNodes, false);
+  size_t numKeptNodes = numNodes;
+  for (size_t k = 1; k + 1 < numNodes; k++) {
+    const scalar_t h = t(k + 1) - t(k - 1);
+    const scalar_t mergedError = h * h / 8.0 * std::max({curvature[k - 1], curvature[k], curvature[k + 1]});
+    if (!isRemoved[k - 1] && intervalError[k - 1] <= 1.0 && intervalError[k] <= 1.0 && mergedError < 0.25) {
+      isRemoved[k] = true;
+      numKeptNodes--;
+    }
+  }
+
+  // refinement of the largest errors within the node budget
+  const size_t numRefinements = (numKeptNodes < maxNumNodes) ? maxNumNodes - numKeptNodes : 0;
+  scalar_t refinementThreshold = 1.0;
+  scalar_array_t refinementErrors;
+  std::copy_if(intervalError.begin(), intervalError.end(), std::back_inserter(refinementErrors),
+               [](scalar_t error) { return error > 1.0; });
+  if (refinementErrors.size() > numRefinements) {
+    if (numRefinements == 0) {
+      refinementThreshold = std::numeric_limits<scalar_t>::infinity();
+    } else {
+      std::nth_element(refinementErrors.begin(), refinementErrors.begin() + (numRefinements - 1), refinementErrors.end(),
+                       std::greater<scalar_t>());
+      refinementThreshold = refinementErrors[numRefinements - 1];
+    }
+  }
+
+  scalar_array_t timeGrid;
+  timeGrid.reserve(numKeptNodes + numRefinements);
+  size_t refinementCount = 0;
+  for (size_t k = 0; k + 1 < numNodes; k++) {
+    if (!isRemoved[k]) {
+      timeGrid.push_back(t(k));
+    }
+    if (intervalError[k] >= refinementThreshold && intervalError[k] > 1.0 && refinementCount < numRefinements) {
+      timeGrid.push_back(0.5 * (t(k) + t(k + 1)));
+      refinementCount++;
+    }
+  }
+  timeGrid.push_back(t(numNodes - 1));
+
+  return thinTimeGrid(timeGrid, maxNumNodes);
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -38,6 +152,7 @@ TimeTriggeredRollout::TimeTriggeredRollout(const ControlledSystemBase& systemDyn
     : RolloutBase(std::move(rolloutSettings)), systemDynamicsPtr_(systemDynamics.clone()), systemEventHandlersPtr_(new SystemEventHandler) {
   // construct dynamicsIntegratorsPtr
   dynamicsIntegratorPtr_ = std::move(newIntegrator(this->settings().integratorType, systemEventHandlersPtr_));
+  dynamicsIntegratorPtr_->setStepSizeWarmStart(this->settings().useStepSizeWarmStart);
 }
 
 /******************************************************************************************************/
@@ -46,6 +161,17 @@ TimeTriggeredRollout::TimeTriggeredRollout(const ControlledSystemBase& systemDyn
 vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, ControllerBase* controller,
                                    ModeSchedule& modeSchedule, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
                                    vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  return runOnTimeGrid(rollout::TimeGrid(), initTime, initState, finalTime, controller, modeSchedule, timeTrajectory, postEventIndices,
+                       stateTrajectory, inputTrajectory);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t TimeTriggeredRollout::runOnTimeGrid(const rollout::TimeGrid& timeGrid, scalar_t initTime, const vector_t& initState,
+                                             scalar_t finalTime, ControllerBase* controller, ModeSchedule& modeSchedule,
+                                             scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
+                                             vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
   if (initTime > finalTime) {
     throw std::runtime_error("[TimeTriggeredRollout::run] The initial time should be less-equal to the final time!");
   }
@@ -80,15 +206,26 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   // reset the event class
   systemEventHandlersPtr_->reset();
 
+  // observe the rollout on the given time grid if it matches the mode intervals
+  const bool reuseTimeGrid =
+      this->settings().reuseTimeGrid && timeGrid.modeIntervals == timeIntervalArray && timeGrid.nodes.size() == timeIntervalArray.size();
+
   vector_t beginState = initState;
   int k_u = 0;  // control input iterator
   for (int i = 0; i < numSubsystems; i++) {
     if (timeIntervalArray[i].first < timeIntervalArray[i].second) {
       Observer observer(&stateTrajectory, &timeTrajectory);  // concatenate trajectory
       // integrate controlled system
-      dynamicsIntegratorPtr_->integrateAdaptive(*systemDynamicsPtr_, observer, beginState, timeIntervalArray[i].first,
-                                                timeIntervalArray[i].second, this->settings().timeStep, this->settings().absTolODE,
-                                                this->settings().relTolODE, maxNumSteps);
+      if (reuseTimeGrid) {
+        const auto& modeTimeGrid = timeGrid.nodes[i];
+        dynamicsIntegratorPtr_->integrateTimes(*systemDynamicsPtr_, observer, beginState, modeTimeGrid.cbegin(), modeTimeGrid.cend(),
+                                               this->settings().timeStep, this->settings().absTolODE, this->settings().relTolODE,
+                                               maxNumSteps);
+      } else {
+        dynamicsIntegratorPtr_->integrateAdaptive(*systemDynamicsPtr_, observer, beginState, timeIntervalArray[i].first,
+                                                  timeIntervalArray[i].second, this->settings().timeStep, this->settings().absTolODE,
+                                                  this->settings().relTolODE, maxNumSteps);
+      }
     } else {
       timeTrajectory.push_back(timeIntervalArray[i].second);
       stateTrajectory.push_back(beginState);
@@ -115,4 +252,37 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+rollout::TimeGrid TimeTriggeredRollout::adaptTimeGrid(scalar_t initTime, scalar_t finalTime, const ModeSchedule& modeSchedule,
+                                                      const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
+                                                      const vector_array_t& stateTrajectory) const {
+  rollout::TimeGrid timeGrid;
+  timeGrid.modeIntervals = findActiveModesTimeInterval(initTime, finalTime, modeSchedule.eventTimes);
+  const size_t numSubsystems = timeGrid.modeIntervals.size();
+  const scalar_t totalDuration = finalTime - initTime;
+  if (totalDuration <= 0.0 || postEventIndices.size() + 1 != numSubsystems || timeTrajectory.size() != stateTrajectory.size()) {
+    timeGrid.clear();
+    return timeGrid;
+  }
+
+  // each mode keeps its two end nodes and gets a share of the remaining nodes proportional to its duration
+  const size_t numReservedNodes = 2 * numSubsystems;
+  const size_t maxNumTimeGridNodes = this->settings().maxNumTimeGridNodes;
+  const size_t numSharedNodes = (maxNumTimeGridNodes > numReservedNodes) ? maxNumTimeGridNodes - numReservedNodes : 0;
+
+  timeGrid.nodes.resize(numSubsystems);
+  for (size_t i = 0; i < numSubsystems; i++) {
+    const size_t beginIndex = (i == 0) ? 0 : postEventIndices[i - 1];
+    const size_t endIndex = (i < postEventIndices.size()) ? postEventIndices[i] : timeTrajectory.size();
+    const scalar_t duration = timeGrid.modeIntervals[i].second - timeGrid.modeIntervals[i].first;
+    const auto maxNumNodes = 2 + static_cast<size_t>(numSharedNodes * std::max(duration, 0.0) / totalDuration);
+    timeGrid.nodes[i] =
+        adaptModeTimeGrid(timeTrajectory, stateTrajectory, beginIndex, endIndex, this->settings().timeGridTolerance, maxNumNodes);
+  }
+
+  return timeGrid;
+}
+
 }  // namespace ocs2
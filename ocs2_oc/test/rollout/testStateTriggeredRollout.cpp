@@ -302,3 +302,60 @@ TEST(StateRolloutTests, runHybridDynamics) {
     EXPECT_NEAR(eventTestTimes[i], modeSchedule.eventTimes[i], 1e-6);
   }
 }
+
+/*
+ *     Test 4 for StateTriggeredRollout
+ *     The bouncing ball system with a duplicated ground guard surface, such that two guard surfaces are crossed simultaneously
+ *
+ *     Guard Surfaces are: x_1 > 0
+ *                         x_1 < 0.5
+ *                         2 * x_1 > 0
+ *
+ *     The following tests are implemented and performed:
+ *       - Simultaneous crossings are merged into a single event.
+ *       - Event times are identical to the ones of the ball without the duplicated guard surface.
+ */
+TEST(StateRolloutTests, rolloutTestSimultaneousEvents) {
+  class DuplicatedGuardBallDynamics final : public ocs2::ballDyn {
+   public:
+    vector_t computeGuardSurfaces(scalar_t t, const vector_t& x) override {
+      vector_t guardSurfaces(3);
+      guardSurfaces << x[0], -x[0] + 0.5, 2.0 * x[0];
+      return guardSurfaces;
+    }
+    DuplicatedGuardBallDynamics* clone() const override { return new DuplicatedGuardBallDynamics(*this); }
+  };
+
+  ocs2::rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-10;
+  rolloutSettings.relTolODE = 1e-7;
+  rolloutSettings.timeStep = 1e-3;
+
+  const scalar_t t0 = 0;
+  const scalar_t t1 = 3;
+  vector_t initState(2);
+  initState << 1, 0;
+  ocs2::LinearController control(scalar_array_t{t0}, vector_array_t{vector_t::Zero(1)}, matrix_array_t{matrix_t::Zero(1, 2)});
+
+  const auto runRollout = [&](const ocs2::ControlledSystemBase& dynamics, ocs2::ModeSchedule& modeSchedule) {
+    ocs2::StateTriggeredRollout rollout(dynamics, rolloutSettings);
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    rollout.run(t0, initState, t1, &control, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+    ASSERT_EQ(modeSchedule.eventTimes.size(), postEventIndices.size());
+  };
+
+  ocs2::ModeSchedule modeScheduleReference;
+  runRollout(ocs2::ballDyn(), modeScheduleReference);
+  ocs2::ModeSchedule modeSchedule;
+  runRollout(DuplicatedGuardBallDynamics(), modeSchedule);
+
+  ASSERT_EQ(modeScheduleReference.eventTimes.size(), modeSchedule.eventTimes.size());
+  for (int i = 0; i < modeSchedule.eventTimes.size(); i++) {
+    EXPECT_NEAR(modeScheduleReference.eventTimes[i], modeSchedule.eventTimes[i], 1e-8);
+    // the ground contact is reported once with either of the two ground guard surfaces
+    EXPECT_EQ(modeScheduleReference.modeSequence[i + 1] == 1, modeSchedule.modeSequence[i + 1] == 1);
+  }
+}
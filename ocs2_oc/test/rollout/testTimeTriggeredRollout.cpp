@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -37,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
 using namespace ocs2;
@@ -87,3 +89,165 @@ TEST(time_rollout_test, time_rollout_test) {
   ASSERT_EQ(totalSize, stateTrajectory.size());
   ASSERT_EQ(totalSize, inputTrajectory.size());
 }
+
+TEST(time_rollout_test, reuse_time_grid) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 10.0;
+  const vector_t initState = vector_t::Zero(nx);
+
+  ModeSchedule modeSchedule({3.0, 4.0}, {0, 1, 2});
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  const scalar_array_t cntTimeStamp{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Ones(nu));
+  const matrix_array_t k(2, matrix_t::Zero(nu, nx));
+  LinearController controller(cntTimeStamp, uff, k);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-9;
+  rolloutSettings.relTolODE = 1e-7;
+  rolloutSettings.timeStep = 1e-3;
+  TimeTriggeredRollout adaptiveRollout(systemDynamics, rolloutSettings);
+  rolloutSettings.reuseTimeGrid = true;
+  rolloutSettings.maxNumTimeGridNodes = 120;
+  rolloutSettings.timeGridTolerance = 1e-3;
+  TimeTriggeredRollout gridRollout(systemDynamics, rolloutSettings);
+
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  const vector_t finalState = adaptiveRollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory,
+                                                  postEventIndices, stateTrajectory, inputTrajectory);
+  const auto numAdaptiveNodes = timeTrajectory.size();
+  const scalar_array_t adaptiveTimeTrajectory = timeTrajectory;
+  const vector_array_t adaptiveStateTrajectory = stateTrajectory;
+
+  // the first rollout discretizes adaptively, the next ones are observed on the grid adapted to the previous one
+  rollout::TimeGrid timeGrid;
+  std::vector<size_t> numNodes;
+  for (size_t iter = 0; iter < 4; iter++) {
+    const vector_t gridFinalState = gridRollout.runOnTimeGrid(timeGrid, initTime, initState, finalTime, &controller, modeSchedule,
+                                                              timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+    timeGrid = gridRollout.adaptTimeGrid(initTime, finalTime, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory);
+    numNodes.push_back(timeTrajectory.size());
+    EXPECT_LE(timeGrid.size(), rolloutSettings.maxNumTimeGridNodes);
+    ASSERT_EQ(timeTrajectory.size(), stateTrajectory.size());
+    ASSERT_EQ(timeTrajectory.size(), inputTrajectory.size());
+    ASSERT_EQ(postEventIndices.size(), 2);
+    EXPECT_NEAR(timeTrajectory.front(), initTime, 1e-6);
+    EXPECT_NEAR(timeTrajectory.back(), finalTime, 1e-6);
+    EXPECT_NEAR(timeTrajectory[postEventIndices[0] - 1], 3.0, 1e-6);
+    EXPECT_NEAR(timeTrajectory[postEventIndices[0]], 3.0, 1e-6);
+    EXPECT_TRUE(std::is_sorted(timeTrajectory.begin(), timeTrajectory.end()));
+    // the integration accuracy does not depend on the grid
+    EXPECT_TRUE(gridFinalState.isApprox(finalState, 1e-6));
+  }
+
+  // the linear interpolation on the reused grid stays within the tolerance
+  for (size_t j = 0; j < postEventIndices[0]; j++) {
+    const vector_t state = LinearInterpolation::interpolate(adaptiveTimeTrajectory[j], timeTrajectory, stateTrajectory);
+    EXPECT_LT((state - adaptiveStateTrajectory[j]).lpNorm<Eigen::Infinity>(), 2.0 * rolloutSettings.timeGridTolerance);
+  }
+  EXPECT_EQ(numNodes.front(), numAdaptiveNodes);
+  for (size_t iter = 1; iter < numNodes.size(); iter++) {
+    EXPECT_LE(numNodes[iter], rolloutSettings.maxNumTimeGridNodes);
+    EXPECT_LE(numNodes[iter], numNodes[iter - 1]);
+  }
+
+  // the number of nodes is capped
+  rolloutSettings.maxNumTimeGridNodes = 20;
+  TimeTriggeredRollout cappedRollout(systemDynamics, rolloutSettings);
+  timeGrid = cappedRollout.adaptTimeGrid(initTime, finalTime, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory);
+  EXPECT_LE(timeGrid.size(), rolloutSettings.maxNumTimeGridNodes);
+  cappedRollout.runOnTimeGrid(timeGrid, initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices,
+                              stateTrajectory, inputTrajectory);
+  EXPECT_LE(timeTrajectory.size(), rolloutSettings.maxNumTimeGridNodes);
+
+  // a different mode schedule discretizes adaptively again
+  ModeSchedule otherModeSchedule({3.0, 5.0}, {0, 1, 2});
+  adaptiveRollout.run(initTime, initState, finalTime, &controller, otherModeSchedule, timeTrajectory, postEventIndices, stateTrajectory,
+                      inputTrajectory);
+  const auto numOtherAdaptiveNodes = timeTrajectory.size();
+  gridRollout.runOnTimeGrid(timeGrid, initTime, initState, finalTime, &controller, otherModeSchedule, timeTrajectory, postEventIndices,
+                            stateTrajectory, inputTrajectory);
+  EXPECT_NEAR(timeTrajectory[postEventIndices[1]], 5.0, 1e-6);
+  EXPECT_EQ(timeTrajectory.size(), numOtherAdaptiveNodes);
+}
+
+TEST(time_rollout_test, time_grid_of_many_modes) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 10.0;
+  const vector_t initState = vector_t::Zero(nx);
+
+  // 20 modes of equal duration
+  scalar_array_t eventTimes;
+  size_array_t modeSequence{0};
+  for (size_t i = 1; i < 20; i++) {
+    eventTimes.push_back(0.5 * i);
+    modeSequence.push_back(i);
+  }
+  ModeSchedule modeSchedule(eventTimes, modeSequence);
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  const scalar_array_t cntTimeStamp{initTime, finalTime};
+  const vector_array_t uff(2, vector_t::Ones(nu));
+  const matrix_array_t k(2, matrix_t::Zero(nu, nx));
+  LinearController controller(cntTimeStamp, uff, k);
+
+  rollout::Settings rolloutSettings;
+  rolloutSettings.absTolODE = 1e-9;
+  rolloutSettings.relTolODE = 1e-7;
+  rolloutSettings.timeStep = 1e-3;
+  rolloutSettings.reuseTimeGrid = true;
+  rolloutSettings.maxNumTimeGridNodes = 50;
+  rolloutSettings.timeGridTolerance = 1e-5;
+  TimeTriggeredRollout rollout(systemDynamics, rolloutSettings);
+
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  rollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory,
+              inputTrajectory);
+  ASSERT_GT(timeTrajectory.size(), rolloutSettings.maxNumTimeGridNodes);
+
+  // the cap holds for the total number of nodes
+  const auto timeGrid = rollout.adaptTimeGrid(initTime, finalTime, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory);
+  ASSERT_EQ(timeGrid.nodes.size(), 20);
+  EXPECT_LE(timeGrid.size(), rolloutSettings.maxNumTimeGridNodes);
+  for (const auto& modeTimeGrid : timeGrid.nodes) {
+    EXPECT_GE(modeTimeGrid.size(), 2);
+  }
+
+  // rollouts on the same grid are observed on the same nodes, regardless of the instance which runs them
+  std::unique_ptr<RolloutBase> otherRolloutPtr(rollout.clone());
+  rollout.runOnTimeGrid(timeGrid, initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices,
+                        stateTrajectory, inputTrajectory);
+  EXPECT_LE(timeTrajectory.size(), rolloutSettings.maxNumTimeGridNodes);
+  scalar_array_t otherTimeTrajectory;
+  size_array_t otherPostEventIndices;
+  vector_array_t otherStateTrajectory;
+  vector_array_t otherInputTrajectory;
+  otherRolloutPtr->runOnTimeGrid(timeGrid, initTime, initState, finalTime, &controller, modeSchedule, otherTimeTrajectory,
+                                 otherPostEventIndices, otherStateTrajectory, otherInputTrajectory);
+  EXPECT_EQ(otherTimeTrajectory, timeTrajectory);
+  EXPECT_EQ(otherPostEventIndices, postEventIndices);
+
+  // a cap below two nodes per mode keeps the end nodes of each mode
+  rolloutSettings.maxNumTimeGridNodes = 30;
+  TimeTriggeredRollout cappedRollout(systemDynamics, rolloutSettings);
+  const auto cappedTimeGrid =
+      cappedRollout.adaptTimeGrid(initTime, finalTime, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory);
+  EXPECT_EQ(cappedTimeGrid.size(), 2 * 20);
+}
@@ -115,6 +115,17 @@ class CentroidalModelPinocchioMappingTpl final : public PinocchioStateInputMappi
    */
   std::pair<matrix_t, matrix_t> getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const override;
 
+  /**
+   * Computes the derivatives of the pinocchio joint velocities (vPinocchio) with respect to the system state and input in place.
+   * @param [in] state: system state vector
+   * @param [out] dvdx: derivative of vPinocchio with respect to the state, of size generalizedCoordinatesNum x stateDim
+   * @param [out] dvdu: derivative of vPinocchio with respect to the input, of size generalizedCoordinatesNum x inputDim
+   *
+   * @note requires pinocchioInterface to be updated with:
+   *       ocs2::updateCentroidalDynamicsDerivatives(interface, info, q, v)
+   */
+  void getPinocchioJointVelocityDerivatives(const vector_t& state, Eigen::Ref<matrix_t> dvdx, Eigen::Ref<matrix_t> dvdu) const;
+
   /**
    * Returns a structure containing robot-specific information needed for the centroidal dynamics computations.
    */
@@ -0,0 +1,124 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+
+#include "ocs2_centroidal_model/CentroidalModelInfo.h"
+
+namespace ocs2 {
+
+/**
+ * Single Rigid Body Dynamics (SRBD) with closed-form derivatives:
+ *
+ * State: x = [ linear_momentum / mass, angular_momentum / mass, base_position, base_orientation_zyx, joint_positions ]'
+ * Input: u = [ contact_forces, contact_wrenches, joint_velocities ]'
+ *
+ * This is the same model as PinocchioCentroidalDynamics with CentroidalModelType::SingleRigidBodyDynamics. However, since the
+ * inertia and the CoM offset of the body are constant in the base frame, the base velocity and its derivatives are evaluated
+ * with fixed-size 3x3 algebra instead of through the centroidal momentum matrix and the generic pinocchio mapping. Pinocchio
+ * is only queried for the contact point positions and their Jacobians, which depend on the leg joints.
+ */
+class PinocchioSingleRigidBodyDynamics final {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  using Vector3 = Eigen::Matrix<scalar_t, 3, 1>;
+  using Matrix3x = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
+  using Matrix6x = Eigen::Matrix<scalar_t, 6, Eigen::Dynamic>;
+  using Matrix3 = Eigen::Matrix<scalar_t, 3, 3>;
+
+  /**
+   * Constructor
+   * @param [in] CentroidalModelInfo : The centroidal model information. The model type should be SingleRigidBodyDynamics.
+   */
+  explicit PinocchioSingleRigidBodyDynamics(CentroidalModelInfo info);
+
+  /** Copy Constructor */
+  PinocchioSingleRigidBodyDynamics(const PinocchioSingleRigidBodyDynamics& rhs);
+
+  /** Set the pinocchio interface for caching.
+   * @param [in] pinocchioInterface: pinocchio interface on which computations are expected. It will keep a pointer for the getters.
+   * @note The pinocchio interface must be set before calling the getters.
+   */
+  void setPinocchioInterface(const PinocchioInterface& pinocchioInterface) { pinocchioInterfacePtr_ = &pinocchioInterface; }
+
+  /** Get the centroidal model information */
+  const CentroidalModelInfo& getCentroidalModelInfo() const { return info_; }
+
+  /**
+   * Computes system flow map x_dot = f(x, u)
+   *
+   * @param time: time
+   * @param state: system state vector
+   * @param input: system input vector
+   * @return system flow map x_dot = f(x, u)
+   *
+   * @note requires pinocchioInterface to be updated with the frame placements, e.g. through:
+   *       ocs2::updateCentroidalDynamics(interface, info, q)
+   */
+  vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input);
+
+  /**
+   * Computes first order approximation of the system flow map x_dot = f(x, u)
+   *
+   * @param time: time
+   * @param state: system state vector
+   * @param input: system input vector
+   * @return linear approximation of system flow map x_dot = f(x, u)
+   *
+   * @note requires pinocchioInterface to be updated with the frame placements and the joint Jacobians, e.g. through:
+   *       ocs2::updateCentroidalDynamicsDerivatives(interface, info, q, v)
+   */
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input);
+
+ private:
+  /** Updates the base rotation, the CoM offset and the angular velocity of the body for the given state. */
+  void updateBaseKinematics(const vector_t& state);
+
+  const PinocchioInterface* pinocchioInterfacePtr_;
+  CentroidalModelInfo info_;
+  Matrix3 inertiaNominalInverse_;
+
+  // cached base kinematics
+  Matrix3 rotationBaseToWorld_;
+  Matrix3 mappingZyx_;
+  Matrix3 mappingZyxInverse_;
+  Matrix3 inertiaInverseInWorld_;
+  Vector3 comToBasePositionInWorld_;
+  Vector3 comPositionInWorld_;
+  Vector3 angularVelocityInWorld_;
+
+  // workspace of the contact Jacobians
+  Matrix6x jointJacobian_;
+  Matrix3x contactJacobian_;
+};
+}  // namespace ocs2
@@ -112,28 +112,50 @@ auto CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointVelocity(const
 template <typename SCALAR>
 auto CentroidalModelPinocchioMappingTpl<SCALAR>::getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const
     -> std::pair<matrix_t, matrix_t> {
+  const auto& info = centroidalModelInfo_;
+  assert(info.stateDim == state.rows());
+
+  matrix_t dvdx(info.generalizedCoordinatesNum, info.stateDim);
+  matrix_t dvdu(info.generalizedCoordinatesNum, info.inputDim);
+  getPinocchioJointVelocityDerivatives(state, dvdx, dvdu);
+
+  matrix_t dfdx = matrix_t::Zero(Jq.rows(), centroidalModelInfo_.stateDim);
+  dfdx.middleCols(6, info.generalizedCoordinatesNum) = Jq;
+  dfdx.noalias() += Jv * dvdx;
+  const matrix_t dfdu = Jv * dvdu;
+  return {dfdx, dfdu};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SCALAR>
+void CentroidalModelPinocchioMappingTpl<SCALAR>::getPinocchioJointVelocityDerivatives(const vector_t& state, Eigen::Ref<matrix_t> dvdx,
+                                                                                      Eigen::Ref<matrix_t> dvdu) const {
   const auto& model = pinocchioInterfacePtr_->getModel();
   const auto& data = pinocchioInterfacePtr_->getData();
   const auto& info = centroidalModelInfo_;
   assert(info.stateDim == state.rows());
+  assert(dvdx.rows() == info.generalizedCoordinatesNum && dvdx.cols() == info.stateDim);
+  assert(dvdu.rows() == info.generalizedCoordinatesNum && dvdu.cols() == info.inputDim);
+
+  dvdx.setZero();
+  dvdu.setZero();
 
   // Partial derivatives of joint velocities
-  matrix_t jointVelocitiesDerivativeInput = matrix_t::Zero(info.actuatedDofNum, info.inputDim);
-  jointVelocitiesDerivativeInput.rightCols(info.actuatedDofNum).setIdentity();
+  dvdu.bottomRightCorner(info.actuatedDofNum, info.actuatedDofNum).setIdentity();
 
   // Partial derivatives of the floating base variables
   // TODO: move getFloatingBaseCentroidalMomentumMatrixInverse(Ab) to PreComputation
-  matrix_t floatingBaseVelocitiesDerivativeState = matrix_t::Zero(6, info.stateDim);
-  matrix_t floatingBaseVelocitiesDerivativeInput = matrix_t::Zero(6, info.inputDim);
   const auto& A = getCentroidalMomentumMatrix(*pinocchioInterfacePtr_);
   const Eigen::Matrix<SCALAR, 6, 6> Ab = A.template leftCols<6>();
   const auto Ab_inv = computeFloatingBaseCentroidalMomentumMatrixInverse(Ab);
-  floatingBaseVelocitiesDerivativeState.leftCols(6) = info.robotMass * Ab_inv;
+  dvdx.template topLeftCorner<6, 6>() = info.robotMass * Ab_inv;
 
   using matrix6x_t = Eigen::Matrix<SCALAR, 6, Eigen::Dynamic>;
-  matrix6x_t dhdq(6, info.generalizedCoordinatesNum);
   switch (info.centroidalModelType) {
     case CentroidalModelType::FullCentroidalDynamics: {
+      matrix6x_t dhdq(6, info.generalizedCoordinatesNum);
       pinocchio::translateForceSet(data.dHdq, data.com[0], dhdq.const_cast_derived());
       for (size_t k = 0; k < model.nv; ++k) {
         dhdq.template block<3, 1>(pinocchio::Force::ANGULAR, k) +=
@@ -141,29 +163,18 @@ auto CentroidalModelPinocchioMappingTpl<SCALAR>::getOcs2Jacobian(const vector_t&
       }
       dhdq.middleCols(3, 3) = data.dFdq.middleCols(3, 3);
       const auto Aj = A.rightCols(info.actuatedDofNum);
-      floatingBaseVelocitiesDerivativeState.rightCols(info.generalizedCoordinatesNum).noalias() = -Ab_inv * dhdq;
-      floatingBaseVelocitiesDerivativeInput.rightCols(info.actuatedDofNum).noalias() = -Ab_inv * Aj;
+      dvdx.topRightCorner(6, info.generalizedCoordinatesNum).noalias() = -Ab_inv * dhdq;
+      dvdu.topRightCorner(6, info.actuatedDofNum).noalias() = -Ab_inv * Aj;
       break;
     }
     case CentroidalModelType::SingleRigidBodyDynamics: {
-      dhdq = data.dFdq;
-      floatingBaseVelocitiesDerivativeState.middleCols(6, 6).noalias() = -Ab_inv * dhdq.leftCols(6);
+      dvdx.template block<6, 6>(0, 6).noalias() = -Ab_inv * data.dFdq.leftCols(6);
       break;
     }
     default: {
       throw std::runtime_error("The chosen centroidal model type is not supported.");
     }
   }
-
-  matrix_t dvdx = matrix_t::Zero(info.generalizedCoordinatesNum, info.stateDim);
-  dvdx.template topRows<6>() = floatingBaseVelocitiesDerivativeState;
-  matrix_t dvdu = matrix_t::Zero(info.generalizedCoordinatesNum, info.inputDim);
-  dvdu << floatingBaseVelocitiesDerivativeInput, jointVelocitiesDerivativeInput;
-  matrix_t dfdx = matrix_t::Zero(Jq.rows(), centroidalModelInfo_.stateDim);
-  dfdx.middleCols(6, info.generalizedCoordinatesNum) = Jq;
-  dfdx.noalias() += Jv * dvdx;
-  const matrix_t dfdu = Jv * dvdu;
-  return {dfdx, dfdu};
 }
 
 // explicit template instantiation
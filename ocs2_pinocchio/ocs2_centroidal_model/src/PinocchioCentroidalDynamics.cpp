@@ -77,16 +77,14 @@ VectorFunctionLinearApproximation PinocchioCentroidalDynamics::getLinearApproxim
   // Partial derivatives of the normalized momentum rates
   computeNormalizedCentroidalMomentumRateGradients(state, input);
 
-  matrix_t dfdq = matrix_t::Zero(info.stateDim, info.generalizedCoordinatesNum);
-  matrix_t dfdv = matrix_t::Zero(info.stateDim, info.generalizedCoordinatesNum);
-  dfdq.topRows<6>() << normalizedLinearMomentumRateDerivativeQ_, normalizedAngularMomentumRateDerivativeQ_;
-  dfdv.bottomRows(info.generalizedCoordinatesNum).setIdentity();
-
-  std::tie(dynamics.dfdx, dynamics.dfdu) = mapping_.getOcs2Jacobian(state, dfdq, dfdv);
-
-  // Add partial derivative of f with respect to u since part of f depends explicitly on the inputs (contact forces + torques)
-  dynamics.dfdu.topRows<3>() += normalizedLinearMomentumRateDerivativeInput_;
-  dynamics.dfdu.middleRows(3, 3) += normalizedAngularMomentumRateDerivativeInput_;
+  // The momentum rates only depend on the pinocchio joint positions and on the inputs, and the remaining rows are the pinocchio joint
+  // velocities. Therefore, the Jacobians are assembled in place rather than through the dense products of mapping_.getOcs2Jacobian().
+  const size_t nq = info.generalizedCoordinatesNum;
+  dynamics.dfdx.block(0, 6, 3, nq) = normalizedLinearMomentumRateDerivativeQ_;
+  dynamics.dfdx.block(3, 6, 3, nq) = normalizedAngularMomentumRateDerivativeQ_;
+  dynamics.dfdu.topRows<3>() = normalizedLinearMomentumRateDerivativeInput_;
+  dynamics.dfdu.middleRows(3, 3) = normalizedAngularMomentumRateDerivativeInput_;
+  mapping_.getPinocchioJointVelocityDerivatives(state, dynamics.dfdx.bottomRows(nq), dynamics.dfdu.bottomRows(nq));
 
   return dynamics;
 }
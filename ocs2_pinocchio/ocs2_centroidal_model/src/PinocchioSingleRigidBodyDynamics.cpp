@@ -0,0 +1,188 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>  // forward declarations must be included first.
+
+#include "ocs2_centroidal_model/PinocchioSingleRigidBodyDynamics.h"
+
+#include <pinocchio/algorithm/jacobian.hpp>
+
+#include <ocs2_robotic_tools/common/RotationDerivativesTransforms.h>
+#include <ocs2_robotic_tools/common/RotationTransforms.h>
+#include <ocs2_robotic_tools/common/SkewSymmetricMatrix.h>
+
+#include "ocs2_centroidal_model/AccessHelperFunctions.h"
+#include "ocs2_centroidal_model/ModelHelperFunctions.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioSingleRigidBodyDynamics::PinocchioSingleRigidBodyDynamics(CentroidalModelInfo info)
+    : pinocchioInterfacePtr_(nullptr), info_(std::move(info)) {
+  if (info_.centroidalModelType != CentroidalModelType::SingleRigidBodyDynamics) {
+    throw std::runtime_error("[PinocchioSingleRigidBodyDynamics] The centroidal model type should be SingleRigidBodyDynamics!");
+  }
+  inertiaNominalInverse_ = info_.centroidalInertiaNominal.inverse();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioSingleRigidBodyDynamics::PinocchioSingleRigidBodyDynamics(const PinocchioSingleRigidBodyDynamics& rhs)
+    : pinocchioInterfacePtr_(nullptr), info_(rhs.info_), inertiaNominalInverse_(rhs.inertiaNominalInverse_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioSingleRigidBodyDynamics::updateBaseKinematics(const vector_t& state) {
+  const auto basePose = centroidal_model::getBasePose(state, info_);
+  const Vector3 eulerAnglesZyx = basePose.tail<3>();
+  rotationBaseToWorld_ = getRotationMatrixFromZyxEulerAngles(eulerAnglesZyx);
+  mappingZyx_ = getMappingFromEulerAnglesZyxDerivativeToGlobalAngularVelocity(eulerAnglesZyx);
+  mappingZyxInverse_ = mappingZyx_.inverse();
+  inertiaInverseInWorld_.noalias() = rotationBaseToWorld_ * inertiaNominalInverse_ * rotationBaseToWorld_.transpose();
+
+  comToBasePositionInWorld_.noalias() = rotationBaseToWorld_ * info_.comToBasePositionNominal;
+  comPositionInWorld_ = basePose.head<3>() - comToBasePositionInWorld_;
+
+  // the angular momentum of a single rigid body is I * omega
+  const Vector3 normalizedAngularMomentum = centroidal_model::getNormalizedMomentum(state, info_).tail<3>();
+  angularVelocityInWorld_.noalias() = info_.robotMass * inertiaInverseInWorld_ * normalizedAngularMomentum;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PinocchioSingleRigidBodyDynamics::getValue(scalar_t time, const vector_t& state, const vector_t& input) {
+  const auto& data = pinocchioInterfacePtr_->getData();
+  assert(info_.stateDim == state.rows());
+  assert(info_.inputDim == input.rows());
+
+  updateBaseKinematics(state);
+
+  vector_t f(info_.stateDim);
+
+  // normalized centroidal momentum rate
+  const Vector3 gravityVector(0.0, 0.0, -9.81);
+  Vector3 force = info_.robotMass * gravityVector;
+  Vector3 torque = Vector3::Zero();
+  for (size_t i = 0; i < info_.numThreeDofContacts + info_.numSixDofContacts; i++) {
+    const Vector3 contactForce = centroidal_model::getContactForces(input, i, info_);
+    const Vector3 positionComToContactPoint = data.oMf[info_.endEffectorFrameIndices[i]].translation() - comPositionInWorld_;
+    force += contactForce;
+    torque.noalias() += positionComToContactPoint.cross(contactForce);
+    if (i >= info_.numThreeDofContacts) {
+      torque += centroidal_model::getContactTorques(input, i, info_);
+    }
+  }
+  f.head<3>() = force / info_.robotMass;
+  f.segment<3>(3) = torque / info_.robotMass;
+
+  // base velocity
+  const Vector3 normalizedLinearMomentum = centroidal_model::getNormalizedMomentum(state, info_).head<3>();
+  f.segment<3>(6) = normalizedLinearMomentum - comToBasePositionInWorld_.cross(angularVelocityInWorld_);
+  f.segment<3>(9).noalias() = mappingZyxInverse_ * angularVelocityInWorld_;
+
+  // joint velocities
+  f.tail(info_.actuatedDofNum) = centroidal_model::getJointVelocities(input, info_).head(info_.actuatedDofNum);
+
+  return f;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation PinocchioSingleRigidBodyDynamics::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                           const vector_t& input) {
+  const auto& model = pinocchioInterfacePtr_->getModel();
+  const auto& data = pinocchioInterfacePtr_->getData();
+  const size_t nq = info_.generalizedCoordinatesNum;
+  const scalar_t mass = info_.robotMass;
+
+  auto dynamics = ocs2::VectorFunctionLinearApproximation::Zero(info_.stateDim, info_.stateDim, info_.inputDim);
+  dynamics.f = getValue(time, state, input);  // updates the base kinematics
+
+  // Momentum rates: contact points move with the legs and the CoM moves with the base, i.e. J_com = [I, S(r) * T, 0]
+  const Matrix3 comToBaseSkew = skewSymmetricMatrix(comToBasePositionInWorld_);
+  jointJacobian_.setZero(6, nq);
+  for (size_t i = 0; i < info_.numThreeDofContacts + info_.numSixDofContacts; i++) {
+    const size_t frameIndex = info_.endEffectorFrameIndices[i];
+    const auto jointIndex = model.frames[frameIndex].parent;
+    const Vector3 contactPosition = data.oMf[frameIndex].translation();
+
+    // translational Jacobian of the contact point, shifted from its parent joint
+    pinocchio::getJointJacobian(model, data, jointIndex, pinocchio::LOCAL_WORLD_ALIGNED, jointJacobian_);
+    contactJacobian_ = jointJacobian_.topRows<3>();
+    contactJacobian_.noalias() -= skewSymmetricMatrix(Vector3(contactPosition - data.oMi[jointIndex].translation())) *
+                                  jointJacobian_.bottomRows<3>();
+    contactJacobian_.leftCols<3>().diagonal().array() -= 1.0;
+    contactJacobian_.middleCols<3>(3).noalias() -= comToBaseSkew * mappingZyx_;
+
+    const Vector3 contactForce = centroidal_model::getContactForces(input, i, info_);
+    dynamics.dfdx.block(3, 6, 3, nq).noalias() -= skewSymmetricMatrix(Vector3(contactForce / mass)) * contactJacobian_;
+
+    const size_t numThreeDofContacts = info_.numThreeDofContacts;
+    const size_t inputIndex = (i < numThreeDofContacts) ? 3 * i : 3 * numThreeDofContacts + 6 * (i - numThreeDofContacts);
+    dynamics.dfdu.block<3, 3>(0, inputIndex).diagonal().array() = 1.0 / mass;
+    dynamics.dfdu.block<3, 3>(3, inputIndex) = skewSymmetricMatrix(Vector3((contactPosition - comPositionInWorld_) / mass));
+    if (i >= info_.numThreeDofContacts) {
+      dynamics.dfdu.block<3, 3>(3, inputIndex + 3).diagonal().array() = 1.0 / mass;
+    }
+  }
+
+  // Base velocity w.r.t. the normalized momentum
+  const Matrix3 angularVelocityDerivative = mass * inertiaInverseInWorld_;
+  dynamics.dfdx.block<3, 3>(6, 0).setIdentity();
+  dynamics.dfdx.block<3, 3>(6, 3).noalias() = -comToBaseSkew * angularVelocityDerivative;
+  dynamics.dfdx.block<3, 3>(9, 3).noalias() = mappingZyxInverse_ * angularVelocityDerivative;
+
+  // Base velocity w.r.t. the base orientation
+  const Vector3 eulerAnglesZyx = centroidal_model::getBasePose(state, info_).tail<3>();
+  const Vector3 eulerAnglesZyxDerivative = dynamics.f.segment<3>(9);
+  const Vector3 normalizedAngularMomentum = centroidal_model::getNormalizedMomentum(state, info_).tail<3>();
+  const auto dR = getRotationMatrixZyxGradient(eulerAnglesZyx);
+  const auto dT = getMappingZyxGradient(eulerAnglesZyx);
+  for (size_t j = 0; j < 3; j++) {
+    const Matrix3 dInertiaInverse = dR[j] * inertiaNominalInverse_ * rotationBaseToWorld_.transpose();
+    const Vector3 dAngularVelocity = mass * (dInertiaInverse + dInertiaInverse.transpose()) * normalizedAngularMomentum;
+    const Vector3 dComToBasePosition = dR[j] * info_.comToBasePositionNominal;
+    dynamics.dfdx.block<3, 1>(6, 9 + j) =
+        -dComToBasePosition.cross(angularVelocityInWorld_) - comToBasePositionInWorld_.cross(dAngularVelocity);
+    dynamics.dfdx.block<3, 1>(9, 9 + j).noalias() = mappingZyxInverse_ * (dAngularVelocity - dT[j] * eulerAnglesZyxDerivative);
+  }
+
+  // Joint velocities
+  dynamics.dfdu.bottomRightCorner(info_.actuatedDofNum, info_.actuatedDofNum).setIdentity();
+
+  return dynamics;
+}
+
+}  // namespace ocs2
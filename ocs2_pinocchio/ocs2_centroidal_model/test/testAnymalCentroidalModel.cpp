@@ -32,11 +32,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/multibody/data.hpp>
 #include <pinocchio/multibody/model.hpp>
 
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "ocs2_centroidal_model/CentroidalModelRbdConversions.h"
 #include "ocs2_centroidal_model/FactoryFunctions.h"
 #include "ocs2_centroidal_model/ModelHelperFunctions.h"
 #include "ocs2_centroidal_model/PinocchioCentroidalDynamics.h"
 #include "ocs2_centroidal_model/PinocchioCentroidalDynamicsAD.h"
+#include "ocs2_centroidal_model/PinocchioSingleRigidBodyDynamics.h"
 
 #include "ocs2_centroidal_model/test/definitions.h"
 
@@ -123,6 +126,116 @@ TEST_P(TestAnymalCentroidalModel, dynamis_flowMap) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, dynamics_linearApproximationBenchmark) {
+  const CentroidalModelType type = GetParam();
+  auto mappingPtr = createMapping(type);
+  const auto& info = mappingPtr->getCentroidalModelInfo();
+
+  PinocchioCentroidalDynamics anymalDynamics(createInfo(type));
+  anymalDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  const std::string modelName = "TestAnymal" + toString(type) + "Ad";
+  PinocchioCentroidalDynamicsAD anymalDynamicsAd(*pinocchioInterfacePtr, createInfo(type), modelName);
+
+  benchmark::RepeatedTimer analyticalTimer;
+  benchmark::RepeatedTimer mappingTimer;
+  benchmark::RepeatedTimer cppAdTimer;
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t time = 0.0;
+    const vector_t state = 10.0 * vector_t::Random(anymal::STATE_DIM);
+    const vector_t input = 10000.0 * vector_t::Random(anymal::INPUT_DIM);
+
+    const vector_t qPinocchio = mappingPtr->getPinocchioJointPosition(state);
+    updateCentroidalDynamics(*pinocchioInterfacePtr, info, qPinocchio);
+    const vector_t vPinocchio = mappingPtr->getPinocchioJointVelocity(state, input);
+    updateCentroidalDynamicsDerivatives(*pinocchioInterfacePtr, info, qPinocchio, vPinocchio);
+
+    analyticalTimer.startTimer();
+    const auto linearApproximation = anymalDynamics.getLinearApproximation(time, state, input);
+    analyticalTimer.endTimer();
+
+    // the generic path through the state-input mapping
+    mappingTimer.startTimer();
+    matrix_t dfdq = matrix_t::Zero(info.stateDim, info.generalizedCoordinatesNum);
+    matrix_t dfdv = matrix_t::Zero(info.stateDim, info.generalizedCoordinatesNum);
+    dfdq.topRows<6>() = linearApproximation.dfdx.block(0, 6, 6, info.generalizedCoordinatesNum);
+    dfdv.bottomRows(info.generalizedCoordinatesNum).setIdentity();
+    matrix_t dfdx, dfdu;
+    std::tie(dfdx, dfdu) = mappingPtr->getOcs2Jacobian(state, dfdq, dfdv);
+    mappingTimer.endTimer();
+    dfdu.topRows<6>() += linearApproximation.dfdu.topRows<6>();
+
+    cppAdTimer.startTimer();
+    const auto linearApproximationAd = anymalDynamicsAd.getLinearApproximation(time, state, input);
+    cppAdTimer.endTimer();
+
+    EXPECT_TRUE(dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(dfdu.isApprox(linearApproximation.dfdu, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(linearApproximationAd.dfdu.isApprox(linearApproximation.dfdu, tol));
+  }
+
+  std::cerr << "[" << toString(type) << "] linear approximation, analytical: " << analyticalTimer.getAverageInMilliseconds()
+            << " [ms], mapping of the generic jacobians: " << mappingTimer.getAverageInMilliseconds()
+            << " [ms], CppAD: " << cppAdTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, singleRigidBodyDynamics) {
+  const CentroidalModelType type = GetParam();
+  if (type != CentroidalModelType::SingleRigidBodyDynamics) {
+    EXPECT_THROW(PinocchioSingleRigidBodyDynamics dynamics(createInfo(type)), std::runtime_error);
+    return;
+  }
+
+  auto mappingPtr = createMapping(type);
+  const auto& info = mappingPtr->getCentroidalModelInfo();
+
+  PinocchioCentroidalDynamics anymalDynamics(createInfo(type));
+  anymalDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  PinocchioSingleRigidBodyDynamics anymalSrbdDynamics(createInfo(type));
+  anymalSrbdDynamics.setPinocchioInterface(*pinocchioInterfacePtr);
+
+  benchmark::RepeatedTimer centroidalTimer;
+  benchmark::RepeatedTimer srbdTimer;
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t time = 0.0;
+    const vector_t state = 10.0 * vector_t::Random(anymal::STATE_DIM);
+    const vector_t input = 10000.0 * vector_t::Random(anymal::INPUT_DIM);
+
+    const vector_t qPinocchio = mappingPtr->getPinocchioJointPosition(state);
+    updateCentroidalDynamics(*pinocchioInterfacePtr, info, qPinocchio);
+
+    const auto stateDerivative = anymalDynamics.getValue(time, state, input);
+    const auto stateDerivativeSrbd = anymalSrbdDynamics.getValue(time, state, input);
+
+    const vector_t vPinocchio = mappingPtr->getPinocchioJointVelocity(state, input);
+    updateCentroidalDynamicsDerivatives(*pinocchioInterfacePtr, info, qPinocchio, vPinocchio);
+
+    centroidalTimer.startTimer();
+    const auto linearApproximation = anymalDynamics.getLinearApproximation(time, state, input);
+    centroidalTimer.endTimer();
+
+    srbdTimer.startTimer();
+    const auto linearApproximationSrbd = anymalSrbdDynamics.getLinearApproximation(time, state, input);
+    srbdTimer.endTimer();
+
+    EXPECT_TRUE(stateDerivativeSrbd.isApprox(stateDerivative, tol));
+    EXPECT_TRUE(linearApproximationSrbd.f.isApprox(linearApproximation.f, tol));
+    EXPECT_TRUE(linearApproximationSrbd.dfdx.isApprox(linearApproximation.dfdx, tol));
+    EXPECT_TRUE(linearApproximationSrbd.dfdu.isApprox(linearApproximation.dfdu, tol));
+  }
+
+  std::cerr << "[" << toString(type) << "] linear approximation, centroidal dynamics: " << centroidalTimer.getAverageInMilliseconds()
+            << " [ms], single rigid body dynamics: " << srbdTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/PreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_pinocchio_interface/PinocchioStateInputMapping.h>
+
+namespace ocs2 {
+
+/**
+ * Pre-computation of the pinocchio kinematics shared by all terms of a node.
+ *
+ * The terms declare the kinematics they need through addRequirement(). On each request, only the union of the kinematics required by
+ * the requested terms is computed on the pinocchio data. The computed kinematics are tracked for the current joint configuration, so
+ * a following request on the same configuration (e.g., an approximation after an evaluation) only computes the missing quantities.
+ *
+ * @note The terms should only read the pinocchio data of the pre-computation; otherwise the tracked kinematics are invalid.
+ */
+class PinocchioPreComputation : public PreComputation {
+ public:
+  /** Kinematic quantities computed on the pinocchio data. They can be combined as a bitmask. */
+  enum Kinematics : unsigned {
+    ForwardKinematics = 1,  // pinocchio::forwardKinematics(model, data, q)
+    FramePlacements = 2,    // pinocchio::updateFramePlacements(model, data)
+    JointJacobians = 4,     // pinocchio::computeJointJacobians(model, data)
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] mapping: mapping from OCS2 state to pinocchio joint positions
+   */
+  PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping);
+
+  ~PinocchioPreComputation() override = default;
+  PinocchioPreComputation* clone() const override;
+
+  /**
+   * Declares the kinematics needed by a type of terms.
+   *
+   * @param [in] terms: the term types which need the kinematics, e.g. Request::Cost + Request::SoftConstraint
+   * @param [in] valueKinematics: bitmask of the kinematics needed to evaluate the terms
+   * @param [in] approximationKinematics: bitmask of the additional kinematics needed to approximate the terms
+   */
+  void addRequirement(RequestSet terms, unsigned valueKinematics, unsigned approximationKinematics);
+
+  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) override;
+  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
+
+  /** Get the bitmask of the kinematics that are up to date on the pinocchio data */
+  unsigned getComputedKinematics() const { return computedKinematics_; }
+
+  PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
+  const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
+
+ protected:
+  PinocchioPreComputation(const PinocchioPreComputation& rhs);
+
+ private:
+  struct Requirement {
+    RequestSet terms;
+    unsigned valueKinematics;
+    unsigned approximationKinematics;
+  };
+
+  /** Computes the kinematics required by request, skipping the ones that are already computed for x */
+  void updateKinematics(RequestSet request, const vector_t& x);
+
+  PinocchioInterface pinocchioInterface_;
+  std::unique_ptr<PinocchioStateInputMapping<scalar_t>> mappingPtr_;
+  std::vector<Requirement> requirements_;
+
+  vector_t jointPositions_;
+  unsigned computedKinematics_ = 0;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include "ocs2_pinocchio_interface/PinocchioPreComputation.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(PinocchioInterface pinocchioInterface,
+                                                 const PinocchioStateInputMapping<scalar_t>& mapping)
+    : pinocchioInterface_(std::move(pinocchioInterface)), mappingPtr_(mapping.clone()) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(const PinocchioPreComputation& rhs)
+    : PreComputation(rhs),
+      pinocchioInterface_(rhs.pinocchioInterface_),
+      mappingPtr_(rhs.mappingPtr_->clone()),
+      requirements_(rhs.requirements_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation* PinocchioPreComputation::clone() const {
+  return new PinocchioPreComputation(*this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::addRequirement(RequestSet terms, unsigned valueKinematics, unsigned approximationKinematics) {
+  requirements_.push_back({terms, valueKinematics, approximationKinematics});
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  updateKinematics(request, x);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+  updateKinematics(request, x);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+  updateKinematics(request, x);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::updateKinematics(RequestSet request, const vector_t& x) {
+  unsigned requiredKinematics = 0;
+  for (const auto& requirement : requirements_) {
+    if (request.containsAny(requirement.terms)) {
+      requiredKinematics |= requirement.valueKinematics;
+      if (request.contains(Request::Approximation)) {
+        requiredKinematics |= requirement.approximationKinematics;
+      }
+    }
+  }
+  if (requiredKinematics == 0) {
+    return;
+  }
+
+  const vector_t q = mappingPtr_->getPinocchioJointPosition(x);
+  if (q.size() != jointPositions_.size() || q != jointPositions_) {
+    jointPositions_ = q;
+    computedKinematics_ = 0;
+  }
+
+  const unsigned missingKinematics = requiredKinematics & ~computedKinematics_;
+  if (missingKinematics == 0) {
+    return;
+  }
+
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+
+  // all other quantities are computed from the joint placements
+  if ((computedKinematics_ & ForwardKinematics) == 0) {
+    pinocchio::forwardKinematics(model, data, jointPositions_);
+    computedKinematics_ |= ForwardKinematics;
+  }
+  if ((missingKinematics & FramePlacements) != 0) {
+    pinocchio::updateFramePlacements(model, data);
+    computedKinematics_ |= FramePlacements;
+  }
+  if ((missingKinematics & JointJacobians) != 0) {
+    pinocchio::computeJointJacobians(model, data);
+    computedKinematics_ |= JointJacobians;
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,124 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
+#include <ocs2_pinocchio_interface/urdf.h>
+
+#include <gtest/gtest.h>
+
+#include "ManipulatorArmUrdf.h"
+
+namespace {
+
+class IdentityMapping final : public ocs2::PinocchioStateInputMapping<ocs2::scalar_t> {
+ public:
+  IdentityMapping() = default;
+  ~IdentityMapping() override = default;
+  IdentityMapping* clone() const override { return new IdentityMapping(*this); }
+
+  vector_t getPinocchioJointPosition(const vector_t& state) const override { return state; }
+  vector_t getPinocchioJointVelocity(const vector_t& state, const vector_t& input) const override { return input; }
+  std::pair<matrix_t, matrix_t> getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const override {
+    return {Jq, Jv};
+  }
+};
+
+}  // unnamed namespace
+
+class TestPinocchioPreComputation : public ::testing::Test {
+ public:
+  using PinocchioPreComputation = ocs2::PinocchioPreComputation;
+
+  TestPinocchioPreComputation()
+      : pinocchioInterface(ocs2::getPinocchioInterfaceFromUrdfString(manipulatorArmUrdf)),
+        preComputation(pinocchioInterface, IdentityMapping()) {
+    x.resize(6);
+    x << 2.5, -1.0, 1.5, 0.0, 1.0, 0.0;
+    u.setZero(6);
+
+    preComputation.addRequirement(ocs2::Request::SoftConstraint,
+                                  PinocchioPreComputation::ForwardKinematics | PinocchioPreComputation::FramePlacements,
+                                  PinocchioPreComputation::JointJacobians);
+  }
+
+  ocs2::vector_t x;
+  ocs2::vector_t u;
+  ocs2::PinocchioInterface pinocchioInterface;
+  PinocchioPreComputation preComputation;
+};
+
+TEST_F(TestPinocchioPreComputation, onlyRequiredTerms) {
+  preComputation.request(ocs2::Request::Cost + ocs2::Request::Approximation, 0.0, x, u);
+  EXPECT_EQ(preComputation.getComputedKinematics(), 0u);
+
+  preComputation.request(ocs2::Request::SoftConstraint, 0.0, x, u);
+  EXPECT_EQ(preComputation.getComputedKinematics(), PinocchioPreComputation::ForwardKinematics | PinocchioPreComputation::FramePlacements);
+
+  preComputation.request(ocs2::Request::SoftConstraint + ocs2::Request::Approximation, 0.0, x, u);
+  EXPECT_EQ(preComputation.getComputedKinematics(), PinocchioPreComputation::ForwardKinematics |
+                                                        PinocchioPreComputation::FramePlacements | PinocchioPreComputation::JointJacobians);
+
+  // a new configuration invalidates the computed kinematics
+  preComputation.requestFinal(ocs2::Request::SoftConstraint, 1.0, ocs2::vector_t::Zero(6));
+  EXPECT_EQ(preComputation.getComputedKinematics(), PinocchioPreComputation::ForwardKinematics | PinocchioPreComputation::FramePlacements);
+}
+
+TEST_F(TestPinocchioPreComputation, kinematics) {
+  const auto& model = pinocchioInterface.getModel();
+  auto& data = pinocchioInterface.getData();
+  pinocchio::forwardKinematics(model, data, x);
+  pinocchio::updateFramePlacements(model, data);
+  pinocchio::computeJointJacobians(model, data);
+
+  // the value request first, then the approximation on the same configuration
+  preComputation.request(ocs2::Request::SoftConstraint, 0.0, x, u);
+  preComputation.request(ocs2::Request::SoftConstraint + ocs2::Request::Approximation, 0.0, x, u);
+  const auto& preComputedData = preComputation.getPinocchioInterface().getData();
+
+  for (int i = 0; i < model.njoints; i++) {
+    EXPECT_TRUE(preComputedData.oMi[i].isApprox(data.oMi[i]));
+  }
+  for (int i = 0; i < model.nframes; i++) {
+    EXPECT_TRUE(preComputedData.oMf[i].isApprox(data.oMf[i]));
+  }
+  EXPECT_TRUE(preComputedData.J.isApprox(data.J));
+}
+
+TEST_F(TestPinocchioPreComputation, clone) {
+  std::unique_ptr<PinocchioPreComputation> clonePtr(preComputation.clone());
+  clonePtr->request(ocs2::Request::SoftConstraint, 0.0, x, u);
+  EXPECT_EQ(clonePtr->getComputedKinematics(), PinocchioPreComputation::ForwardKinematics | PinocchioPreComputation::FramePlacements);
+  EXPECT_EQ(preComputation.getComputedKinematics(), 0u);
+}
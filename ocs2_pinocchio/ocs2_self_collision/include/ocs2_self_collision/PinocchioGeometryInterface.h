@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Forward declaration of pinocchio geometry types */
 namespace pinocchio {
 struct GeometryModel;
+struct GeometryData;
 }  // namespace pinocchio
 
 namespace ocs2 {
@@ -77,6 +78,22 @@ class PinocchioGeometryInterface final {
    */
   std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
 
+  /**
+   * Compute collision pair distances into a caller-owned geometry data, skipping the exact query of distant pairs.
+   * A pair is culled when the lower bound of its distance, computed from the bounding spheres of the two objects, is larger
+   * than the activation distance. For a culled pair, the min_distance field holds this lower bound and the nearest points are
+   * not valid.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] activationDistance: distance beyond which a collision pair is not computed exactly.
+   * @param [in, out] geometryData: geometry data of the geometry model. It should be constructed from getGeometryModel().
+   * @param [out] isCulled: flags the collision pairs which are culled by the bounding sphere test.
+   */
+  void computeDistances(const PinocchioInterface& pinocchioInterface, scalar_t activationDistance, pinocchio::GeometryData& geometryData,
+                        std::vector<bool>& isCulled) const;
+
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
 
@@ -87,6 +104,7 @@ class PinocchioGeometryInterface final {
  private:
   // Construction helpers
   void buildGeomFromPinocchioInterface(const PinocchioInterface& pinocchioInterface, pinocchio::GeometryModel& geomModel);
+  void computeBoundingVolumes();
   void addCollisionObjectPairs(const PinocchioInterface& pinocchioInterface,
                                const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs);
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <memory>
+
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 #include <ocs2_self_collision/PinocchioGeometryInterface.h>
 
@@ -43,16 +46,37 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] activationDistance: distance beyond which a collision pair is inactive. The exact distance query of a pair is skipped
+   *                                 when its bounding spheres are further apart than this distance. The pair then reports the distance
+   *                                 between the bounding spheres (a conservative lower bound) and a zero gradient. By default, all
+   *                                 pairs are computed exactly.
+   * @param [in] maxWarmStartTranslation: The distance queries are warm started from the previous query of this instance if no joint
+   *                                      has translated more than this distance [m] since then.
+   * @param [in] maxWarmStartRotation: The distance queries are warm started from the previous query of this instance if no joint
+   *                                   has rotated more than this angle [rad] since then.
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(), scalar_t maxWarmStartTranslation = 0.05,
+                scalar_t maxWarmStartRotation = 0.1);
+
+  /** Destructor */
+  ~SelfCollision();
+
+  /** Copy constructor */
+  SelfCollision(const SelfCollision& rhs);
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
 
+  /** Get the number of distance queries of this instance which were warm started from their previous query */
+  size_t getNumWarmStartedQueries() const { return numWarmStartedQueries_; }
+
   /**
    * Evaluate the distance violation
    * This method computes the distance results of all collision pairs through PinocchioGeometryInterface
    * and compare each of them with the specified minimum distance.
+   * The distance results are cached, so a following getLinearApproximation() on the same configuration does not query them again.
+   * The distance queries are warm started from the previous query of this instance if the joints moved little since then.
    *
    * @note Requires updated forwardKinematics() on pinocchioInterface.
    *
@@ -74,8 +98,23 @@ class SelfCollision {
   std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface) const;
 
  private:
+  /** Updates the distance results if the joint placements have changed since the last query. */
+  void updateDistances(const PinocchioInterface& pinocchioInterface) const;
+
+  /** Whether no joint has moved more than the warm start thresholds between the two joint placements. */
+  bool isWithinWarmStartRegion(const vector_t& jointPlacements, const vector_t& previousJointPlacements) const;
+
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  scalar_t activationDistance_;
+  scalar_t maxWarmStartTranslation_;
+  scalar_t maxWarmStartRotation_;
+
+  // persistent query workspace
+  mutable std::unique_ptr<pinocchio::GeometryData> geometryDataPtr_;
+  mutable std::vector<bool> isCulled_;
+  mutable vector_t cachedJointPlacements_;
+  mutable size_t numWarmStartedQueries_ = 0;
 };
 
 }  // namespace ocs2
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
 #include <memory>
 
 #include <ocs2_core/constraint/StateConstraint.h>
@@ -49,9 +50,13 @@ class SelfCollisionConstraint : public StateConstraint {
    * @param [in] mapping: The pinocchio mapping from pinocchio states to ocs2 states.
    * @param [in] pinocchioGeometryInterface: Pinocchio geometry interface of the robot model.
    * @param [in] minimumDistance: The minimum allowed distance between collision pairs.
+   * @param [in] activationDistance: The distance beyond which a collision pair is inactive. See SelfCollision for details.
+   * @param [in] maxWarmStartTranslation: The joint translation [m] up to which the distance queries are warm started.
+   * @param [in] maxWarmStartRotation: The joint rotation [rad] up to which the distance queries are warm started.
    */
   SelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping, PinocchioGeometryInterface pinocchioGeometryInterface,
-                          scalar_t minimumDistance);
+                          scalar_t minimumDistance, scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(),
+                          scalar_t maxWarmStartTranslation = 0.05, scalar_t maxWarmStartRotation = 0.1);
 
   ~SelfCollisionConstraint() override = default;
 
@@ -51,6 +51,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
+  computeBoundingVolumes();
 }
 
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
@@ -61,6 +62,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
+  computeBoundingVolumes();
 }
 
 /******************************************************************************************************/
@@ -75,6 +77,38 @@ std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistanc
   return std::move(geometryData.distanceResults);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface, scalar_t activationDistance,
+                                                  pinocchio::GeometryData& geometryData, std::vector<bool>& isCulled) const {
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  const auto& geometryModel = *geometryModelPtr_;
+
+  pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), geometryModel, geometryData);
+
+  const size_t numCollisionPairs = geometryModel.collisionPairs.size();
+  isCulled.resize(numCollisionPairs);
+  for (size_t i = 0; i < numCollisionPairs; ++i) {
+    const auto& collisionPair = geometryModel.collisionPairs[i];
+    const auto& geometry1 = *geometryModel.geometryObjects[collisionPair.first].geometry;
+    const auto& geometry2 = *geometryModel.geometryObjects[collisionPair.second].geometry;
+
+    // broad phase: the distance between the bounding spheres is a lower bound of the distance between the objects
+    const vector3_t center1 = geometryData.oMg[collisionPair.first].act(geometry1.aabb_center);
+    const vector3_t center2 = geometryData.oMg[collisionPair.second].act(geometry2.aabb_center);
+    const scalar_t distanceLowerBound = (center2 - center1).norm() - geometry1.aabb_radius - geometry2.aabb_radius;
+
+    isCulled[i] = distanceLowerBound > activationDistance;
+    if (isCulled[i]) {
+      geometryData.distanceResults[i].clear();
+      geometryData.distanceResults[i].min_distance = distanceLowerBound;
+    } else {
+      pinocchio::computeDistance(geometryModel, geometryData, i);
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -101,6 +135,16 @@ void PinocchioGeometryInterface::buildGeomFromPinocchioInterface(const Pinocchio
 
   pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfAsStringStream, pinocchio::COLLISION, geomModel);
 }
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeBoundingVolumes() {
+  // the local bounding box and its bounding sphere (aabb_center, aabb_radius) are used by the broad phase of computeDistances()
+  for (auto& geometryObject : geometryModelPtr_->geometryObjects) {
+    geometryObject.geometry->computeLocalAABB();
+  }
+}
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
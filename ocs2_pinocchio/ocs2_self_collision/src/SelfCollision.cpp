@@ -29,6 +29,10 @@
 
 #include <pinocchio/fwd.hpp>
 
+#include <algorithm>
+#include <cmath>
+
+#include <pinocchio/algorithm/geometry.hpp>
 #include <pinocchio/algorithm/jacobian.hpp>
 #include <pinocchio/multibody/geometry.hpp>
 
@@ -42,14 +46,91 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, scalar_t activationDistance,
+                             scalar_t maxWarmStartTranslation, scalar_t maxWarmStartRotation)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance),
+      maxWarmStartTranslation_(maxWarmStartTranslation),
+      maxWarmStartRotation_(maxWarmStartRotation),
+      geometryDataPtr_(new pinocchio::GeometryData(pinocchioGeometryInterface_.getGeometryModel())) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollision::~SelfCollision() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollision::SelfCollision(const SelfCollision& rhs)
+    : pinocchioGeometryInterface_(rhs.pinocchioGeometryInterface_),
+      minimumDistance_(rhs.minimumDistance_),
+      activationDistance_(rhs.activationDistance_),
+      maxWarmStartTranslation_(rhs.maxWarmStartTranslation_),
+      maxWarmStartRotation_(rhs.maxWarmStartRotation_),
+      geometryDataPtr_(new pinocchio::GeometryData(pinocchioGeometryInterface_.getGeometryModel())) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SelfCollision::updateDistances(const PinocchioInterface& pinocchioInterface) const {
+  // the geometry placements, hence the distances, are fully determined by the joint placements
+  const auto& oMi = pinocchioInterface.getData().oMi;
+  vector_t jointPlacements(12 * oMi.size());
+  for (size_t j = 0; j < oMi.size(); ++j) {
+    jointPlacements.segment<3>(12 * j) = oMi[j].translation();
+    jointPlacements.segment<9>(12 * j + 3) = Eigen::Map<const Eigen::Matrix<scalar_t, 9, 1>>(oMi[j].rotation().data());
+  }
+
+  const bool hasCachedQuery = jointPlacements.size() == cachedJointPlacements_.size();
+  if (hasCachedQuery && jointPlacements == cachedJointPlacements_) {
+    return;
+  }
+
+  // Warm start GJK with the separating direction and support vertices of the previous query. Neighbouring nodes and consecutive
+  // iterations have nearly identical poses, unless the joints jumped since the previous query; then a cold start is preferred.
+  const bool warmStart = hasCachedQuery && isWithinWarmStartRegion(jointPlacements, cachedJointPlacements_);
+  if (warmStart) {
+    ++numWarmStartedQueries_;
+  }
+  auto& distanceRequests = geometryDataPtr_->distanceRequests;
+  for (auto& request : distanceRequests) {
+    request.enable_cached_gjk_guess = warmStart;
+  }
+
+  pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_, *geometryDataPtr_, isCulled_);
+  cachedJointPlacements_.swap(jointPlacements);
+
+  for (size_t i = 0; i < distanceRequests.size(); ++i) {
+    if (!isCulled_[i]) {
+      distanceRequests[i].updateGuess(geometryDataPtr_->distanceResults[i]);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SelfCollision::isWithinWarmStartRegion(const vector_t& jointPlacements, const vector_t& previousJointPlacements) const {
+  for (Eigen::Index j = 0; j < jointPlacements.size(); j += 12) {
+    const scalar_t translation = (jointPlacements.segment<3>(j) - previousJointPlacements.segment<3>(j)).norm();
+    // the Frobenius norm of the difference of two rotation matrices is 2 * sqrt(2) * sin(angle / 2)
+    const scalar_t rotationDifference = (jointPlacements.segment<9>(j + 3) - previousJointPlacements.segment<9>(j + 3)).norm();
+    const scalar_t rotation = 2.0 * std::asin(std::min(rotationDifference / (2.0 * std::sqrt(2.0)), scalar_t(1.0)));
+    if (translation > maxWarmStartTranslation_ || rotation > maxWarmStartRotation_) {
+      return false;
+    }
+  }
+  return true;
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  updateDistances(pinocchioInterface);
+  const auto& distanceArray = geometryDataPtr_->distanceResults;
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -63,7 +144,8 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  updateDistances(pinocchioInterface);
+  const auto& distanceArray = geometryDataPtr_->distanceResults;
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
@@ -76,6 +158,12 @@ std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const Pinocc
     // Distance violation
     f[i] = distanceArray[i].min_distance - minimumDistance_;
 
+    // Culled pairs are inactive and have no nearest points
+    if (isCulled_[i]) {
+      dfdq.row(i).setZero();
+      continue;
+    }
+
     // Jacobian calculation
     const auto& collisionPair = geometryModel.collisionPairs[i];
     const auto& joint1 = geometryModel.geometryObjects[collisionPair.first].parentJoint;
@@ -36,9 +36,12 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 SelfCollisionConstraint::SelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping,
-                                                 PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
+                                                 PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                                                 scalar_t activationDistance, scalar_t maxWarmStartTranslation,
+                                                 scalar_t maxWarmStartRotation)
     : StateConstraint(ConstraintOrder::Linear),
-      selfCollision_(std::move(pinocchioGeometryInterface), minimumDistance),
+      selfCollision_(std::move(pinocchioGeometryInterface), minimumDistance, activationDistance, maxWarmStartTranslation,
+                     maxWarmStartRotation),
       mappingPtr_(mapping.clone()) {}
 
 /******************************************************************************************************/
@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_sphere_approximation/PinocchioSphereInterface.h>
+
+namespace ocs2 {
+
+/**
+ * Self-collision distances between the collision spheres of PinocchioSphereInterface.
+ *
+ * The distance of each sphere pair is the distance between the sphere centers minus the sum of the radii. Both the distances and their
+ * Jacobians are computed in closed form, so no narrow-phase distance query is needed.
+ */
+class SphereSelfCollision {
+ public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using matrix3x_t = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] pinocchioSphereInterface: pinocchio sphere interface of the robot model
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] collisionLinkPairs: List of collision link pairs by name. All sphere combinations of the two links are added. If empty, all
+   *                                 pairs of the collision links of pinocchioSphereInterface are used.
+   * @param [in] minimumDistance: minimum allowed distance between each sphere pair
+   * @param [in] pruneAdjacentLinks: whether to ignore the link pairs which are directly connected by a joint
+   */
+  SphereSelfCollision(PinocchioSphereInterface pinocchioSphereInterface, const PinocchioInterface& pinocchioInterface,
+                      const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs, scalar_t minimumDistance,
+                      bool pruneAdjacentLinks = true);
+
+  /** Get the number of sphere pairs */
+  size_t getNumCollisionPairs() const { return sphereIds1_.size(); }
+
+  /** Get the pinocchio sphere interface */
+  const PinocchioSphereInterface& getPinocchioSphereInterface() const { return pinocchioSphereInterface_; }
+
+  /**
+   * Evaluate the distance violation
+   *
+   * @note Requires updated forwardKinematics() on pinocchioInterface.
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @return: The differences between the distance of each sphere pair and the minimum distance
+   */
+  vector_t getValue(const PinocchioInterface& pinocchioInterface) const;
+
+  /**
+   * Evaluate the linear approximation of the distance function with respect to the pinocchio generalized coordinates
+   *
+   * @note Requires updated forwardKinematics() and computeJointJacobians() on pinocchioInterface.
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @return: The pair of the distance violation and the first derivative of the distance against q
+   */
+  std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface) const;
+
+ private:
+  /** Stacks the center differences of the sphere pairs column-wise in centerDifferences_ and their norms in centerDistances_ */
+  void updateCenterDistances(const std::vector<vector3_t>& sphereCenters) const;
+
+  PinocchioSphereInterface pinocchioSphereInterface_;
+  size_array_t sphereJointIds_;  // parent joint of each sphere
+  size_array_t sphereIds1_;
+  size_array_t sphereIds2_;
+  vector_t distanceOffsets_;  // sum of the radii and the minimum distance of each sphere pair
+
+  // workspace, sized in the constructor
+  mutable matrix3x_t centerDifferences_;             // 3 x numPairs
+  mutable vector_t centerDistances_;                 // numPairs
+  mutable matrix_t jointJacobian_;                   // 6 x nv
+  mutable std::vector<matrix3x_t> sphereJacobians_;  // 3 x nv, one per sphere
+};
+
+}  // namespace ocs2
@@ -0,0 +1,158 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <limits>
+
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/multibody/geometry.hpp>
+
+#include <ocs2_robotic_tools/common/SkewSymmetricMatrix.h>
+
+#include "ocs2_sphere_approximation/SphereSelfCollision.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SphereSelfCollision::SphereSelfCollision(PinocchioSphereInterface pinocchioSphereInterface, const PinocchioInterface& pinocchioInterface,
+                                         const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
+                                         scalar_t minimumDistance, bool pruneAdjacentLinks)
+    : pinocchioSphereInterface_(std::move(pinocchioSphereInterface)) {
+  const auto& model = pinocchioInterface.getModel();
+  const auto& geometryModel = pinocchioSphereInterface_.getGeometryModel();
+  const auto& numSpheres = pinocchioSphereInterface_.getNumSpheres();
+  const auto& geomObjIds = pinocchioSphereInterface_.getGeomObjIds();
+  const auto& collisionLinkOfEachPrimitiveShape = pinocchioSphereInterface_.getCollisionLinkOfEachPrimitveShape();
+
+  // link and parent joint of each sphere
+  std::vector<std::string> sphereLinks;
+  for (size_t i = 0; i < pinocchioSphereInterface_.getNumPrimitiveShapes(); i++) {
+    const size_t jointId = geometryModel.geometryObjects[geomObjIds[i]].parentJoint;
+    sphereJointIds_.insert(sphereJointIds_.end(), numSpheres[i], jointId);
+    sphereLinks.insert(sphereLinks.end(), numSpheres[i], collisionLinkOfEachPrimitiveShape[i]);
+  }
+
+  std::vector<std::pair<std::string, std::string>> linkPairs = collisionLinkPairs;
+  if (linkPairs.empty()) {
+    const auto& collisionLinks = pinocchioSphereInterface_.getCollisionLinks();
+    for (size_t i = 0; i < collisionLinks.size(); i++) {
+      for (size_t j = i + 1; j < collisionLinks.size(); j++) {
+        linkPairs.emplace_back(collisionLinks[i], collisionLinks[j]);
+      }
+    }
+  }
+
+  const auto isAdjacent = [&](size_t jointId1, size_t jointId2) {
+    return jointId1 == jointId2 || model.parents[jointId1] == jointId2 || model.parents[jointId2] == jointId1;
+  };
+
+  std::vector<scalar_t> distanceOffsets;
+  const auto& sphereRadii = pinocchioSphereInterface_.getSphereRadii();
+  for (const auto& linkPair : linkPairs) {
+    for (size_t i = 0; i < sphereLinks.size(); i++) {
+      if (sphereLinks[i] != linkPair.first) {
+        continue;
+      }
+      for (size_t j = 0; j < sphereLinks.size(); j++) {
+        if (sphereLinks[j] != linkPair.second || (pruneAdjacentLinks && isAdjacent(sphereJointIds_[i], sphereJointIds_[j]))) {
+          continue;
+        }
+        sphereIds1_.push_back(i);
+        sphereIds2_.push_back(j);
+        distanceOffsets.push_back(sphereRadii[i] + sphereRadii[j] + minimumDistance);
+      }
+    }
+  }
+  distanceOffsets_ = Eigen::Map<const vector_t>(distanceOffsets.data(), distanceOffsets.size());
+
+  // workspace
+  centerDifferences_.resize(3, sphereIds1_.size());
+  centerDistances_.resize(sphereIds1_.size());
+  jointJacobian_.resize(6, model.nv);
+  sphereJacobians_.assign(sphereJointIds_.size(), matrix3x_t(3, model.nv));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SphereSelfCollision::updateCenterDistances(const std::vector<vector3_t>& sphereCenters) const {
+  for (size_t k = 0; k < sphereIds1_.size(); k++) {
+    centerDifferences_.col(k) = sphereCenters[sphereIds1_[k]] - sphereCenters[sphereIds2_[k]];
+  }
+  centerDistances_.noalias() = centerDifferences_.colwise().norm().transpose();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SphereSelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
+  const auto sphereCenters = pinocchioSphereInterface_.computeSphereCentersInWorldFrame(pinocchioInterface);
+  updateCenterDistances(sphereCenters);
+  return centerDistances_ - distanceOffsets_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, matrix_t> SphereSelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
+  const auto& model = pinocchioInterface.getModel();
+  const auto& data = pinocchioInterface.getData();
+
+  const auto sphereCenters = pinocchioSphereInterface_.computeSphereCentersInWorldFrame(pinocchioInterface);
+  updateCenterDistances(sphereCenters);
+
+  // Jacobians of the sphere centers: the joint jacobian translated to the center
+  for (size_t i = 0; i < sphereCenters.size(); i++) {
+    const size_t jointId = sphereJointIds_[i];
+    if (i == 0 || jointId != sphereJointIds_[i - 1]) {
+      jointJacobian_.setZero();
+      pinocchio::getJointJacobian(model, data, jointId, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, jointJacobian_);
+    }
+    const vector3_t centerOffset = sphereCenters[i] - data.oMi[jointId].translation();
+    sphereJacobians_[i] = jointJacobian_.topRows<3>();
+    sphereJacobians_[i].noalias() -= skewSymmetricMatrix(centerOffset) * jointJacobian_.bottomRows<3>();
+  }
+
+  matrix_t dfdq = matrix_t::Zero(sphereIds1_.size(), model.nq);
+  for (size_t k = 0; k < sphereIds1_.size(); k++) {
+    // the gradient of the distance is the unit vector between the centers; it is undefined for coincident centers
+    if (centerDistances_[k] > std::numeric_limits<scalar_t>::epsilon()) {
+      const vector3_t normal = centerDifferences_.col(k) / centerDistances_[k];
+      dfdq.row(k).noalias() = normal.transpose() * sphereJacobians_[sphereIds1_[k]];
+      dfdq.row(k).noalias() -= normal.transpose() * sphereJacobians_[sphereIds2_[k]];
+    }
+  }
+
+  return {centerDistances_ - distanceOffsets_, dfdq};
+}
+
+}  // namespace ocs2
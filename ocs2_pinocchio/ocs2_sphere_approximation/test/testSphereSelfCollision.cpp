@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <ocs2_pinocchio_interface/urdf.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sphere_approximation/SphereSelfCollision.h>
+
+#include <gtest/gtest.h>
+
+class TestSphereSelfCollision : public ::testing::Test {
+ public:
+  TestSphereSelfCollision() {
+    const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+    pinocchioInterfacePtr.reset(new ocs2::PinocchioInterface(ocs2::getPinocchioInterfaceFromUrdfFile(urdfFile)));
+    pinocchioSphereInterfacePtr.reset(new ocs2::PinocchioSphereInterface(*pinocchioInterfacePtr, {"ARM", "SHOULDER", "FOREARM", "WRIST_1"},
+                                                                         {0.20, 0.10, 0.05, 0.05}, 0.7));
+
+    q.setZero(pinocchioInterfacePtr->getModel().nq);
+    // taken form config/mpc/task.info
+    q(0) = 2.5;   // SH_ROT
+    q(1) = -1.0;  // SH_FLE
+    q(2) = 1.5;   // EL_FLE
+    q(3) = 0.0;   // EL_ROT
+    q(4) = 1.0;   // WR_FLE
+    q(5) = 0.0;   // WR_ROT
+  }
+
+  void updateKinematics(const ocs2::vector_t& jointPositions) {
+    const auto& model = pinocchioInterfacePtr->getModel();
+    auto& data = pinocchioInterfacePtr->getData();
+    pinocchio::forwardKinematics(model, data, jointPositions);
+    pinocchio::computeJointJacobians(model, data, jointPositions);
+  }
+
+  const ocs2::scalar_t minimumDistance = 0.05;
+  ocs2::vector_t q;  // pinocchio joint positions
+
+  std::unique_ptr<ocs2::PinocchioInterface> pinocchioInterfacePtr;
+  std::unique_ptr<ocs2::PinocchioSphereInterface> pinocchioSphereInterfacePtr;
+};
+
+TEST_F(TestSphereSelfCollision, testValue) {
+  const ocs2::SphereSelfCollision selfCollision(*pinocchioSphereInterfacePtr, *pinocchioInterfacePtr, {{"ARM", "FOREARM"}},
+                                                minimumDistance);
+  ASSERT_GT(selfCollision.getNumCollisionPairs(), 0u);
+
+  updateKinematics(q);
+  const auto sphereCenters = pinocchioSphereInterfacePtr->computeSphereCentersInWorldFrame(*pinocchioInterfacePtr);
+  const auto& sphereRadii = pinocchioSphereInterfacePtr->getSphereRadii();
+  const auto& links = pinocchioSphereInterfacePtr->getCollisionLinkOfEachPrimitveShape();
+  const auto& numSpheres = pinocchioSphereInterfacePtr->getNumSpheres();
+
+  // brute force distances of all ARM and FOREARM sphere pairs
+  std::vector<std::string> sphereLinks;
+  for (size_t i = 0; i < numSpheres.size(); i++) {
+    sphereLinks.insert(sphereLinks.end(), numSpheres[i], links[i]);
+  }
+  std::vector<ocs2::scalar_t> distances;
+  for (size_t i = 0; i < sphereCenters.size(); i++) {
+    for (size_t j = 0; j < sphereCenters.size(); j++) {
+      if (sphereLinks[i] == "ARM" && sphereLinks[j] == "FOREARM") {
+        distances.push_back((sphereCenters[i] - sphereCenters[j]).norm() - sphereRadii[i] - sphereRadii[j] - minimumDistance);
+      }
+    }
+  }
+
+  const ocs2::vector_t value = selfCollision.getValue(*pinocchioInterfacePtr);
+  ASSERT_EQ(static_cast<size_t>(value.size()), distances.size());
+  EXPECT_TRUE(value.isApprox(Eigen::Map<const ocs2::vector_t>(distances.data(), distances.size())));
+}
+
+TEST_F(TestSphereSelfCollision, testLinearApproximation) {
+  const ocs2::SphereSelfCollision selfCollision(*pinocchioSphereInterfacePtr, *pinocchioInterfacePtr, {}, minimumDistance);
+
+  updateKinematics(q);
+  ocs2::vector_t f;
+  ocs2::matrix_t dfdq;
+  std::tie(f, dfdq) = selfCollision.getLinearApproximation(*pinocchioInterfacePtr);
+  EXPECT_TRUE(f.isApprox(selfCollision.getValue(*pinocchioInterfacePtr)));
+
+  // central finite differences
+  const ocs2::scalar_t eps = 1e-6;
+  ocs2::matrix_t dfdqFiniteDifference(f.size(), q.size());
+  for (int i = 0; i < q.size(); i++) {
+    ocs2::vector_t qPlus = q;
+    qPlus(i) += eps;
+    updateKinematics(qPlus);
+    const ocs2::vector_t fPlus = selfCollision.getValue(*pinocchioInterfacePtr);
+
+    ocs2::vector_t qMinus = q;
+    qMinus(i) -= eps;
+    updateKinematics(qMinus);
+    const ocs2::vector_t fMinus = selfCollision.getValue(*pinocchioInterfacePtr);
+
+    dfdqFiniteDifference.col(i) = (fPlus - fMinus) / (2.0 * eps);
+  }
+
+  EXPECT_TRUE(dfdq.isApprox(dfdqFiniteDifference, 1e-5));
+}
+
+TEST_F(TestSphereSelfCollision, testAdjacentLinkPruning) {
+  const ocs2::SphereSelfCollision pruned(*pinocchioSphereInterfacePtr, *pinocchioInterfacePtr, {}, minimumDistance, true);
+  const ocs2::SphereSelfCollision unpruned(*pinocchioSphereInterfacePtr, *pinocchioInterfacePtr, {}, minimumDistance, false);
+  EXPECT_LT(pruned.getNumCollisionPairs(), unpruned.getNumCollisionPairs());
+}
@@ -29,7 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <string>
+#include <type_traits>
+#include <vector>
+
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -37,6 +42,53 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace pybind11::literals;
 
+namespace ocs2 {
+
+/**
+ * Creates a read-only NumPy view of C-contiguous data owned by a C++ object. The view keeps the owner alive, i.e., no data is copied and
+ * the owner is not destroyed as long as the view exists.
+ *
+ * @param [in] data: Pointer to the first element of the C-contiguous data.
+ * @param [in] shape: The shape of the view.
+ * @param [in] owner: The Python object of the data owner.
+ * @return The NumPy view.
+ */
+inline pybind11::array makeNumpyView(const scalar_t* data, const std::vector<pybind11::ssize_t>& shape, pybind11::handle owner) {
+  std::vector<pybind11::ssize_t> strides(shape.size());
+  pybind11::ssize_t stride = sizeof(scalar_t);
+  for (size_t i = shape.size(); i > 0; i--) {
+    strides[i - 1] = stride;
+    stride *= shape[i - 1];
+  }
+  pybind11::array view(pybind11::dtype::of<scalar_t>(), shape, strides, data, owner);
+  view.attr("setflags")("write"_a = false);
+  return view;
+}
+
+/** Whether the constructor of a robot's Python interface accepts the number of MPC instances of the batched API. */
+template <typename PyInterface>
+using has_batch_constructor = std::is_constructible<PyInterface, const std::string&, const std::string&, const std::string&, size_t>;
+
+/**
+ * Binds the constructor of a robot's Python interface which also accepts the number of MPC instances of the batched API. The batch
+ * solvers are only created if the optional argument numBatchInstances is set.
+ */
+template <typename PyInterface, typename std::enable_if<has_batch_constructor<PyInterface>::value, int>::type = 0>
+void bindConstructor(pybind11::class_<PyInterface>& pyClass) {
+  pyClass.def(pybind11::init<const std::string&, const std::string&, const std::string&, size_t>(), "taskFile"_a, "libFolder"_a,
+              "urdfFile"_a = "", "numBatchInstances"_a = 0);
+}
+
+/**
+ * Binds the constructor of a robot's Python interface without MPC instances for the batched API.
+ */
+template <typename PyInterface, typename std::enable_if<!has_batch_constructor<PyInterface>::value, int>::type = 0>
+void bindConstructor(pybind11::class_<PyInterface>& pyClass) {
+  pyClass.def(pybind11::init<const std::string&, const std::string&, const std::string&>(), "taskFile"_a, "libFolder"_a, "urdfFile"_a = "");
+}
+
+}  // namespace ocs2
+
 //! convenience macro to bind all kinds of std::vector-like types
 #define VECTOR_TYPE_BINDING(VTYPE, NAME)                                                    \
   pybind11::class_<VTYPE>(m, NAME)                                                          \
@@ -94,24 +146,71 @@ using namespace pybind11::literals;
         .def_readwrite("dfdxx", &ocs2::ScalarFunctionQuadraticApproximation::dfdxx)                                                        \
         .def_readwrite("dfdux", &ocs2::ScalarFunctionQuadraticApproximation::dfdux)                                                        \
         .def_readwrite("dfduu", &ocs2::ScalarFunctionQuadraticApproximation::dfduu);                                                       \
+    /* bind batch result classes */                                                                                                        \
+    pybind11::class_<ocs2::BatchMpcSolution>(m, "BatchMpcSolution")                                                                        \
+        .def_readonly("t", &ocs2::BatchMpcSolution::t)                                                                                     \
+        .def_readonly("x", &ocs2::BatchMpcSolution::x)                                                                                     \
+        .def_readonly("u", &ocs2::BatchMpcSolution::u);                                                                                    \
+    pybind11::class_<ocs2::BatchLinearApproximation>(m, "BatchLinearApproximation")                                                        \
+        .def_readonly("f", &ocs2::BatchLinearApproximation::f)                                                                             \
+        .def_readonly("dfdx", &ocs2::BatchLinearApproximation::dfdx)                                                                       \
+        .def_readonly("dfdu", &ocs2::BatchLinearApproximation::dfdu);                                                                      \
+    pybind11::class_<ocs2::BatchQuadraticApproximation>(m, "BatchQuadraticApproximation")                                                  \
+        .def_readonly("f", &ocs2::BatchQuadraticApproximation::f)                                                                          \
+        .def_readonly("dfdx", &ocs2::BatchQuadraticApproximation::dfdx)                                                                    \
+        .def_readonly("dfdu", &ocs2::BatchQuadraticApproximation::dfdu)                                                                    \
+        .def_readonly("dfdxx", &ocs2::BatchQuadraticApproximation::dfdxx)                                                                  \
+        .def_readonly("dfdux", &ocs2::BatchQuadraticApproximation::dfdux)                                                                  \
+        .def_readonly("dfduu", &ocs2::BatchQuadraticApproximation::dfduu);                                                                 \
+    /* bind the solution arrays, the properties are NumPy views which keep the arrays alive */                                             \
+    pybind11::class_<ocs2::MpcSolutionArrays, std::shared_ptr<ocs2::MpcSolutionArrays>>(m, "MpcSolutionArrays")                            \
+        .def_property_readonly("t",                                                                                                        \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& s = self.cast<const ocs2::MpcSolutionArrays&>();                                              \
+                                 return ocs2::makeNumpyView(s.t.data(), {s.t.size()}, self);                                               \
+                               })                                                                                                          \
+        .def_property_readonly("x",                                                                                                        \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& s = self.cast<const ocs2::MpcSolutionArrays&>();                                              \
+                                 return ocs2::makeNumpyView(s.x.data(), {s.x.rows(), s.x.cols()}, self);                                   \
+                               })                                                                                                          \
+        .def_property_readonly("u",                                                                                                        \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& s = self.cast<const ocs2::MpcSolutionArrays&>();                                              \
+                                 return ocs2::makeNumpyView(s.u.data(), {s.u.rows(), s.u.cols()}, self);                                   \
+                               })                                                                                                          \
+        .def_property_readonly("K",                                                                                                        \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& s = self.cast<const ocs2::MpcSolutionArrays&>();                                              \
+                                 return ocs2::makeNumpyView(s.K.data(), {s.K.rows(), s.u.cols(), s.x.cols()}, self);                       \
+                               });                                                                                                         \
     /* bind TargetTrajectories class */                                                                                                    \
     pybind11::class_<ocs2::TargetTrajectories>(m, "TargetTrajectories")                                                                    \
         .def(pybind11::init<ocs2::scalar_array_t, ocs2::vector_array_t, ocs2::vector_array_t>());                                          \
     /* bind the actual mpc interface */                                                                                                    \
-    pybind11::class_<PY_INTERFACE>(m, "mpc_interface")                                                                                     \
-        .def(pybind11::init<const std::string&, const std::string&, const std::string&>(), "taskFile"_a, "libFolder"_a, "urdfFile"_a = "") \
-        .def("getStateDim", &PY_INTERFACE::getStateDim)                                                                                    \
+    pybind11::class_<PY_INTERFACE> pyInterface(m, "mpc_interface");                                                                        \
+    ocs2::bindConstructor(pyInterface);                                                                                                    \
+    pyInterface.def("getStateDim", &PY_INTERFACE::getStateDim)                                                                             \
         .def("getInputDim", &PY_INTERFACE::getInputDim)                                                                                    \
         .def("setObservation", &PY_INTERFACE::setObservation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                 \
         .def("setTargetTrajectories", &PY_INTERFACE::setTargetTrajectories, "targetTrajectories"_a)                                        \
         .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a)                                                                        \
         .def("advanceMpc", &PY_INTERFACE::advanceMpc)                                                                                      \
         .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                     \
+        .def("getMpcSolutionArrays", &PY_INTERFACE::getMpcSolutionArrays)                                                                  \
         .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert())                                             \
         .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                               \
         .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
         .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                     \
         .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
+        /* batched API, the GIL is released while the batch is processed on the C++ worker threads */                                      \
+        .def("solveMpcBatch", &PY_INTERFACE::solveMpcBatch, "initTime"_a, "initState"_a, "targetState"_a, "targetInput"_a,                 \
+             "numSamples"_a, pybind11::call_guard<pybind11::gil_scoped_release>())                                                         \
+        .def("flowMapBatch", &PY_INTERFACE::flowMapBatch, "t"_a, "x"_a, "u"_a, pybind11::call_guard<pybind11::gil_scoped_release>())       \
+        .def("flowMapLinearApproximationBatch", &PY_INTERFACE::flowMapLinearApproximationBatch, "t"_a, "x"_a, "u"_a,                       \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("costQuadraticApproximationBatch", &PY_INTERFACE::costQuadraticApproximationBatch, "t"_a, "x"_a, "u"_a,                       \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
         .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert())                                                      \
         .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert())                        \
         .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())     \
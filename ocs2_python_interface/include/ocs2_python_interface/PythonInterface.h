@@ -29,14 +29,65 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/penalties/penalties/PenaltyBase.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
 namespace ocs2 {
 
+/** Row-major matrix such that each row of a batch result maps to a C-contiguous NumPy array. */
+using row_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/**
+ * The MPC solution stored in contiguous row-major arrays, where row i corresponds to the time sample i. The Python bindings expose these
+ * arrays as NumPy views which keep this object alive, hence no data is copied.
+ */
+struct MpcSolutionArrays {
+  vector_t t;      // T
+  row_matrix_t x;  // T x nx
+  row_matrix_t u;  // T x nu
+  row_matrix_t K;  // T x (nu * nx), the linear feedback gains in row-major order (zero rows if the policy has no feedback gains)
+};
+
+/**
+ * The MPC solutions of a batch sampled on a uniform time grid over the MPC horizon. Row k contains the k-th solution, where the
+ * states and inputs are stacked sample by sample, i.e., reshaping x to (K, N, nx) and u to (K, N, nu) does not copy.
+ */
+struct BatchMpcSolution {
+  row_matrix_t t;  // K x N
+  row_matrix_t x;  // K x (N * nx)
+  row_matrix_t u;  // K x (N * nu)
+};
+
+/**
+ * The linear approximations of a batch. Row k contains the k-th approximation, where the matrices are stored in row-major order,
+ * i.e., reshaping dfdx to (K, nf, nx) does not copy.
+ */
+struct BatchLinearApproximation {
+  row_matrix_t f;     // K x nf
+  row_matrix_t dfdx;  // K x (nf * nx)
+  row_matrix_t dfdu;  // K x (nf * nu)
+};
+
+/**
+ * The quadratic approximations of a scalar function for a batch. Row k contains the k-th approximation, where the matrices are
+ * stored in row-major order, i.e., reshaping dfdxx to (K, nx, nx) does not copy.
+ */
+struct BatchQuadraticApproximation {
+  vector_t f;          // K
+  row_matrix_t dfdx;   // K x nx
+  row_matrix_t dfdu;   // K x nu
+  row_matrix_t dfdxx;  // K x (nx * nx)
+  row_matrix_t dfdux;  // K x (nu * nx)
+  row_matrix_t dfduu;  // K x (nu * nu)
+};
+
 /**
  * PythonInterface provides a unified interface for all systems
  * to the MPC_MRT_Interface to be used for Python bindings
@@ -51,8 +102,12 @@ class PythonInterface {
    * @note This should be called from derived class constructor.
    * @param [in] robot: Robot interface.
    * @param [in] mpcPtr: The Python interface takes ownership of the mpcPtr
+   * @param [in] batchMpcPtrArray: Optional MPC instances for the batched API. Each instance is solved on its own worker thread, hence each
+   * one must own its reference manager (an exception is thrown otherwise). The Python interface takes ownership of them. If empty, the
+   * batched evaluation of the model runs on a single thread and solveMpcBatch is not available.
    */
-  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr);
+  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr,
+            std::vector<std::unique_ptr<MPC_BASE>> batchMpcPtrArray = std::vector<std::unique_ptr<MPC_BASE>>());
 
  public:
   /** Destructor */
@@ -106,6 +161,14 @@ class PythonInterface {
    */
   void getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u);
 
+  /**
+   * @brief Obtains the full MPC solution and its feedback gains in contiguous arrays.
+   * @note The storage is reused on the next call only if the returned object is not referenced anymore (e.g., by NumPy views in
+   * Python). Otherwise new storage is allocated, so that existing views always remain valid.
+   * @return The solution arrays.
+   */
+  std::shared_ptr<MpcSolutionArrays> getMpcSolutionArrays();
+
   /**
    * @brief Obtains feedback gain matrix, if the underlying MPC algorithm computes it
    * @param[in] t: Query time
@@ -125,6 +188,31 @@ class PythonInterface {
   /** Cost function quadratic approximation with added penalty term */
   ScalarFunctionQuadraticApproximation costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
+  /**
+   * @brief Solves K independent MPC problems in parallel. Each problem is solved from scratch (i.e., the MPC is reset) for the
+   * given initial time and state and a constant target.
+   * @note This function should be called with the GIL released.
+   * @param[in] initTime: Initial times (K).
+   * @param[in] initState: Initial states (K x nx).
+   * @param[in] targetState: Target states (K x nx).
+   * @param[in] targetInput: Target inputs (K x nu).
+   * @param[in] numSamples: Number of samples N on the time grid over the MPC horizon.
+   * @return The stacked solutions.
+   */
+  BatchMpcSolution solveMpcBatch(Eigen::Ref<const vector_t> initTime, Eigen::Ref<const row_matrix_t> initState,
+                                 Eigen::Ref<const row_matrix_t> targetState, Eigen::Ref<const row_matrix_t> targetInput, size_t numSamples);
+
+  /** Batched system dynamics, returns K x nx. t: (K), x: (K x nx), u: (K x nu) */
+  row_matrix_t flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /** Batched system dynamics linearization. t: (K), x: (K x nx), u: (K x nu) */
+  BatchLinearApproximation flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                           Eigen::Ref<const row_matrix_t> u);
+
+  /** Batched cost function quadratic approximation with added penalty term. t: (K), x: (K x nx), u: (K x nu) */
+  BatchQuadraticApproximation costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                              Eigen::Ref<const row_matrix_t> u);
+
   /**
    * The solver's internal value function
    * @param t query time
@@ -188,11 +276,29 @@ class PythonInterface {
   int inputDim_ = -1;  // -1 indicates that it is not initialized
 
  private:
+  /** Cost function with added penalty term evaluated on the given problem. */
+  scalar_t computeCostWithPenalty(OptimalControlProblem& problem, scalar_t t, const vector_t& x, const vector_t& u) const;
+
+  /** Cost function quadratic approximation with added penalty term evaluated on the given problem. */
+  ScalarFunctionQuadraticApproximation approximateCostWithPenalty(OptimalControlProblem& problem, scalar_t t, const vector_t& x,
+                                                                 const vector_t& u) const;
+
+  /** Runs task(workerIndex, sampleIndex) for all the K samples of a batch on the batch workers. */
+  void runBatch(size_t K, const std::function<void(size_t, size_t)>& task);
+
   std::unique_ptr<MPC_BASE> mpcPtr_;
   std::unique_ptr<MPC_MRT_Interface> mpcMrtInterface_;
 
   TargetTrajectories targetTrajectories_;
   OptimalControlProblem problem_;
+
+  std::shared_ptr<MpcSolutionArrays> mpcSolutionArraysPtr_;
+
+  // batched API: one MPC (optional) and one copy of the problem per worker
+  std::vector<std::unique_ptr<MPC_BASE>> batchMpcPtrArray_;
+  std::vector<std::unique_ptr<MPC_MRT_Interface>> batchMpcMrtInterfaceArray_;
+  std::vector<OptimalControlProblem> batchProblemArray_;
+  std::unique_ptr<ThreadPool> batchThreadPoolPtr_;
 };
 
 }  // namespace ocs2
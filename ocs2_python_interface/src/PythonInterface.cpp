@@ -29,7 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_python_interface/PythonInterface.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
@@ -39,7 +44,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr) {
+void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr,
+                           std::vector<std::unique_ptr<MPC_BASE>> batchMpcPtrArray) {
   if (!mpcPtr) {
     throw std::runtime_error("[PythonInterface] Mpc pointer must be initialized before passing to the Python interface.");
   }
@@ -48,6 +54,31 @@ void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE
   mpcMrtInterface_.reset(new MPC_MRT_Interface(*mpcPtr_));
 
   problem_ = robot.getOptimalControlProblem();
+
+  // batched API
+  batchMpcPtrArray_ = std::move(batchMpcPtrArray);
+  batchMpcMrtInterfaceArray_.clear();
+  std::vector<const ReferenceManagerInterface*> referenceManagerPtrs{&mpcPtr_->getSolverPtr()->getReferenceManager()};
+  for (const auto& batchMpcPtr : batchMpcPtrArray_) {
+    if (!batchMpcPtr) {
+      throw std::runtime_error("[PythonInterface] Batch Mpc pointers must be initialized before passing to the Python interface.");
+    }
+    // the batch instances are solved in parallel, hence each one should own its reference manager
+    const auto* referenceManagerPtr = &batchMpcPtr->getSolverPtr()->getReferenceManager();
+    if (std::find(referenceManagerPtrs.cbegin(), referenceManagerPtrs.cend(), referenceManagerPtr) != referenceManagerPtrs.cend()) {
+      throw std::runtime_error("[PythonInterface] Batch Mpc instances must not share their ReferenceManager with other instances.");
+    }
+    referenceManagerPtrs.push_back(referenceManagerPtr);
+    batchMpcMrtInterfaceArray_.emplace_back(new MPC_MRT_Interface(*batchMpcPtr));
+  }
+
+  const size_t numBatchWorkers = std::max(batchMpcPtrArray_.size(), size_t(1));
+  batchProblemArray_.clear();
+  batchProblemArray_.reserve(numBatchWorkers);
+  for (size_t i = 0; i < numBatchWorkers; i++) {
+    batchProblemArray_.push_back(problem_);
+  }
+  batchThreadPoolPtr_.reset(new ThreadPool(numBatchWorkers - 1));
 }
 
 /******************************************************************************************************/
@@ -96,6 +127,52 @@ void PythonInterface::getMpcSolution(scalar_array_t& t, vector_array_t& x, vecto
   u = mpcMrtInterface_->getPolicy().inputTrajectory_;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_ptr<MpcSolutionArrays> PythonInterface::getMpcSolutionArrays() {
+  mpcMrtInterface_->updatePolicy();
+  const auto& policy = mpcMrtInterface_->getPolicy();
+
+  const int T = policy.timeTrajectory_.size();
+  const int nx = (T > 0) ? policy.stateTrajectory_.front().size() : 0;
+  const int nu = (T > 0) ? policy.inputTrajectory_.front().size() : 0;
+  const bool hasConstantDims =
+      std::all_of(policy.stateTrajectory_.cbegin(), policy.stateTrajectory_.cend(), [&](const vector_t& x) { return x.size() == nx; }) &&
+      std::all_of(policy.inputTrajectory_.cbegin(), policy.inputTrajectory_.cend(), [&](const vector_t& u) { return u.size() == nu; });
+  if (!hasConstantDims) {
+    throw std::runtime_error("[PythonInterface::getMpcSolutionArrays] The state and input dimensions should be constant!");
+  }
+
+  // reuse the storage only if it is not referenced anymore
+  if (mpcSolutionArraysPtr_ == nullptr || mpcSolutionArraysPtr_.use_count() > 1) {
+    mpcSolutionArraysPtr_ = std::make_shared<MpcSolutionArrays>();
+  }
+  auto& arrays = *mpcSolutionArraysPtr_;
+
+  arrays.t = Eigen::Map<const vector_t>(policy.timeTrajectory_.data(), T);
+  arrays.x.resize(T, nx);
+  arrays.u.resize(T, nu);
+  for (int i = 0; i < T; i++) {
+    arrays.x.row(i) = policy.stateTrajectory_[i].transpose();
+    arrays.u.row(i) = policy.inputTrajectory_[i].transpose();
+  }
+
+  const auto* linearControllerPtr = dynamic_cast<const LinearController*>(policy.controllerPtr_.get());
+  if (linearControllerPtr != nullptr && !linearControllerPtr->empty()) {
+    matrix_t gain;
+    arrays.K.resize(T, nu * nx);
+    for (int i = 0; i < T; i++) {
+      linearControllerPtr->getFeedbackGain(policy.timeTrajectory_[i], gain);
+      Eigen::Map<row_matrix_t>(arrays.K.row(i).data(), nu, nx) = gain;
+    }
+  } else {
+    arrays.K.resize(0, nu * nx);
+  }
+
+  return mpcSolutionArraysPtr_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -124,66 +201,156 @@ VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(sc
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
-  auto request = Request::Cost + Request::Cost + Request::SoftConstraint;
-  if (penalty_ != nullptr) {
-    request = request + Request::Constraint;
+  return computeCostWithPenalty(problem_, t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
+                                                                                 Eigen::Ref<const vector_t> u) {
+  return approximateCostWithPenalty(problem_, t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchMpcSolution PythonInterface::solveMpcBatch(Eigen::Ref<const vector_t> initTime, Eigen::Ref<const row_matrix_t> initState,
+                                                Eigen::Ref<const row_matrix_t> targetState, Eigen::Ref<const row_matrix_t> targetInput,
+                                                size_t numSamples) {
+  if (batchMpcMrtInterfaceArray_.empty()) {
+    throw std::runtime_error("[PythonInterface::solveMpcBatch] No MPC instance for the batched API is provided in init().");
+  }
+  const size_t K = initTime.size();
+  if (static_cast<size_t>(initState.rows()) != K || static_cast<size_t>(targetState.rows()) != K ||
+      static_cast<size_t>(targetInput.rows()) != K) {
+    throw std::runtime_error("[PythonInterface::solveMpcBatch] All inputs should have the same batch size!");
+  }
+  if (targetState.cols() != initState.cols()) {
+    throw std::runtime_error("[PythonInterface::solveMpcBatch] The initial and target states should have the same dimension!");
+  }
+  if (numSamples < 2) {
+    throw std::runtime_error("[PythonInterface::solveMpcBatch] At least two samples are required!");
   }
-  auto& preComputation = *problem_.preComputationPtr;
-  preComputation.request(request, t, x, u);
 
-  // get results
-  scalar_t cost = computeCost(problem_, t, x, u);
+  const int nx = initState.cols();
+  const int nu = targetInput.cols();
+  BatchMpcSolution solution;
+  solution.t.resize(K, numSamples);
+  solution.x.resize(K, numSamples * nx);
+  solution.u.resize(K, numSamples * nu);
+
+  runBatch(K, [&](size_t workerIndex, size_t k) {
+    auto& mpcMrtInterface = *batchMpcMrtInterfaceArray_[workerIndex];
+    const scalar_t timeHorizon = batchMpcPtrArray_[workerIndex]->getTimeHorizon();
+
+    // solve from scratch
+    const TargetTrajectories targetTrajectories({initTime(k)}, {targetState.row(k).transpose()}, {targetInput.row(k).transpose()});
+    mpcMrtInterface.resetMpcNode(targetTrajectories);
+    SystemObservation observation;
+    observation.time = initTime(k);
+    observation.state = initState.row(k).transpose();
+    observation.input = vector_t::Zero(nu);
+    mpcMrtInterface.setCurrentObservation(observation);
+    mpcMrtInterface.advanceMpc();
+    mpcMrtInterface.updatePolicy();
+
+    // sample the solution
+    const auto& policy = mpcMrtInterface.getPolicy();
+    for (size_t j = 0; j < numSamples; j++) {
+      const scalar_t time = initTime(k) + timeHorizon * static_cast<scalar_t>(j) / static_cast<scalar_t>(numSamples - 1);
+      solution.t(k, j) = time;
+      solution.x.row(k).segment(j * nx, nx) =
+          LinearInterpolation::interpolate(time, policy.timeTrajectory_, policy.stateTrajectory_).transpose();
+      solution.u.row(k).segment(j * nu, nu) =
+          LinearInterpolation::interpolate(time, policy.timeTrajectory_, policy.inputTrajectory_).transpose();
+    }
+  });
 
-  if (penalty_ != nullptr) {
-    const auto& targetTrajectories = *problem_.targetTrajectoriesPtr;
-    cost += problem_.equalityLagrangianPtr->getValue(t, x, u, targetTrajectories, preComputation);
-    cost += problem_.stateEqualityLagrangianPtr->getValue(t, x, targetTrajectories, preComputation);
-    cost += problem_.inequalityLagrangianPtr->getValue(t, x, u, targetTrajectories, preComputation);
-    cost += problem_.stateInequalityLagrangianPtr->getValue(t, x, targetTrajectories, preComputation);
+  return solution;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+row_matrix_t PythonInterface::flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                           Eigen::Ref<const row_matrix_t> u) {
+  const size_t K = t.size();
+  if (static_cast<size_t>(x.rows()) != K || static_cast<size_t>(u.rows()) != K) {
+    throw std::runtime_error("[PythonInterface::flowMapBatch] All inputs should have the same batch size!");
   }
 
-  return cost;
+  row_matrix_t f(K, x.cols());
+  runBatch(K, [&](size_t workerIndex, size_t k) {
+    auto& dynamics = *batchProblemArray_[workerIndex].dynamicsPtr;
+    f.row(k) = dynamics.computeFlowMap(t(k), x.row(k).transpose(), u.row(k).transpose()).transpose();
+  });
+
+  return f;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
-                                                                                 Eigen::Ref<const vector_t> u) {
-  auto request = Request::Cost + Request::Cost + Request::SoftConstraint + Request::Approximation;
-  if (penalty_ != nullptr) {
-    request = request + Request::Constraint;
+BatchLinearApproximation PythonInterface::flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                                          Eigen::Ref<const row_matrix_t> u) {
+  const size_t K = t.size();
+  if (static_cast<size_t>(x.rows()) != K || static_cast<size_t>(u.rows()) != K) {
+    throw std::runtime_error("[PythonInterface::flowMapLinearApproximationBatch] All inputs should have the same batch size!");
   }
-  auto& preComputation = *problem_.preComputationPtr;
-  preComputation.request(request, t, x, u);
 
-  // get results
-  auto cost = approximateCost(problem_, t, x, u);
+  const int nx = x.cols();
+  const int nu = u.cols();
+  BatchLinearApproximation result;
+  result.f.resize(K, nx);
+  result.dfdx.resize(K, nx * nx);
+  result.dfdu.resize(K, nx * nu);
+  runBatch(K, [&](size_t workerIndex, size_t k) {
+    auto& dynamics = *batchProblemArray_[workerIndex].dynamicsPtr;
+    const auto approx = dynamics.linearApproximation(t(k), x.row(k).transpose(), u.row(k).transpose());
+    result.f.row(k) = approx.f.transpose();
+    Eigen::Map<row_matrix_t>(result.dfdx.row(k).data(), nx, nx) = approx.dfdx;
+    Eigen::Map<row_matrix_t>(result.dfdu.row(k).data(), nx, nu) = approx.dfdu;
+  });
+
+  return result;
+}
 
-  // Lagrangians
-  if (penalty_ != nullptr) {
-    const auto& targetTrajectories = *problem_.targetTrajectoriesPtr;
-    if (!problem_.stateEqualityLagrangianPtr->empty()) {
-      auto approx = problem_.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, targetTrajectories, preComputation);
-      cost.f += approx.f;
-      cost.dfdx += approx.dfdx;
-      cost.dfdxx += approx.dfdxx;
-    }
-    if (!problem_.stateInequalityLagrangianPtr->empty()) {
-      auto approx = problem_.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, targetTrajectories, preComputation);
-      cost.f += approx.f;
-      cost.dfdx += approx.dfdx;
-      cost.dfdxx += approx.dfdxx;
-    }
-    if (!problem_.equalityLagrangianPtr->empty()) {
-      cost += problem_.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
-    }
-    if (!problem_.inequalityLagrangianPtr->empty()) {
-      cost += problem_.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
-    }
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchQuadraticApproximation PythonInterface::costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                                             Eigen::Ref<const row_matrix_t> u) {
+  const size_t K = t.size();
+  if (static_cast<size_t>(x.rows()) != K || static_cast<size_t>(u.rows()) != K) {
+    throw std::runtime_error("[PythonInterface::costQuadraticApproximationBatch] All inputs should have the same batch size!");
   }
 
-  return cost;
+  // the workers use the current target trajectories
+  for (auto& problem : batchProblemArray_) {
+    problem.targetTrajectoriesPtr = problem_.targetTrajectoriesPtr;
+  }
+
+  const int nx = x.cols();
+  const int nu = u.cols();
+  BatchQuadraticApproximation result;
+  result.f.resize(K);
+  result.dfdx.resize(K, nx);
+  result.dfdu.resize(K, nu);
+  result.dfdxx.resize(K, nx * nx);
+  result.dfdux.resize(K, nu * nx);
+  result.dfduu.resize(K, nu * nu);
+  runBatch(K, [&](size_t workerIndex, size_t k) {
+    const auto approx = approximateCostWithPenalty(batchProblemArray_[workerIndex], t(k), x.row(k).transpose(), u.row(k).transpose());
+    result.f(k) = approx.f;
+    result.dfdx.row(k) = approx.dfdx.transpose();
+    result.dfdu.row(k) = approx.dfdu.transpose();
+    Eigen::Map<row_matrix_t>(result.dfdxx.row(k).data(), nx, nx) = approx.dfdxx;
+    Eigen::Map<row_matrix_t>(result.dfdux.row(k).data(), nu, nx) = approx.dfdux;
+    Eigen::Map<row_matrix_t>(result.dfduu.row(k).data(), nu, nu) = approx.dfduu;
+  });
+
+  return result;
 }
 
 /******************************************************************************************************/
@@ -243,4 +410,87 @@ vector_t PythonInterface::stateInputEqualityConstraintLagrangian(scalar_t t, Eig
   return DmDager.transpose() * (R * DmDager * c - r - B.transpose() * costate);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t PythonInterface::computeCostWithPenalty(OptimalControlProblem& problem, scalar_t t, const vector_t& x, const vector_t& u) const {
+  auto request = Request::Cost + Request::Cost + Request::SoftConstraint;
+  if (penalty_ != nullptr) {
+    request = request + Request::Constraint;
+  }
+  auto& preComputation = *problem.preComputationPtr;
+  preComputation.request(request, t, x, u);
+
+  // get results
+  scalar_t cost = computeCost(problem, t, x, u);
+
+  if (penalty_ != nullptr) {
+    const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
+    cost += problem.equalityLagrangianPtr->getValue(t, x, u, targetTrajectories, preComputation);
+    cost += problem.stateEqualityLagrangianPtr->getValue(t, x, targetTrajectories, preComputation);
+    cost += problem.inequalityLagrangianPtr->getValue(t, x, u, targetTrajectories, preComputation);
+    cost += problem.stateInequalityLagrangianPtr->getValue(t, x, targetTrajectories, preComputation);
+  }
+
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation PythonInterface::approximateCostWithPenalty(OptimalControlProblem& problem, scalar_t t,
+                                                                                 const vector_t& x, const vector_t& u) const {
+  auto request = Request::Cost + Request::Cost + Request::SoftConstraint + Request::Approximation;
+  if (penalty_ != nullptr) {
+    request = request + Request::Constraint;
+  }
+  auto& preComputation = *problem.preComputationPtr;
+  preComputation.request(request, t, x, u);
+
+  // get results
+  auto cost = approximateCost(problem, t, x, u);
+
+  // Lagrangians
+  if (penalty_ != nullptr) {
+    const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
+    if (!problem.stateEqualityLagrangianPtr->empty()) {
+      auto approx = problem.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, targetTrajectories, preComputation);
+      cost.f += approx.f;
+      cost.dfdx += approx.dfdx;
+      cost.dfdxx += approx.dfdxx;
+    }
+    if (!problem.stateInequalityLagrangianPtr->empty()) {
+      auto approx = problem.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, targetTrajectories, preComputation);
+      cost.f += approx.f;
+      cost.dfdx += approx.dfdx;
+      cost.dfdxx += approx.dfdxx;
+    }
+    if (!problem.equalityLagrangianPtr->empty()) {
+      cost += problem.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+    }
+    if (!problem.inequalityLagrangianPtr->empty()) {
+      cost += problem.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+    }
+  }
+
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::runBatch(size_t K, const std::function<void(size_t, size_t)>& task) {
+  // each worker uses its own resources and takes the next sample of the batch
+  std::atomic_size_t nextWorkerIndex{0};
+  std::atomic_size_t nextSampleIndex{0};
+  auto workerTask = [&](int) {
+    const size_t workerIndex = nextWorkerIndex++;
+    size_t k;
+    while ((k = nextSampleIndex++) < K) {
+      task(workerIndex, k);
+    }
+  };
+  batchThreadPoolPtr_->runParallel(workerTask, std::min(batchProblemArray_.size(), K));
+}
+
 }  // namespace ocs2
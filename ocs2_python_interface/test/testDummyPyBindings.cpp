@@ -41,6 +41,7 @@ class DummyInterface final : public RobotInterface {
     mpc::Settings mpcSettings;
     ddp::Settings ddpSettings;
     ddpSettings.algorithm_ = ddp::Algorithm::SLQ;
+    ddpSettings.useFeedbackPolicy_ = true;
     return std::unique_ptr<GaussNewtonDDP_MPC>(new GaussNewtonDDP_MPC(mpcSettings, ddpSettings, *rolloutPtr_, problem_, *initializerPtr_));
   }
 
@@ -70,3 +71,47 @@ class DummyPyBindings final : public PythonInterface {
 TEST(OCS2PyBindingsTest, createDummyPyBindings) {
   ocs2::pybindings_test::DummyPyBindings dummy;
 }
+
+TEST(OCS2PyBindingsTest, solutionArrays) {
+  ocs2::pybindings_test::DummyPyBindings dummy;
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Zero(2)}, {ocs2::vector_t::Zero(1)});
+  dummy.reset(targetTrajectories);
+  dummy.setObservation(0.0, ocs2::vector_t::Ones(2), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+
+  ocs2::scalar_array_t t;
+  ocs2::vector_array_t x, u;
+  dummy.getMpcSolution(t, x, u);
+  auto arraysPtr = dummy.getMpcSolutionArrays();
+  ASSERT_FALSE(t.empty());
+  ASSERT_EQ(arraysPtr->t.size(), t.size());
+  ASSERT_EQ(arraysPtr->x.cols(), 2);
+  ASSERT_EQ(arraysPtr->u.cols(), 1);
+
+  // the gains are stored row by row, i.e., row i is the row-major (nu x nx) gain of the time sample i
+  ASSERT_EQ(arraysPtr->K.rows(), t.size());
+  ASSERT_EQ(arraysPtr->K.cols(), 1 * 2);
+  for (size_t i = 0; i < t.size(); i++) {
+    EXPECT_DOUBLE_EQ(arraysPtr->t(i), t[i]);
+    EXPECT_TRUE(arraysPtr->x.row(i).transpose().isApprox(x[i]));
+    EXPECT_TRUE(arraysPtr->u.row(i).transpose().isApprox(u[i]));
+    const ocs2::matrix_t K = dummy.getLinearFeedbackGain(t[i]);
+    EXPECT_TRUE(Eigen::Map<const ocs2::row_matrix_t>(arraysPtr->K.row(i).data(), 1, 2).isApprox(K));
+  }
+
+  // a referenced storage is left untouched, since a NumPy view might still point to it
+  const auto* referencedArraysPtr = arraysPtr.get();
+  const auto* referencedData = arraysPtr->x.data();
+  auto newArraysPtr = dummy.getMpcSolutionArrays();
+  EXPECT_NE(newArraysPtr.get(), referencedArraysPtr);
+  EXPECT_EQ(arraysPtr->x.data(), referencedData);
+
+  // once released, the storage is reused by the next call
+  const auto* releasedArraysPtr = newArraysPtr.get();
+  const auto* releasedData = newArraysPtr->x.data();
+  arraysPtr.reset();
+  newArraysPtr.reset();
+  arraysPtr = dummy.getMpcSolutionArrays();
+  EXPECT_EQ(arraysPtr.get(), releasedArraysPtr);
+  EXPECT_EQ(arraysPtr->x.data(), releasedData);
+}
@@ -63,6 +63,9 @@ class BallbotSystemDynamics : public SystemDynamicsBaseAD {
 
   BallbotSystemDynamics* clone() const override { return new BallbotSystemDynamics(*this); }
 
+  /** The state is ordered as [positions; velocities]. */
+  size_t getConfigurationDimension() const override { return STATE_DIM / 2; }
+
   ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
                             const ad_vector_t& parameters) const override;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
 #include <ocs2_python_interface/PythonInterface.h>
 
 #include "ocs2_double_integrator/DoubleIntegratorInterface.h"
@@ -20,8 +21,11 @@ class DoubleIntegratorPyBindings final : public PythonInterface {
    * @param [in] taskFile: The absolute path to the configuration file for the MPC.
    * @param [in] libraryFolder: The absolute path to the directory to generate CppAD library into.
    * @param [in] urdfFile: The absolute path to the URDF of the robot. This is not used for double integrator.
+   * @param [in] numBatchInstances: The number of MPC instances which are solved in parallel by the batched API (solveMpcBatch). The
+   * batched API is only available if it is set.
    */
-  DoubleIntegratorPyBindings(const std::string& taskFile, const std::string& libraryFolder, const std::string urdfFile = "") {
+  DoubleIntegratorPyBindings(const std::string& taskFile, const std::string& libraryFolder, const std::string urdfFile = "",
+                             size_t numBatchInstances = 0) {
     // System dimensions
     stateDim_ = static_cast<int>(STATE_DIM);
     inputDim_ = static_cast<int>(INPUT_DIM);
@@ -30,13 +34,25 @@ class DoubleIntegratorPyBindings final : public PythonInterface {
     DoubleIntegratorInterface doubleIntegratorInterface(taskFile, libraryFolder);
 
     // MPC
-    std::unique_ptr<GaussNewtonDDP_MPC> mpcPtr(new GaussNewtonDDP_MPC(
-        doubleIntegratorInterface.mpcSettings(), doubleIntegratorInterface.ddpSettings(), doubleIntegratorInterface.getRollout(),
-        doubleIntegratorInterface.getOptimalControlProblem(), doubleIntegratorInterface.getInitializer()));
+    auto mpcPtr = getMpc(doubleIntegratorInterface);
     mpcPtr->getSolverPtr()->setReferenceManager(doubleIntegratorInterface.getReferenceManagerPtr());
 
+    // MPC instances of the batched API, each one with its own reference manager
+    std::vector<std::unique_ptr<MPC_BASE>> batchMpcPtrArray;
+    for (size_t i = 0; i < numBatchInstances; i++) {
+      batchMpcPtrArray.emplace_back(getMpc(doubleIntegratorInterface));
+      batchMpcPtrArray.back()->getSolverPtr()->setReferenceManager(std::make_shared<ReferenceManager>());
+    }
+
     // Python interface
-    PythonInterface::init(doubleIntegratorInterface, std::move(mpcPtr));
+    PythonInterface::init(doubleIntegratorInterface, std::move(mpcPtr), std::move(batchMpcPtrArray));
+  }
+
+ private:
+  static std::unique_ptr<GaussNewtonDDP_MPC> getMpc(DoubleIntegratorInterface& doubleIntegratorInterface) {
+    return std::unique_ptr<GaussNewtonDDP_MPC>(new GaussNewtonDDP_MPC(
+        doubleIntegratorInterface.mpcSettings(), doubleIntegratorInterface.ddpSettings(), doubleIntegratorInterface.getRollout(),
+        doubleIntegratorInterface.getOptimalControlProblem(), doubleIntegratorInterface.getInitializer()));
   }
 };
 
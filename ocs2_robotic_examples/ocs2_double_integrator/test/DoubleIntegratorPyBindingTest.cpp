@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/LinearInterpolation.h>
+
 #include <ocs2_double_integrator/DoubleIntegratorPyBindings.h>
 #include <ocs2_double_integrator/package_path.h>
 
@@ -78,6 +80,79 @@ TEST(DoubleIntegratorTest, pyBindings) {
   std::cout << "K: " << K << std::endl;
 }
 
+TEST(DoubleIntegratorTest, pyBindingsBatch) {
+  using bindings_t = ocs2::double_integrator::DoubleIntegratorPyBindings;
+  constexpr size_t nx = ocs2::double_integrator::STATE_DIM;
+  constexpr size_t nu = ocs2::double_integrator::INPUT_DIM;
+  constexpr size_t numSamples = 11;
+  constexpr size_t K = 6;
+
+  const std::string taskFile = ocs2::double_integrator::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ocs2::double_integrator::getPath() + "/auto_generated";
+  bindings_t bindings(taskFile, libFolder, "", 3);
+
+  ocs2::vector_t initTime(K);
+  ocs2::row_matrix_t initState(K, nx), targetState(K, nx), targetInput(K, nu);
+  for (size_t k = 0; k < K; k++) {
+    initTime(k) = 0.1 * k;
+    initState.row(k) = ocs2::vector_t::LinSpaced(nx, -1.0, 0.5 * k).transpose();
+    targetState.row(k) = ocs2::vector_t::Constant(nx, 0.2 * k).transpose();
+    targetInput.row(k).setZero();
+  }
+
+  const auto batchSolution = bindings.solveMpcBatch(initTime, initState, targetState, targetInput, numSamples);
+  ASSERT_EQ(batchSolution.t.rows(), K);
+  ASSERT_EQ(batchSolution.t.cols(), numSamples);
+
+  // every batch entry should match the solution of the sequential MPC for the same problem
+  for (size_t k = 0; k < K; k++) {
+    const ocs2::vector_t x0 = initState.row(k).transpose();
+    bindings.reset(ocs2::TargetTrajectories({initTime(k)}, {targetState.row(k).transpose()}, {targetInput.row(k).transpose()}));
+    bindings.setObservation(initTime(k), x0, ocs2::vector_t::Zero(nu));
+    bindings.advanceMpc();
+
+    ocs2::scalar_array_t t_arr;
+    ocs2::vector_array_t x_arr;
+    ocs2::vector_array_t u_arr;
+    bindings.getMpcSolution(t_arr, x_arr, u_arr);
+
+    EXPECT_TRUE(batchSolution.x.row(k).head(nx).transpose().isApprox(x0));
+    for (size_t j = 0; j < numSamples; j++) {
+      const ocs2::scalar_t time = batchSolution.t(k, j);
+      const ocs2::vector_t x = ocs2::LinearInterpolation::interpolate(time, t_arr, x_arr);
+      const ocs2::vector_t u = ocs2::LinearInterpolation::interpolate(time, t_arr, u_arr);
+      EXPECT_TRUE(batchSolution.x.row(k).segment(j * nx, nx).transpose().isApprox(x, 1e-6)) << "batch: " << k << ", time: " << time;
+      EXPECT_TRUE(batchSolution.u.row(k).segment(j * nu, nu).transpose().isApprox(u, 1e-6)) << "batch: " << k << ", time: " << time;
+    }
+  }
+
+  // batched model evaluation against the sequential one
+  ocs2::row_matrix_t input(K, nu);
+  for (size_t k = 0; k < K; k++) {
+    input.row(k) = ocs2::vector_t::Constant(nu, 0.3 * k - 0.5).transpose();
+  }
+  const auto f = bindings.flowMapBatch(initTime, initState, input);
+  const auto linearApproximation = bindings.flowMapLinearApproximationBatch(initTime, initState, input);
+  const auto quadraticApproximation = bindings.costQuadraticApproximationBatch(initTime, initState, input);
+  for (size_t k = 0; k < K; k++) {
+    const ocs2::vector_t x = initState.row(k).transpose();
+    const ocs2::vector_t u = input.row(k).transpose();
+    EXPECT_TRUE(f.row(k).transpose().isApprox(bindings.flowMap(initTime(k), x, u)));
+
+    const auto flowMap = bindings.flowMapLinearApproximation(initTime(k), x, u);
+    EXPECT_TRUE(linearApproximation.f.row(k).transpose().isApprox(flowMap.f));
+    EXPECT_TRUE(Eigen::Map<const ocs2::row_matrix_t>(linearApproximation.dfdx.row(k).data(), nx, nx).isApprox(flowMap.dfdx));
+    EXPECT_TRUE(Eigen::Map<const ocs2::row_matrix_t>(linearApproximation.dfdu.row(k).data(), nx, nu).isApprox(flowMap.dfdu));
+
+    const auto L = bindings.costQuadraticApproximation(initTime(k), x, u);
+    EXPECT_NEAR(quadraticApproximation.f(k), L.f, 1e-9);
+    EXPECT_TRUE(quadraticApproximation.dfdx.row(k).transpose().isApprox(L.dfdx));
+    EXPECT_TRUE(quadraticApproximation.dfdu.row(k).transpose().isApprox(L.dfdu));
+    EXPECT_TRUE(Eigen::Map<const ocs2::row_matrix_t>(quadraticApproximation.dfdxx.row(k).data(), nx, nx).isApprox(L.dfdxx));
+    EXPECT_TRUE(Eigen::Map<const ocs2::row_matrix_t>(quadraticApproximation.dfduu.row(k).data(), nu, nu).isApprox(L.dfduu));
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,129 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_centroidal_model/CentroidalModelInfo.h>
+#include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/penalties/penalties/PenaltyBase.h>
+
+#include "ocs2_legged_robot/common/Types.h"
+#include "ocs2_legged_robot/constraint/FrictionConeConstraint.h"
+#include "ocs2_legged_robot/reference_manager/SwitchedModelReferenceManager.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Implements the penalty of the friction cone constraints of all the 3 DoF contacts in a single cost term:
+ *
+ * penalty(t, u) = sum_{i in stance} p(frictionCoefficient * (Fz_i + gripperForce) - sqrt(Fx_i * Fx_i + Fy_i * Fy_i + regularization))
+ *
+ * The cones of all contacts are evaluated together by computeConeBatch() on contiguous per-component arrays of forces and the penalty
+ * derivatives are written directly into the 3x3 blocks of the quadratic approximation. The result is numerically the same as adding one
+ * StateInputSoftConstraint of FrictionConeConstraint per contact, but it avoids the dense per-contact Jacobians and Hessians that
+ * the generic soft constraint concatenates and multiplies.
+ *
+ * @note As in FrictionConeConstraint, the terrain is assumed to be flat, i.e., the local forces are the forces in the world frame.
+ */
+class FrictionConeSoftConstraint final : public StateInputCost {
+ public:
+  /** A batch of local forces, stored per component such that each component is contiguous. */
+  struct ForceBatch {
+    vector_t x;
+    vector_t y;
+    vector_t z;
+  };
+
+  /**
+   * The cone values and their derivatives w.r.t. the local forces, one entry per force. The derivative w.r.t. Fz is the friction
+   * coefficient and the Hessian w.r.t. the local force only has the xx, xy, and yy entries.
+   */
+  struct ConeBatch {
+    vector_t value;
+    vector_t dCone_dFx;
+    vector_t dCone_dFy;
+    vector_t d2Cone_dFxdFx;
+    vector_t d2Cone_dFxdFy;
+    vector_t d2Cone_dFydFy;
+  };
+
+  /**
+   * Constructor
+   * @param [in] referenceManager : Switched model ReferenceManager.
+   * @param [in] config : Friction model settings.
+   * @param [in] info : The centroidal model information.
+   * @param [in] penaltyPtr : The penalty function on the friction cone constraints.
+   */
+  FrictionConeSoftConstraint(const SwitchedModelReferenceManager& referenceManager, FrictionConeConstraint::Config config,
+                             CentroidalModelInfo info, std::unique_ptr<PenaltyBase> penaltyPtr);
+
+  ~FrictionConeSoftConstraint() override = default;
+  FrictionConeSoftConstraint* clone() const override { return new FrictionConeSoftConstraint(*this); }
+
+  bool isActive(scalar_t time) const override;
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override;
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override;
+
+  /**
+   * Evaluates the friction cones of a batch of local forces, e.g. the contacts of one or several nodes. The evaluation is
+   * element-wise over the entries and uses the same arithmetic as FrictionConeConstraint. The outputs are only resized if
+   * their size differs from the batch size.
+   *
+   * @param [in] config : Friction model settings.
+   * @param [in] localForces : The local forces.
+   * @param [out] cone : The cone values and, if requested, their derivatives.
+   * @param [in] computeDerivatives : Whether the first and second derivatives should be computed.
+   */
+  static void computeConeBatch(const FrictionConeConstraint::Config& config, const ForceBatch& localForces, ConeBatch& cone,
+                               bool computeDerivatives = true);
+
+ private:
+  FrictionConeSoftConstraint(const FrictionConeSoftConstraint& other);
+
+  /** Gathers the forces of all the 3 DoF contacts in forces_. The contacts in swing are evaluated too, but they are not penalized. */
+  void updateForces(const vector_t& input) const;
+
+  const SwitchedModelReferenceManager* referenceManagerPtr_;
+  const FrictionConeConstraint::Config config_;
+  const CentroidalModelInfo info_;
+  std::unique_ptr<PenaltyBase> penaltyPtr_;
+
+  // workspace, sized for all the 3 DoF contacts
+  mutable ForceBatch forces_;
+  mutable ConeBatch cone_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <memory>
+
 #include <ocs2_core/reference/ModeSchedule.h>
 
 #include "ocs2_legged_robot/common/Types.h"
@@ -50,6 +52,14 @@ class SwingTrajectoryPlanner {
 
   void update(const ModeSchedule& modeSchedule, scalar_t terrainHeight);
 
+  /**
+   * Updates the feet height trajectories. The swing phases of the previous update whose lift-off/touch-down times and heights
+   * are unchanged keep their splines; only the new or modified swing phases are regenerated.
+   *
+   * @param [in] modeSchedule: The mode schedule.
+   * @param [in] liftOffHeightSequence: The lift-off height of each foot in each mode.
+   * @param [in] touchDownHeightSequence: The touch-down height of each foot in each mode.
+   */
   void update(const ModeSchedule& modeSchedule, const feet_array_t<scalar_array_t>& liftOffHeightSequence,
               const feet_array_t<scalar_array_t>& touchDownHeightSequence);
 
@@ -57,7 +67,56 @@ class SwingTrajectoryPlanner {
 
   scalar_t getZpositionConstraint(size_t leg, scalar_t time) const;
 
+  /** Returns the number of swing phase splines which have been generated, i.e., not reused, since the construction. */
+  size_t getNumGeneratedSwingPhases() const { return numGeneratedSwingPhases_; }
+
  private:
+  using spline_ptr_t = std::shared_ptr<const SplineCpg>;
+
+  /** A swing phase of a foot together with its height trajectory. */
+  struct SwingPhase {
+    scalar_t liftOffTime;
+    scalar_t touchDownTime;
+    scalar_t liftOffHeight;
+    scalar_t touchDownHeight;
+    spline_ptr_t spline;  // shared with the modes of the swing phase
+
+    bool matches(scalar_t otherLiftOffTime, scalar_t otherTouchDownTime, scalar_t otherLiftOffHeight, scalar_t otherTouchDownHeight) const {
+      return liftOffTime == otherLiftOffTime && touchDownTime == otherTouchDownTime && liftOffHeight == otherLiftOffHeight &&
+             touchDownHeight == otherTouchDownHeight;
+    }
+  };
+
+  /**
+   * Returns the spline of the given swing phase. It is taken from the swing phases of the previous update if an identical one
+   * exists, otherwise it is generated.
+   *
+   * @param [in] previousSwingPhases: The swing phases of the foot from the previous update, sorted by their lift-off time.
+   * @param [in, out] searchIndex: The index in previousSwingPhases where the search starts. It is advanced past the swing phases
+   * that lift off before the given one.
+   * @param [in] liftOffTime: The lift-off time.
+   * @param [in] touchDownTime: The touch-down time.
+   * @param [in] liftOffHeight: The lift-off height.
+   * @param [in] touchDownHeight: The touch-down height.
+   * @return The swing phase.
+   */
+  SwingPhase getSwingPhase(const std::vector<SwingPhase>& previousSwingPhases, size_t& searchIndex, scalar_t liftOffTime,
+                           scalar_t touchDownTime, scalar_t liftOffHeight, scalar_t touchDownHeight);
+
+  /**
+   * Builds the time-indexed table used by findPhaseIndex from eventTimes_.
+   */
+  void updateEventTimesGrid();
+
+  /**
+   * Finds the index of the mode which is active at the given time. The result is identical to lookup::findIndexInTimeArray
+   * on the event times, but the search starts from a uniform time grid over the event times instead of a binary search.
+   *
+   * @param [in] time: The enquiry time.
+   * @return The mode index.
+   */
+  size_t findPhaseIndex(scalar_t time) const;
+
   /**
    * Extracts for each leg the contact sequence over the motion phase sequence.
    * @param phaseIDsStock
@@ -103,8 +162,13 @@ class SwingTrajectoryPlanner {
   const Config config_;
   const size_t numFeet_;
 
-  feet_array_t<std::vector<SplineCpg>> feetHeightTrajectories_;
-  feet_array_t<std::vector<scalar_t>> feetHeightTrajectoriesEvents_;
+  feet_array_t<std::vector<spline_ptr_t>> feetHeightTrajectories_;  // the height trajectory of each foot in each mode
+  feet_array_t<std::vector<SwingPhase>> feetSwingPhases_;
+  size_t numGeneratedSwingPhases_ = 0;
+
+  scalar_array_t eventTimes_;
+  scalar_t eventTimesGridStep_ = 1.0;
+  std::vector<size_t> eventTimesGrid_;  // eventTimesGrid_[i]: index of the first event time not smaller than the i-th grid time
 };
 
 SwingTrajectoryPlanner::Config loadSwingTrajectorySettings(const std::string& fileName,
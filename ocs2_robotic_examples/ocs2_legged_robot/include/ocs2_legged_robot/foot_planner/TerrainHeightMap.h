@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "ocs2_legged_robot/common/Types.h"
+
+namespace ocs2 {
+namespace legged_robot {
+
+/**
+ * Height map of the terrain stored on a regular grid. The grid point (i, j) is located at position + resolution * (i, j).
+ *
+ * Heights, gradients, and normals are queried in constant time by bilinear interpolation of the grid values. The gradients and
+ * normals are precomputed at construction. Queries outside of the map are clamped to its border.
+ *
+ * The map additionally keeps coarser levels, each with twice the resolution of the previous one. A grid point of a coarser level
+ * holds the maximum height of the grid points it covers on the finer level, which gives conservative heights when the full
+ * resolution is not needed (e.g. the swing clearance over a whole step).
+ */
+class TerrainHeightMap {
+ public:
+  using vector2_t = Eigen::Matrix<scalar_t, 2, 1>;
+
+  /** Constructs an empty map. */
+  TerrainHeightMap() = default;
+
+  /**
+   * Constructor
+   * @param [in] position: The position of the grid point (0, 0).
+   * @param [in] resolution: The distance between two neighbouring grid points.
+   * @param [in] heights: The terrain heights at the grid points. The rows are along x and the columns along y.
+   * @param [in] numLevels: The number of resolution levels, including the original map.
+   */
+  TerrainHeightMap(const vector2_t& position, scalar_t resolution, matrix_t heights, size_t numLevels = 1);
+
+  /** Whether the map has no grid points. */
+  bool empty() const { return levels_.empty(); }
+
+  /** Gets the number of resolution levels. */
+  size_t getNumLevels() const { return levels_.size(); }
+
+  /** Gets the distance between two neighbouring grid points of the given level. */
+  scalar_t getResolution(size_t level = 0) const { return levels_[level].resolution; }
+
+  /**
+   * Gets the terrain height.
+   * @param [in] x: The x coordinate.
+   * @param [in] y: The y coordinate.
+   * @param [in] level: The resolution level.
+   * @return The interpolated height.
+   */
+  scalar_t getHeight(scalar_t x, scalar_t y, size_t level = 0) const;
+
+  /**
+   * Gets the terrain gradient at the finest resolution level.
+   * @param [in] x: The x coordinate.
+   * @param [in] y: The y coordinate.
+   * @return The interpolated gradient {dh/dx, dh/dy}.
+   */
+  vector2_t getGradient(scalar_t x, scalar_t y) const;
+
+  /**
+   * Gets the terrain normal at the finest resolution level.
+   * @param [in] x: The x coordinate.
+   * @param [in] y: The y coordinate.
+   * @return The interpolated unit normal.
+   */
+  vector3_t getNormal(scalar_t x, scalar_t y) const;
+
+ private:
+  struct Level {
+    scalar_t resolution;
+    matrix_t heights;
+  };
+
+  /** The lower grid point of the interpolation cell and the interpolation weights of the upper grid point. */
+  struct InterpolationPoint {
+    Eigen::Index i;
+    Eigen::Index j;
+    scalar_t wx;
+    scalar_t wy;
+  };
+
+  InterpolationPoint getInterpolationPoint(scalar_t x, scalar_t y, const Level& level) const;
+
+  static scalar_t interpolate(const matrix_t& values, const InterpolationPoint& point);
+
+  vector2_t position_ = vector2_t::Zero();
+  std::vector<Level> levels_;
+  matrix_t gradientX_;
+  matrix_t gradientY_;
+  std::array<matrix_t, 3> normal_;
+};
+
+}  // namespace legged_robot
+}  // namespace ocs2
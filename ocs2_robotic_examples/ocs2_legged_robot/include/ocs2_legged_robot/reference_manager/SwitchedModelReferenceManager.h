@@ -29,10 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_core/thread_support/BufferedValue.h>
 #include <ocs2_core/thread_support/Synchronized.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
 
 #include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
+#include "ocs2_legged_robot/foot_planner/TerrainHeightMap.h"
 #include "ocs2_legged_robot/gait/GaitSchedule.h"
 #include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
 
@@ -54,12 +56,39 @@ class SwitchedModelReferenceManager : public ReferenceManager {
 
   const std::shared_ptr<SwingTrajectoryPlanner>& getSwingTrajectoryPlanner() { return swingTrajectoryPtr_; }
 
+  /**
+   * Sets a new terrain height map. The map is moved into a buffer and becomes active at the next preSolverRun, hence this method
+   * can be called from a perception thread while the solver is running.
+   */
+  void setTerrainHeightMap(TerrainHeightMap&& terrainHeightMap) { terrainHeightMap_.setBuffer(std::move(terrainHeightMap)); }
+
+  /** Gets the active terrain height map. It is empty until a map is set. */
+  const TerrainHeightMap& getTerrainHeightMap() const { return terrainHeightMap_.get(); }
+
+  /**
+   * Sets the nominal position of each foot relative to the base, expressed in the yaw-aligned base frame. The terrain height of a
+   * foot is sampled at this offset from the desired base position. The offsets are zero by default.
+   */
+  void setNominalFootOffsets(const feet_array_t<vector3_t>& nominalFootOffsets) { nominalFootOffsets_ = nominalFootOffsets; }
+
  private:
   void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
                         ModeSchedule& modeSchedule) override;
 
+  /**
+   * Computes the lift-off and touch-down heights of each foot and mode from the terrain height map. The terrain is sampled below
+   * the nominal foot position, i.e., the desired base position plus the foot offset rotated by the desired base yaw. A swing phase
+   * may span several modes, hence the terrain is sampled at the lift-off and touch-down times of the swing phase and the same pair
+   * of heights is assigned to all of its modes. The modes of a stance phase get the height at the start of the phase.
+   */
+  std::pair<feet_array_t<scalar_array_t>, feet_array_t<scalar_array_t>> getTerrainHeightSequences(
+      scalar_t initTime, scalar_t finalTime, const vector_t& initState, const TargetTrajectories& targetTrajectories,
+      const ModeSchedule& modeSchedule) const;
+
   std::shared_ptr<GaitSchedule> gaitSchedulePtr_;
   std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr_;
+  BufferedValue<TerrainHeightMap> terrainHeightMap_;
+  feet_array_t<vector3_t> nominalFootOffsets_;
 };
 
 }  // namespace legged_robot
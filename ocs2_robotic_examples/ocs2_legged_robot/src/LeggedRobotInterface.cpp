@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_legged_robot/LeggedRobotPreComputation.h"
 #include "ocs2_legged_robot/constraint/FrictionConeConstraint.h"
+#include "ocs2_legged_robot/constraint/FrictionConeSoftConstraint.h"
 #include "ocs2_legged_robot/constraint/NormalVelocityConstraintCppAd.h"
 #include "ocs2_legged_robot/constraint/ZeroForceConstraint.h"
 #include "ocs2_legged_robot/constraint/ZeroVelocityConstraintCppAd.h"
@@ -126,6 +127,7 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   // Mode schedule manager
   referenceManagerPtr_ =
       std::make_shared<SwitchedModelReferenceManager>(loadGaitSchedule(referenceFile, verbose), std::move(swingTrajectoryPlanner));
+  referenceManagerPtr_->setNominalFootOffsets(computeNominalFootOffsets());
 
   // Optimal control problem
   problemPtr_.reset(new OptimalControlProblem);
@@ -152,6 +154,12 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   RelaxedBarrierPenalty::Config barrierPenaltyConfig;
   std::tie(frictionCoefficient, barrierPenaltyConfig) = loadFrictionConeSettings(taskFile, verbose);
 
+  bool useBatchedFrictionCone = false;
+  loadData::loadCppDataType(taskFile, "legged_robot_interface.useBatchedFrictionCone", useBatchedFrictionCone);
+  if (useBatchedFrictionCone) {
+    problemPtr_->softConstraintPtr->add("frictionCone", getFrictionConeSoftConstraint(frictionCoefficient, barrierPenaltyConfig));
+  }
+
   bool useAnalyticalGradientsConstraints = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsConstraints", useAnalyticalGradientsConstraints);
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
@@ -174,8 +182,10 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
                                                                     modelSettings_.recompileLibrariesCppAd, modelSettings_.verboseCppAd));
     }
 
-    problemPtr_->softConstraintPtr->add(footName + "_frictionCone",
-                                        getFrictionConeConstraint(i, frictionCoefficient, barrierPenaltyConfig));
+    if (!useBatchedFrictionCone) {
+      problemPtr_->softConstraintPtr->add(footName + "_frictionCone",
+                                          getFrictionConeConstraint(i, frictionCoefficient, barrierPenaltyConfig));
+    }
     problemPtr_->equalityConstraintPtr->add(footName + "_zeroForce", getZeroForceConstraint(i));
     problemPtr_->equalityConstraintPtr->add(footName + "_zeroVelocity",
                                             getZeroVelocityConstraint(*eeKinematicsPtr, i, useAnalyticalGradientsConstraints));
@@ -282,6 +292,23 @@ std::unique_ptr<StateInputCost> LeggedRobotInterface::getBaseTrackingCost(const
   return std::unique_ptr<StateInputCost>(new LeggedRobotStateInputQuadraticCost(std::move(Q), std::move(R), info, *referenceManagerPtr_));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+feet_array_t<vector3_t> LeggedRobotInterface::computeNominalFootOffsets() {
+  // the nominal configuration has the base at the origin and aligned with the world frame
+  const auto& model = pinocchioInterfacePtr_->getModel();
+  auto& data = pinocchioInterfacePtr_->getData();
+  pinocchio::forwardKinematics(model, data, centroidalModelInfo_.qPinocchioNominal);
+  pinocchio::updateFramePlacements(model, data);
+
+  feet_array_t<vector3_t> nominalFootOffsets;
+  for (size_t i = 0; i < nominalFootOffsets.size(); i++) {
+    nominalFootOffsets[i] = data.oMf[model.getBodyId(modelSettings_.contactNames3DoF[i])].translation();
+  }
+  return nominalFootOffsets;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -321,6 +348,18 @@ std::unique_ptr<StateInputCost> LeggedRobotInterface::getFrictionConeConstraint(
   return std::unique_ptr<StateInputCost>(new StateInputSoftConstraint(std::move(frictionConeConstraintPtr), std::move(penalty)));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputCost> LeggedRobotInterface::getFrictionConeSoftConstraint(
+    scalar_t frictionCoefficient, const RelaxedBarrierPenalty::Config& barrierPenaltyConfig) {
+  FrictionConeConstraint::Config frictionConeConConfig(frictionCoefficient);
+  std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty(barrierPenaltyConfig));
+
+  return std::unique_ptr<StateInputCost>(
+      new FrictionConeSoftConstraint(*referenceManagerPtr_, std::move(frictionConeConConfig), centroidalModelInfo_, std::move(penalty)));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,177 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/constraint/FrictionConeSoftConstraint.h"
+
+#include <algorithm>
+
+#include <ocs2_centroidal_model/AccessHelperFunctions.h>
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FrictionConeSoftConstraint::FrictionConeSoftConstraint(const SwitchedModelReferenceManager& referenceManager,
+                                                       FrictionConeConstraint::Config config, CentroidalModelInfo info,
+                                                       std::unique_ptr<PenaltyBase> penaltyPtr)
+    : referenceManagerPtr_(&referenceManager), config_(std::move(config)), info_(std::move(info)), penaltyPtr_(std::move(penaltyPtr)) {
+  forces_.x.setZero(info_.numThreeDofContacts);
+  forces_.y.setZero(info_.numThreeDofContacts);
+  forces_.z.setZero(info_.numThreeDofContacts);
+  computeConeBatch(config_, forces_, cone_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FrictionConeSoftConstraint::FrictionConeSoftConstraint(const FrictionConeSoftConstraint& other)
+    : StateInputCost(other),
+      referenceManagerPtr_(other.referenceManagerPtr_),
+      config_(other.config_),
+      info_(other.info_),
+      penaltyPtr_(other.penaltyPtr_->clone()),
+      forces_(other.forces_),
+      cone_(other.cone_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool FrictionConeSoftConstraint::isActive(scalar_t time) const {
+  const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
+  return std::any_of(contactFlags.begin(), contactFlags.begin() + info_.numThreeDofContacts, [](bool flag) { return flag; });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrictionConeSoftConstraint::updateForces(const vector_t& input) const {
+  for (size_t i = 0; i < info_.numThreeDofContacts; i++) {
+    const auto force = centroidal_model::getContactForces(input, i, info_);
+    forces_.x(i) = force(0);
+    forces_.y(i) = force(1);
+    forces_.z(i) = force(2);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FrictionConeSoftConstraint::computeConeBatch(const FrictionConeConstraint::Config& config, const ForceBatch& localForces,
+                                                  ConeBatch& cone, bool computeDerivatives) {
+  const auto numForces = localForces.x.size();
+  const auto Fx = localForces.x.array();
+  const auto Fy = localForces.y.array();
+  const auto Fz = localForces.z.array();
+
+  // lazy expressions, evaluated element-wise in the assignments below without temporaries
+  const auto F_tangent_square = Fx * Fx + Fy * Fy + config.regularization;
+  const auto F_tangent_norm = F_tangent_square.sqrt();
+  const auto F_tangent_square_pow32 = F_tangent_norm * F_tangent_square;  // = F_tangent_square ^ (3/2)
+
+  cone.value.resize(numForces);
+  cone.value.array() = config.frictionCoefficient * (Fz + config.gripperForce) - F_tangent_norm;
+
+  if (computeDerivatives) {
+    cone.dCone_dFx.resize(numForces);
+    cone.dCone_dFy.resize(numForces);
+    cone.dCone_dFx.array() = -Fx / F_tangent_norm;
+    cone.dCone_dFy.array() = -Fy / F_tangent_norm;
+
+    cone.d2Cone_dFxdFx.resize(numForces);
+    cone.d2Cone_dFxdFy.resize(numForces);
+    cone.d2Cone_dFydFy.resize(numForces);
+    cone.d2Cone_dFxdFx.array() = -(Fy * Fy + config.regularization) / F_tangent_square_pow32;
+    cone.d2Cone_dFxdFy.array() = Fx * Fy / F_tangent_square_pow32;
+    cone.d2Cone_dFydFy.array() = -(Fx * Fx + config.regularization) / F_tangent_square_pow32;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t FrictionConeSoftConstraint::getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories&,
+                                              const PreComputation&) const {
+  const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
+  updateForces(input);
+  computeConeBatch(config_, forces_, cone_, false);
+
+  scalar_t penalty = 0.0;
+  for (size_t i = 0; i < info_.numThreeDofContacts; i++) {
+    if (contactFlags[i]) {
+      penalty += penaltyPtr_->getValue(time, cone_.value(i));
+    }
+  }
+  return penalty;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation FrictionConeSoftConstraint::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                           const vector_t& input,
+                                                                                           const TargetTrajectories&,
+                                                                                           const PreComputation&) const {
+  const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
+  updateForces(input);
+  computeConeBatch(config_, forces_, cone_);
+
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(state.size(), input.size());
+  scalar_t penaltyDerivativeSum = 0.0;
+  for (size_t i = 0; i < info_.numThreeDofContacts; i++) {
+    if (!contactFlags[i]) {
+      continue;
+    }
+    const size_t inputIndex = 3 * i;
+    const scalar_t penaltyDerivative = penaltyPtr_->getDerivative(time, cone_.value(i));
+    const scalar_t penaltySecondDerivative = penaltyPtr_->getSecondDerivative(time, cone_.value(i));
+    const vector3_t dCone_du(cone_.dCone_dFx(i), cone_.dCone_dFy(i), config_.frictionCoefficient);
+
+    matrix3_t d2Cone_du2 = matrix3_t::Zero();
+    d2Cone_du2(0, 0) = cone_.d2Cone_dFxdFx(i);
+    d2Cone_du2(0, 1) = d2Cone_du2(1, 0) = cone_.d2Cone_dFxdFy(i);
+    d2Cone_du2(1, 1) = cone_.d2Cone_dFydFy(i);
+
+    penaltyApproximation.f += penaltyPtr_->getValue(time, cone_.value(i));
+    penaltyApproximation.dfdu.segment<3>(inputIndex) = penaltyDerivative * dCone_du;
+    penaltyApproximation.dfduu.block<3, 3>(inputIndex, inputIndex).noalias() =
+        penaltySecondDerivative * dCone_du * dCone_du.transpose() + penaltyDerivative * d2Cone_du2;
+    penaltyDerivativeSum += penaltyDerivative;
+  }
+
+  // the Hessian shift of each cone, see FrictionConeConstraint::Config
+  penaltyApproximation.dfdxx.diagonal().array() -= config_.hessianDiagonalShift * penaltyDerivativeSum;
+  penaltyApproximation.dfduu.diagonal().array() -= config_.hessianDiagonalShift * penaltyDerivativeSum;
+
+  return penaltyApproximation;
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
@@ -32,8 +32,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
 
-#include <ocs2_core/misc/Lookup.h>
-
 #include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
 
 namespace ocs2 {
@@ -48,16 +46,16 @@ SwingTrajectoryPlanner::SwingTrajectoryPlanner(Config config, size_t numFeet) :
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t SwingTrajectoryPlanner::getZvelocityConstraint(size_t leg, scalar_t time) const {
-  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[leg], time);
-  return feetHeightTrajectories_[leg][index].velocity(time);
+  const auto index = findPhaseIndex(time);
+  return feetHeightTrajectories_[leg][index]->velocity(time);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t SwingTrajectoryPlanner::getZpositionConstraint(size_t leg, scalar_t time) const {
-  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[leg], time);
-  return feetHeightTrajectories_[leg][index].position(time);
+  const auto index = findPhaseIndex(time);
+  return feetHeightTrajectories_[leg][index]->position(time);
 }
 
 /******************************************************************************************************/
@@ -89,6 +87,11 @@ void SwingTrajectoryPlanner::update(const ModeSchedule& modeSchedule, const feet
   }
 
   for (size_t j = 0; j < numFeet_; j++) {
+    std::vector<SwingPhase> previousSwingPhases;
+    previousSwingPhases.swap(feetSwingPhases_[j]);
+    size_t searchIndex = 0;
+    auto& swingPhases = feetSwingPhases_[j];
+
     feetHeightTrajectories_[j].clear();
     feetHeightTrajectories_[j].reserve(modeSequence.size());
     for (int p = 0; p < modeSequence.size(); ++p) {
@@ -97,24 +100,108 @@ void SwingTrajectoryPlanner::update(const ModeSchedule& modeSchedule, const feet
         const int swingFinalIndex = finalTimesIndices[j][p];
         checkThatIndicesAreValid(j, p, swingStartIndex, swingFinalIndex, modeSequence);
 
-        const scalar_t swingStartTime = eventTimes[swingStartIndex];
-        const scalar_t swingFinalTime = eventTimes[swingFinalIndex];
+        const scalar_t liftOffTime = eventTimes[swingStartIndex];
+        const scalar_t touchDownTime = eventTimes[swingFinalIndex];
+        const scalar_t liftOffHeight = liftOffHeightSequence[j][p];
+        const scalar_t touchDownHeight = touchDownHeightSequence[j][p];
+
+        // A swing between coincident event times has zero duration. Its modes are never active, hence it is skipped and they get
+        // the constant trajectory of a stance leg below.
+        if (liftOffTime < touchDownTime) {
+          // the modes of a swing phase share the same spline unless their heights differ
+          if (swingPhases.empty() || !swingPhases.back().matches(liftOffTime, touchDownTime, liftOffHeight, touchDownHeight)) {
+            swingPhases.push_back(
+                getSwingPhase(previousSwingPhases, searchIndex, liftOffTime, touchDownTime, liftOffHeight, touchDownHeight));
+          }
+          feetHeightTrajectories_[j].push_back(swingPhases.back().spline);
+          continue;
+        }
+      }
 
-        const scalar_t scaling = swingTrajectoryScaling(swingStartTime, swingFinalTime, config_.swingTimeScale);
+      // for a stance leg
+      // Note: setting the time here arbitrarily to 0.0 -> 1.0 makes the assert in CubicSpline fail
+      const CubicSpline::Node liftOff{0.0, liftOffHeightSequence[j][p], 0.0};
+      const CubicSpline::Node touchDown{1.0, liftOffHeightSequence[j][p], 0.0};
+      feetHeightTrajectories_[j].push_back(std::make_shared<const SplineCpg>(liftOff, liftOffHeightSequence[j][p], touchDown));
+    }
+  }
 
-        const CubicSpline::Node liftOff{swingStartTime, liftOffHeightSequence[j][p], scaling * config_.liftOffVelocity};
-        const CubicSpline::Node touchDown{swingFinalTime, touchDownHeightSequence[j][p], scaling * config_.touchDownVelocity};
-        const scalar_t midHeight = std::min(liftOffHeightSequence[j][p], touchDownHeightSequence[j][p]) + scaling * config_.swingHeight;
-        feetHeightTrajectories_[j].emplace_back(liftOff, midHeight, touchDown);
-      } else {  // for a stance leg
-        // Note: setting the time here arbitrarily to 0.0 -> 1.0 makes the assert in CubicSpline fail
-        const CubicSpline::Node liftOff{0.0, liftOffHeightSequence[j][p], 0.0};
-        const CubicSpline::Node touchDown{1.0, liftOffHeightSequence[j][p], 0.0};
-        feetHeightTrajectories_[j].emplace_back(liftOff, liftOffHeightSequence[j][p], touchDown);
-      }
+  eventTimes_ = eventTimes;
+  updateEventTimesGrid();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto SwingTrajectoryPlanner::getSwingPhase(const std::vector<SwingPhase>& previousSwingPhases, size_t& searchIndex,
+                                           scalar_t liftOffTime, scalar_t touchDownTime, scalar_t liftOffHeight,
+                                           scalar_t touchDownHeight) -> SwingPhase {
+  while (searchIndex < previousSwingPhases.size() && previousSwingPhases[searchIndex].liftOffTime < liftOffTime) {
+    ++searchIndex;
+  }
+
+  for (size_t i = searchIndex; i < previousSwingPhases.size() && previousSwingPhases[i].liftOffTime == liftOffTime; ++i) {
+    if (previousSwingPhases[i].matches(liftOffTime, touchDownTime, liftOffHeight, touchDownHeight)) {
+      return previousSwingPhases[i];
     }
-    feetHeightTrajectoriesEvents_[j] = eventTimes;
   }
+
+  const scalar_t scaling = swingTrajectoryScaling(liftOffTime, touchDownTime, config_.swingTimeScale);
+
+  const CubicSpline::Node liftOff{liftOffTime, liftOffHeight, scaling * config_.liftOffVelocity};
+  const CubicSpline::Node touchDown{touchDownTime, touchDownHeight, scaling * config_.touchDownVelocity};
+  const scalar_t midHeight = std::min(liftOffHeight, touchDownHeight) + scaling * config_.swingHeight;
+  ++numGeneratedSwingPhases_;
+  return {liftOffTime, touchDownTime, liftOffHeight, touchDownHeight, std::make_shared<const SplineCpg>(liftOff, midHeight, touchDown)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwingTrajectoryPlanner::updateEventTimesGrid() {
+  eventTimesGrid_.clear();
+  if (eventTimes_.empty()) {
+    return;
+  }
+
+  // on average one event time per grid cell. If all event times coincide, the grid has a single cell, since findPhaseIndex
+  // resolves the times outside of the event times without it.
+  const scalar_t duration = eventTimes_.back() - eventTimes_.front();
+  const size_t numCells = (duration > 0.0) ? eventTimes_.size() : 1;
+  eventTimesGridStep_ = (duration > 0.0) ? duration / static_cast<scalar_t>(numCells) : 1.0;
+
+  eventTimesGrid_.reserve(numCells);
+  size_t index = 0;
+  for (size_t i = 0; i < numCells; i++) {
+    const scalar_t gridTime = eventTimes_.front() + static_cast<scalar_t>(i) * eventTimesGridStep_;
+    // coincident event times share the index of the first one, and the index is clamped to the last event time
+    while (index + 1 < eventTimes_.size() && eventTimes_[index] < gridTime) {
+      ++index;
+    }
+    eventTimesGrid_.push_back(index);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SwingTrajectoryPlanner::findPhaseIndex(scalar_t time) const {
+  if (eventTimes_.empty() || time <= eventTimes_.front()) {
+    return 0;
+  } else if (time > eventTimes_.back()) {
+    return eventTimes_.size();
+  }
+
+  const auto cell = std::min(static_cast<size_t>((time - eventTimes_.front()) / eventTimesGridStep_), eventTimesGrid_.size() - 1);
+  size_t index = eventTimesGrid_[cell];
+  // correct for round-off in the cell computation
+  while (index > 0 && eventTimes_[index - 1] >= time) {
+    --index;
+  }
+  while (eventTimes_[index] < time) {
+    ++index;
+  }
+  return index;
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,166 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/foot_planner/TerrainHeightMap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TerrainHeightMap::TerrainHeightMap(const vector2_t& position, scalar_t resolution, matrix_t heights, size_t numLevels)
+    : position_(position) {
+  if (heights.size() == 0) {
+    throw std::runtime_error("[TerrainHeightMap] The height map has no grid points.");
+  }
+  if (resolution <= 0.0) {
+    throw std::runtime_error("[TerrainHeightMap] The resolution should be positive.");
+  }
+  if (numLevels == 0) {
+    throw std::runtime_error("[TerrainHeightMap] The number of levels should be at least one.");
+  }
+
+  const auto rows = heights.rows();
+  const auto cols = heights.cols();
+
+  // gradients by central differences, one-sided on the border
+  gradientX_.setZero(rows, cols);
+  gradientY_.setZero(rows, cols);
+  for (Eigen::Index j = 0; j < cols; j++) {
+    for (Eigen::Index i = 0; i < rows; i++) {
+      const auto iMin = std::max<Eigen::Index>(i - 1, 0);
+      const auto iMax = std::min<Eigen::Index>(i + 1, rows - 1);
+      const auto jMin = std::max<Eigen::Index>(j - 1, 0);
+      const auto jMax = std::min<Eigen::Index>(j + 1, cols - 1);
+      if (iMax > iMin) {
+        gradientX_(i, j) = (heights(iMax, j) - heights(iMin, j)) / ((iMax - iMin) * resolution);
+      }
+      if (jMax > jMin) {
+        gradientY_(i, j) = (heights(i, jMax) - heights(i, jMin)) / ((jMax - jMin) * resolution);
+      }
+    }
+  }
+
+  // normals
+  for (auto& n : normal_) {
+    n.resize(rows, cols);
+  }
+  for (Eigen::Index j = 0; j < cols; j++) {
+    for (Eigen::Index i = 0; i < rows; i++) {
+      const vector3_t normal = vector3_t(-gradientX_(i, j), -gradientY_(i, j), 1.0).normalized();
+      for (size_t k = 0; k < 3; k++) {
+        normal_[k](i, j) = normal(k);
+      }
+    }
+  }
+
+  // resolution levels
+  levels_.reserve(numLevels);
+  levels_.push_back({resolution, std::move(heights)});
+  for (size_t l = 1; l < numLevels; l++) {
+    const auto& finer = levels_.back().heights;
+    const Eigen::Index coarseRows = (finer.rows() + 1) / 2;
+    const Eigen::Index coarseCols = (finer.cols() + 1) / 2;
+    matrix_t coarse(coarseRows, coarseCols);
+    for (Eigen::Index j = 0; j < coarseCols; j++) {
+      for (Eigen::Index i = 0; i < coarseRows; i++) {
+        const auto numRows = std::min<Eigen::Index>(2, finer.rows() - 2 * i);
+        const auto numCols = std::min<Eigen::Index>(2, finer.cols() - 2 * j);
+        coarse(i, j) = finer.block(2 * i, 2 * j, numRows, numCols).maxCoeff();
+      }
+    }
+    levels_.push_back({2.0 * levels_.back().resolution, std::move(coarse)});
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t TerrainHeightMap::getHeight(scalar_t x, scalar_t y, size_t level) const {
+  assert(level < levels_.size());
+  const auto& mapLevel = levels_[level];
+  return interpolate(mapLevel.heights, getInterpolationPoint(x, y, mapLevel));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto TerrainHeightMap::getGradient(scalar_t x, scalar_t y) const -> vector2_t {
+  assert(!empty());
+  const auto point = getInterpolationPoint(x, y, levels_.front());
+  return {interpolate(gradientX_, point), interpolate(gradientY_, point)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector3_t TerrainHeightMap::getNormal(scalar_t x, scalar_t y) const {
+  assert(!empty());
+  const auto point = getInterpolationPoint(x, y, levels_.front());
+  const vector3_t normal(interpolate(normal_[0], point), interpolate(normal_[1], point), interpolate(normal_[2], point));
+  return normal.normalized();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto TerrainHeightMap::getInterpolationPoint(scalar_t x, scalar_t y, const Level& level) const -> InterpolationPoint {
+  const auto rows = level.heights.rows();
+  const auto cols = level.heights.cols();
+
+  // continuous grid coordinates, clamped to the map
+  const scalar_t gridX = std::min(std::max((x - position_.x()) / level.resolution, 0.0), static_cast<scalar_t>(rows - 1));
+  const scalar_t gridY = std::min(std::max((y - position_.y()) / level.resolution, 0.0), static_cast<scalar_t>(cols - 1));
+
+  InterpolationPoint point;
+  point.i = std::min(static_cast<Eigen::Index>(gridX), std::max<Eigen::Index>(rows - 2, 0));
+  point.j = std::min(static_cast<Eigen::Index>(gridY), std::max<Eigen::Index>(cols - 2, 0));
+  point.wx = gridX - static_cast<scalar_t>(point.i);
+  point.wy = gridY - static_cast<scalar_t>(point.j);
+  return point;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t TerrainHeightMap::interpolate(const matrix_t& values, const InterpolationPoint& point) {
+  const auto iNext = std::min<Eigen::Index>(point.i + 1, values.rows() - 1);
+  const auto jNext = std::min<Eigen::Index>(point.j + 1, values.cols() - 1);
+  const scalar_t lower = (1.0 - point.wx) * values(point.i, point.j) + point.wx * values(iNext, point.j);
+  const scalar_t upper = (1.0 - point.wx) * values(point.i, jNext) + point.wx * values(iNext, jNext);
+  return (1.0 - point.wy) * lower + point.wy * upper;
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
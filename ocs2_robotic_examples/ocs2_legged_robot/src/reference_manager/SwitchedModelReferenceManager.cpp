@@ -39,7 +39,10 @@ SwitchedModelReferenceManager::SwitchedModelReferenceManager(std::shared_ptr<Gai
                                                              std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr)
     : ReferenceManager(TargetTrajectories(), ModeSchedule()),
       gaitSchedulePtr_(std::move(gaitSchedulePtr)),
-      swingTrajectoryPtr_(std::move(swingTrajectoryPtr)) {}
+      swingTrajectoryPtr_(std::move(swingTrajectoryPtr)),
+      terrainHeightMap_(TerrainHeightMap()) {
+  nominalFootOffsets_.fill(vector3_t::Zero());
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -56,8 +59,85 @@ void SwitchedModelReferenceManager::modifyReferences(scalar_t initTime, scalar_t
   const auto timeHorizon = finalTime - initTime;
   modeSchedule = gaitSchedulePtr_->getModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
 
-  const scalar_t terrainHeight = 0.0;
-  swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+  terrainHeightMap_.updateFromBuffer();
+  if (terrainHeightMap_.get().empty()) {
+    const scalar_t terrainHeight = 0.0;
+    swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+  } else {
+    feet_array_t<scalar_array_t> liftOffHeightSequence;
+    feet_array_t<scalar_array_t> touchDownHeightSequence;
+    std::tie(liftOffHeightSequence, touchDownHeightSequence) =
+        getTerrainHeightSequences(initTime, finalTime, initState, targetTrajectories, modeSchedule);
+    swingTrajectoryPtr_->update(modeSchedule, liftOffHeightSequence, touchDownHeightSequence);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<feet_array_t<scalar_array_t>, feet_array_t<scalar_array_t>> SwitchedModelReferenceManager::getTerrainHeightSequences(
+    scalar_t initTime, scalar_t finalTime, const vector_t& initState, const TargetTrajectories& targetTrajectories,
+    const ModeSchedule& modeSchedule) const {
+  const auto& terrainHeightMap = terrainHeightMap_.get();
+  const auto& eventTimes = modeSchedule.eventTimes;
+  const size_t numModes = modeSchedule.modeSequence.size();
+  const size_t numFeet = nominalFootOffsets_.size();
+
+  // the base pose in the centroidal model state starts with the position followed by the ZYX Euler angles
+  const Eigen::Index basePositionIndex = 6;
+  const Eigen::Index baseYawIndex = 9;
+  auto getTerrainHeights = [&](scalar_t time) {
+    const vector_t state = targetTrajectories.empty() ? initState : targetTrajectories.getDesiredState(time);
+    const Eigen::Rotation2D<scalar_t> baseYaw(state(baseYawIndex));
+    const Eigen::Matrix<scalar_t, 2, 1> basePosition = state.segment<2>(basePositionIndex);
+    feet_array_t<scalar_t> terrainHeights;
+    for (size_t i = 0; i < numFeet; i++) {
+      const Eigen::Matrix<scalar_t, 2, 1> footPosition = basePosition + baseYaw * nominalFootOffsets_[i].head<2>();
+      terrainHeights[i] = terrainHeightMap.getHeight(footPosition.x(), footPosition.y());
+    }
+    return terrainHeights;
+  };
+
+  // the terrain heights at the mode boundaries, i.e., the initial time, the event times, and the final time
+  std::vector<feet_array_t<scalar_t>> boundaryHeights;
+  boundaryHeights.reserve(numModes + 1);
+  for (size_t k = 0; k <= numModes; k++) {
+    const scalar_t time = (k == 0) ? initTime : (k <= eventTimes.size() ? eventTimes[k - 1] : finalTime);
+    boundaryHeights.push_back(getTerrainHeights(time));
+  }
+
+  std::vector<contact_flag_t> contactFlagStock;
+  contactFlagStock.reserve(numModes);
+  for (const auto mode : modeSchedule.modeSequence) {
+    contactFlagStock.push_back(modeNumber2StanceLeg(mode));
+  }
+
+  feet_array_t<scalar_array_t> liftOffHeightSequence;
+  feet_array_t<scalar_array_t> touchDownHeightSequence;
+  for (size_t i = 0; i < numFeet; i++) {
+    liftOffHeightSequence[i].resize(numModes);
+    touchDownHeightSequence[i].resize(numModes);
+
+    // a phase is a maximal sequence of modes with the same contact flag. All modes of a swing phase get the heights at its lift-off
+    // and touch-down, and all modes of a stance phase get the height at its start, i.e., where the foot touched down.
+    size_t phaseStart = 0;
+    while (phaseStart < numModes) {
+      const bool inContact = contactFlagStock[phaseStart][i];
+      size_t phaseEnd = phaseStart + 1;
+      while (phaseEnd < numModes && contactFlagStock[phaseEnd][i] == inContact) {
+        ++phaseEnd;
+      }
+      const scalar_t liftOffHeight = boundaryHeights[phaseStart][i];
+      const scalar_t touchDownHeight = inContact ? liftOffHeight : boundaryHeights[phaseEnd][i];
+      for (size_t p = phaseStart; p < phaseEnd; p++) {
+        liftOffHeightSequence[i][p] = liftOffHeight;
+        touchDownHeightSequence[i][p] = touchDownHeight;
+      }
+      phaseStart = phaseEnd;
+    }
+  }
+
+  return {std::move(liftOffHeightSequence), std::move(touchDownHeightSequence)};
 }
 
 }  // namespace legged_robot
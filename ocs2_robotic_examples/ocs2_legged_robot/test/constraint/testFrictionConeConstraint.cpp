@@ -28,12 +28,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <iostream>
 
 #include <ocs2_centroidal_model/AccessHelperFunctions.h>
+#include <ocs2_core/cost/StateInputCostCollection.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
+#include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 
 #include "ocs2_legged_robot/constraint/FrictionConeConstraint.h"
+#include "ocs2_legged_robot/constraint/FrictionConeSoftConstraint.h"
 #include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
 
 using namespace ocs2;
@@ -202,3 +207,94 @@ TEST_F(TestFrictionConeConstraint, negativeDefinite) {
     ASSERT_LT(LinearAlgebra::symmetricEigenvalues(quadraticApproximation.dfduu.front()).maxCoeff(), 0.0);
   }
 }
+
+TEST_F(TestFrictionConeConstraint, coneBatch) {
+  const FrictionConeConstraint::Config config;
+  const size_t numNodes = 10;
+  const size_t numContacts = centroidalModelInfo.numThreeDofContacts;
+
+  // the contact forces of several nodes
+  FrictionConeSoftConstraint::ForceBatch forces;
+  forces.x.resize(numNodes * numContacts);
+  forces.y.resize(numNodes * numContacts);
+  forces.z.resize(numNodes * numContacts);
+  std::vector<vector_t> inputs(numNodes);
+  for (size_t n = 0; n < numNodes; n++) {
+    inputs[n] = 10.0 * vector_t::Random(centroidalModelInfo.inputDim);
+    for (size_t legNumber = 0; legNumber < numContacts; ++legNumber) {
+      const vector3_t force = centroidal_model::getContactForces(inputs[n], legNumber, centroidalModelInfo);
+      forces.x(n * numContacts + legNumber) = force(0);
+      forces.y(n * numContacts + legNumber) = force(1);
+      forces.z(n * numContacts + legNumber) = force(2);
+    }
+  }
+
+  FrictionConeSoftConstraint::ConeBatch cone;
+  FrictionConeSoftConstraint::computeConeBatch(config, forces, cone);
+
+  const vector_t x = vector_t::Random(centroidalModelInfo.stateDim);
+  for (size_t legNumber = 0; legNumber < numContacts; ++legNumber) {
+    FrictionConeConstraint frictionConeConstraint(*referenceManagerPtr, config, legNumber, centroidalModelInfo);
+    for (size_t n = 0; n < numNodes; n++) {
+      const size_t k = n * numContacts + legNumber;
+      const auto quadraticApproximation = frictionConeConstraint.getQuadraticApproximation(0.0, x, inputs[n], preComputation);
+      const matrix_t ddhdudu = quadraticApproximation.dfduu.front().block<3, 3>(3 * legNumber, 3 * legNumber);
+      EXPECT_DOUBLE_EQ(cone.value(k), quadraticApproximation.f(0));
+      const vector3_t dCone_dF(cone.dCone_dFx(k), cone.dCone_dFy(k), config.frictionCoefficient);
+      EXPECT_TRUE(dCone_dF.transpose().isApprox(quadraticApproximation.dfdu.block<1, 3>(0, 3 * legNumber)));
+      EXPECT_DOUBLE_EQ(cone.d2Cone_dFxdFx(k), ddhdudu(0, 0) + config.hessianDiagonalShift);
+      EXPECT_DOUBLE_EQ(cone.d2Cone_dFxdFy(k), ddhdudu(0, 1));
+      EXPECT_DOUBLE_EQ(cone.d2Cone_dFydFy(k), ddhdudu(1, 1) + config.hessianDiagonalShift);
+    }
+  }
+}
+
+TEST_F(TestFrictionConeConstraint, softConstraint) {
+  const FrictionConeConstraint::Config config;
+  const RelaxedBarrierPenalty::Config barrierPenaltyConfig(0.1, 5.0);
+  const TargetTrajectories targetTrajectories;
+  const scalar_t tol = 1e-9;
+
+  // a trotting gait after the initial stance phase
+  const ModeSequenceTemplate trot({0.0, 0.3, 0.6}, {ModeNumber::LF_RH, ModeNumber::RF_LH});
+  referenceManagerPtr->getGaitSchedule()->insertModeSequenceTemplate(trot, 0.5, 2.0);
+  referenceManagerPtr->preSolverRun(0.0, 2.0, vector_t::Zero(centroidalModelInfo.stateDim));
+
+  // one soft constraint per contact
+  StateInputCostCollection perContactSoftConstraints;
+  for (size_t legNumber = 0; legNumber < centroidalModelInfo.numThreeDofContacts; ++legNumber) {
+    std::unique_ptr<StateInputConstraint> constraintPtr(
+        new FrictionConeConstraint(*referenceManagerPtr, config, legNumber, centroidalModelInfo));
+    std::unique_ptr<PenaltyBase> penaltyPtr(new RelaxedBarrierPenalty(barrierPenaltyConfig));
+    std::unique_ptr<StateInputCost> softConstraintPtr(new StateInputSoftConstraint(std::move(constraintPtr), std::move(penaltyPtr)));
+    perContactSoftConstraints.add("frictionCone" + std::to_string(legNumber), std::move(softConstraintPtr));
+  }
+
+  // all contacts in one term
+  std::unique_ptr<PenaltyBase> penaltyPtr(new RelaxedBarrierPenalty(barrierPenaltyConfig));
+  FrictionConeSoftConstraint softConstraint(*referenceManagerPtr, config, centroidalModelInfo, std::move(penaltyPtr));
+
+  for (size_t i = 0; i < 100; i++) {
+    const scalar_t t = 0.02 * i;
+    const vector_t x = vector_t::Random(centroidalModelInfo.stateDim);
+    vector_t u = 10.0 * vector_t::Random(centroidalModelInfo.inputDim);
+    for (size_t legNumber = 0; legNumber < centroidalModelInfo.numThreeDofContacts; ++legNumber) {
+      u(3 * legNumber + 2) += 50.0;
+    }
+
+    const auto contactFlags = referenceManagerPtr->getContactFlags(t);
+    const bool anyContact = std::any_of(contactFlags.begin(), contactFlags.end(), [](bool flag) { return flag; });
+    EXPECT_EQ(softConstraint.isActive(t), anyContact);
+
+    const auto expected = perContactSoftConstraints.getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+    const auto approximation = softConstraint.getQuadraticApproximation(t, x, u, targetTrajectories, preComputation);
+    EXPECT_NEAR(softConstraint.getValue(t, x, u, targetTrajectories, preComputation),
+                perContactSoftConstraints.getValue(t, x, u, targetTrajectories, preComputation), tol);
+    EXPECT_NEAR(approximation.f, expected.f, tol);
+    EXPECT_TRUE(approximation.dfdx.isApprox(expected.dfdx, tol));
+    EXPECT_TRUE(approximation.dfdu.isApprox(expected.dfdu, tol));
+    EXPECT_TRUE(approximation.dfdxx.isApprox(expected.dfdxx, tol));
+    EXPECT_TRUE(approximation.dfdux.isApprox(expected.dfdux, tol));
+    EXPECT_TRUE(approximation.dfduu.isApprox(expected.dfduu, tol));
+  }
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+
+/** A trotting mode schedule which starts and ends in stance, with phases of the given duration starting at startTime. */
+ModeSchedule getTrotModeSchedule(scalar_t startTime, scalar_t phaseDuration, size_t numSwingPhases) {
+  std::vector<size_t> modeSequence{ModeNumber::STANCE};
+  scalar_array_t eventTimes;
+  for (size_t i = 0; i < numSwingPhases; i++) {
+    eventTimes.push_back(startTime + i * phaseDuration);
+    modeSequence.push_back((i % 2 == 0) ? ModeNumber::LF_RH : ModeNumber::RF_LH);
+  }
+  eventTimes.push_back(startTime + numSwingPhases * phaseDuration);
+  modeSequence.push_back(ModeNumber::STANCE);
+  return {eventTimes, modeSequence};
+}
+
+void expectSameTrajectories(const SwingTrajectoryPlanner& planner, const SwingTrajectoryPlanner& expected, scalar_t startTime,
+                            scalar_t finalTime) {
+  const size_t numSamples = 1000;
+  for (size_t leg = 0; leg < 4; leg++) {
+    for (size_t k = 0; k <= numSamples; k++) {
+      const scalar_t time = startTime + k * (finalTime - startTime) / numSamples;
+      EXPECT_DOUBLE_EQ(planner.getZpositionConstraint(leg, time), expected.getZpositionConstraint(leg, time));
+      EXPECT_DOUBLE_EQ(planner.getZvelocityConstraint(leg, time), expected.getZvelocityConstraint(leg, time));
+    }
+  }
+}
+
+}  // unnamed namespace
+
+TEST(testSwingTrajectoryPlanner, heightTrajectory) {
+  const SwingTrajectoryPlanner::Config config;
+  SwingTrajectoryPlanner planner(config, 4);
+  const scalar_t phaseDuration = 0.3;
+  planner.update(getTrotModeSchedule(0.0, phaseDuration, 4), 0.0);
+
+  // LF is in stance during the first phase, RF is in swing
+  const scalar_t midSwingTime = 0.5 * phaseDuration;
+  EXPECT_DOUBLE_EQ(planner.getZpositionConstraint(0, midSwingTime), 0.0);
+  EXPECT_DOUBLE_EQ(planner.getZvelocityConstraint(0, midSwingTime), 0.0);
+  EXPECT_NEAR(planner.getZpositionConstraint(1, midSwingTime), config.swingHeight, 1e-9);
+  EXPECT_NEAR(planner.getZvelocityConstraint(1, midSwingTime), 0.0, 1e-9);
+
+  // lift-off and touch-down of the swing phases
+  for (size_t i = 0; i <= 4; i++) {
+    for (size_t leg = 0; leg < 4; leg++) {
+      EXPECT_NEAR(planner.getZpositionConstraint(leg, i * phaseDuration), 0.0, 1e-9);
+    }
+  }
+}
+
+TEST(testSwingTrajectoryPlanner, incrementalUpdate) {
+  const SwingTrajectoryPlanner::Config config;
+  SwingTrajectoryPlanner planner(config, 4);
+  planner.update(getTrotModeSchedule(0.0, 0.3, 6), 0.0);
+  // two feet swing in each of the 6 phases
+  EXPECT_EQ(planner.getNumGeneratedSwingPhases(), 12);
+
+  // receding horizon: the first swing phases are dropped and new ones are appended
+  ModeSchedule modeSchedule = getTrotModeSchedule(0.6, 0.3, 6);
+  planner.update(modeSchedule, 0.0);
+  SwingTrajectoryPlanner expected(config, 4);
+  expected.update(modeSchedule, 0.0);
+  expectSameTrajectories(planner, expected, 0.0, 2.7);
+  // only the two appended phases are generated
+  EXPECT_EQ(planner.getNumGeneratedSwingPhases(), 12 + 4);
+
+  // an unchanged mode schedule reuses all swing phases
+  planner.update(modeSchedule, 0.0);
+  EXPECT_EQ(planner.getNumGeneratedSwingPhases(), 16);
+
+  // a modified event time in the middle of the schedule changes the two phases around it
+  modeSchedule.eventTimes[3] += 0.05;
+  planner.update(modeSchedule, 0.0);
+  expected.update(modeSchedule, 0.0);
+  expectSameTrajectories(planner, expected, 0.0, 2.7);
+  EXPECT_EQ(planner.getNumGeneratedSwingPhases(), 16 + 4);
+
+  // a different terrain height modifies all swing phases
+  planner.update(modeSchedule, 0.1);
+  expected.update(modeSchedule, 0.1);
+  expectSameTrajectories(planner, expected, 0.0, 2.7);
+  EXPECT_EQ(planner.getNumGeneratedSwingPhases(), 20 + 12);
+  EXPECT_DOUBLE_EQ(planner.getZpositionConstraint(0, 0.0), 0.1);
+}
+
+TEST(testSwingTrajectoryPlanner, coincidentEventTimes) {
+  const SwingTrajectoryPlanner::Config config;
+  const ModeSchedule modeSchedule = getTrotModeSchedule(0.0, 0.3, 4);
+  SwingTrajectoryPlanner expected(config, 4);
+  expected.update(modeSchedule, 0.0);
+
+  // a flight mode of zero duration at the first event: every foot swings between two coincident event times
+  ModeSchedule zeroDurationModeSchedule = modeSchedule;
+  zeroDurationModeSchedule.eventTimes.insert(zeroDurationModeSchedule.eventTimes.begin(), modeSchedule.eventTimes.front());
+  zeroDurationModeSchedule.modeSequence.insert(zeroDurationModeSchedule.modeSequence.begin() + 1, ModeNumber::FLY);
+
+  // a mode of zero duration is never active, so the trajectories are the ones of the schedule without it
+  SwingTrajectoryPlanner planner(config, 4);
+  planner.update(zeroDurationModeSchedule, 0.0);
+  expectSameTrajectories(planner, expected, -0.1, 1.3);
+  EXPECT_EQ(planner.getNumGeneratedSwingPhases(), expected.getNumGeneratedSwingPhases());
+
+  // all event times coincide
+  const ModeSchedule singleInstantModeSchedule({0.5, 0.5, 0.5},
+                                               {ModeNumber::STANCE, ModeNumber::LF_RH, ModeNumber::FLY, ModeNumber::STANCE});
+  planner.update(singleInstantModeSchedule, 0.1);
+  for (size_t leg = 0; leg < 4; leg++) {
+    for (const scalar_t time : {0.0, 0.5, 1.0}) {
+      EXPECT_DOUBLE_EQ(planner.getZpositionConstraint(leg, time), 0.1);
+      EXPECT_DOUBLE_EQ(planner.getZvelocityConstraint(leg, time), 0.0);
+    }
+  }
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/foot_planner/TerrainHeightMap.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestTerrainHeightMap : public ::testing::Test {
+ public:
+  TestTerrainHeightMap() {
+    matrix_t heights(rows, cols);
+    for (size_t j = 0; j < cols; j++) {
+      for (size_t i = 0; i < rows; i++) {
+        heights(i, j) = getPlaneHeight(position.x() + i * resolution, position.y() + j * resolution);
+      }
+    }
+    terrainHeightMap = TerrainHeightMap(position, resolution, std::move(heights), 3);
+  }
+
+  scalar_t getPlaneHeight(scalar_t x, scalar_t y) const { return slopeX * x + slopeY * y + offset; }
+
+  const size_t rows = 20;
+  const size_t cols = 15;
+  const scalar_t resolution = 0.05;
+  const TerrainHeightMap::vector2_t position{-0.5, -0.3};
+  const scalar_t slopeX = 0.2;
+  const scalar_t slopeY = -0.1;
+  const scalar_t offset = 0.3;
+  TerrainHeightMap terrainHeightMap;
+};
+
+TEST_F(TestTerrainHeightMap, plane) {
+  const vector3_t expectedNormal = vector3_t(-slopeX, -slopeY, 1.0).normalized();
+  for (const scalar_t x : {-0.5, -0.42, 0.0, 0.13, 0.45}) {
+    for (const scalar_t y : {-0.3, -0.21, 0.07, 0.4}) {
+      EXPECT_NEAR(terrainHeightMap.getHeight(x, y), getPlaneHeight(x, y), 1e-12);
+      EXPECT_TRUE(terrainHeightMap.getGradient(x, y).isApprox(TerrainHeightMap::vector2_t(slopeX, slopeY)));
+      EXPECT_TRUE(terrainHeightMap.getNormal(x, y).isApprox(expectedNormal));
+    }
+  }
+}
+
+TEST_F(TestTerrainHeightMap, outsideOfMap) {
+  const scalar_t maxX = position.x() + (rows - 1) * resolution;
+  const scalar_t maxY = position.y() + (cols - 1) * resolution;
+  EXPECT_NEAR(terrainHeightMap.getHeight(-10.0, 0.0), getPlaneHeight(position.x(), 0.0), 1e-12);
+  EXPECT_NEAR(terrainHeightMap.getHeight(10.0, 10.0), getPlaneHeight(maxX, maxY), 1e-12);
+}
+
+TEST_F(TestTerrainHeightMap, levels) {
+  ASSERT_EQ(terrainHeightMap.getNumLevels(), 3);
+  for (size_t level = 1; level < terrainHeightMap.getNumLevels(); level++) {
+    EXPECT_DOUBLE_EQ(terrainHeightMap.getResolution(level), 2.0 * terrainHeightMap.getResolution(level - 1));
+    // a coarse grid point holds the maximum over the finer grid points it covers
+    const scalar_t coarseResolution = terrainHeightMap.getResolution(level);
+    for (size_t i = 0; i < 4; i++) {
+      const scalar_t x = position.x() + i * coarseResolution;
+      const scalar_t y = position.y() + i * coarseResolution;
+      const scalar_t expectedHeight = getPlaneHeight(x + coarseResolution - resolution, y);
+      EXPECT_NEAR(terrainHeightMap.getHeight(x, y, level), expectedHeight, 1e-12);
+    }
+  }
+}
+
+TEST_F(TestTerrainHeightMap, referenceManager) {
+  auto referenceManagerPtr = createReferenceManager(4);
+  referenceManagerPtr->getGaitSchedule()->insertModeSequenceTemplate(ModeSequenceTemplate({0.0, 0.3, 0.6}, {LF_RH, RF_LH}), 0.5, 2.0);
+
+  // flat terrain without a height map
+  const vector_t initState = vector_t::Zero(24);
+  referenceManagerPtr->preSolverRun(0.0, 1.0, initState);
+  const auto& swingTrajectoryPlanner = *referenceManagerPtr->getSwingTrajectoryPlanner();
+  EXPECT_DOUBLE_EQ(swingTrajectoryPlanner.getZpositionConstraint(0, 0.2), 0.0);
+
+  // the map becomes active at the next run
+  referenceManagerPtr->setTerrainHeightMap(TerrainHeightMap(terrainHeightMap));
+  EXPECT_TRUE(referenceManagerPtr->getTerrainHeightMap().empty());
+  referenceManagerPtr->preSolverRun(0.0, 1.0, initState);
+  EXPECT_FALSE(referenceManagerPtr->getTerrainHeightMap().empty());
+  EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(0, 0.2), getPlaneHeight(0.0, 0.0), 1e-12);
+}
+
+TEST_F(TestTerrainHeightMap, referenceManagerFootOffsets) {
+  auto referenceManagerPtr = createReferenceManager(4);
+  referenceManagerPtr->getGaitSchedule()->insertModeSequenceTemplate(ModeSequenceTemplate({0.0, 0.3, 0.6}, {LF_RH, RF_LH}), 0.5, 2.0);
+  feet_array_t<vector3_t> nominalFootOffsets{vector3_t(0.3, 0.2, -0.5), vector3_t(0.3, -0.2, -0.5), vector3_t(-0.3, 0.2, -0.5),
+                                             vector3_t(-0.3, -0.2, -0.5)};
+  referenceManagerPtr->setNominalFootOffsets(nominalFootOffsets);
+  referenceManagerPtr->setTerrainHeightMap(TerrainHeightMap(terrainHeightMap));
+
+  // base at (0.1, 0.02) and rotated by 90 degrees around the vertical axis
+  vector_t initState = vector_t::Zero(24);
+  initState.segment<3>(6) << 0.1, 0.02, 0.5;
+  initState(9) = 0.5 * M_PI;
+  referenceManagerPtr->preSolverRun(0.0, 1.0, initState);
+
+  const auto& swingTrajectoryPlanner = *referenceManagerPtr->getSwingTrajectoryPlanner();
+  for (size_t i = 0; i < nominalFootOffsets.size(); i++) {
+    const scalar_t footX = 0.1 - nominalFootOffsets[i].y();
+    const scalar_t footY = 0.02 + nominalFootOffsets[i].x();
+    // all feet are in stance before the inserted gait
+    EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(i, 0.2), getPlaneHeight(footX, footY), 1e-12) << "foot: " << i;
+  }
+}
+
+TEST_F(TestTerrainHeightMap, referenceManagerMultiModeSwing) {
+  auto referenceManagerPtr = createReferenceManager(4);
+  // dynamic walk: each swing phase spans two modes, e.g., LF swings through RF_RH and RF_LH_RH
+  const ModeSequenceTemplate dynamicWalk({0.0, 0.2, 0.3, 0.5, 0.7, 0.8, 1.0}, {LF_RF_RH, RF_RH, RF_LH_RH, LF_RF_LH, LF_LH, LF_LH_RH});
+  referenceManagerPtr->getGaitSchedule()->insertModeSequenceTemplate(dynamicWalk, 0.5, 3.0);
+  feet_array_t<vector3_t> nominalFootOffsets{vector3_t(0.3, 0.2, -0.5), vector3_t(0.3, -0.2, -0.5), vector3_t(-0.3, 0.2, -0.5),
+                                             vector3_t(-0.3, -0.2, -0.5)};
+  referenceManagerPtr->setNominalFootOffsets(nominalFootOffsets);
+  referenceManagerPtr->setTerrainHeightMap(TerrainHeightMap(terrainHeightMap));
+
+  // the base moves along the x-axis, hence the terrain height below each foot changes over time
+  vector_t initState = vector_t::Zero(24);
+  initState(6) = -0.2;
+  vector_t finalState = initState;
+  finalState(6) = 0.1;
+  const vector_t zeroInput = vector_t::Zero(24);
+  referenceManagerPtr->setTargetTrajectories(TargetTrajectories({0.0, 2.0}, {initState, finalState}, {zeroInput, zeroInput}));
+  referenceManagerPtr->preSolverRun(0.0, 2.0, initState);
+
+  const auto getTerrainHeight = [&](size_t foot, scalar_t time) {
+    const scalar_t baseX = initState(6) + (finalState(6) - initState(6)) * time / 2.0;
+    return getPlaneHeight(baseX + nominalFootOffsets[foot].x(), nominalFootOffsets[foot].y());
+  };
+
+  const auto& swingTrajectoryPlanner = *referenceManagerPtr->getSwingTrajectoryPlanner();
+  const auto& modeSchedule = referenceManagerPtr->getModeSchedule();
+  const auto& eventTimes = modeSchedule.eventTimes;
+  size_t numMultiModeSwings = 0;
+  for (size_t i = 0; i < nominalFootOffsets.size(); i++) {
+    size_t p = 1;
+    while (p + 1 < modeSchedule.modeSequence.size()) {
+      if (modeNumber2StanceLeg(modeSchedule.modeSequence[p])[i]) {
+        ++p;
+        continue;
+      }
+      size_t q = p;
+      while (q + 1 < modeSchedule.modeSequence.size() && !modeNumber2StanceLeg(modeSchedule.modeSequence[q + 1])[i]) {
+        ++q;
+      }
+      const scalar_t liftOffTime = eventTimes[p - 1];
+      const scalar_t touchDownTime = eventTimes[q];
+      if (touchDownTime > 2.0) {
+        break;
+      }
+      numMultiModeSwings += (q > p) ? 1 : 0;
+
+      EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(i, liftOffTime + 1e-9), getTerrainHeight(i, liftOffTime), 1e-6)
+          << "foot: " << i << ", lift-off: " << liftOffTime;
+      EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(i, touchDownTime), getTerrainHeight(i, touchDownTime), 1e-12)
+          << "foot: " << i << ", touch-down: " << touchDownTime;
+      // the height reference is continuous at the mode switches inside of the swing phase
+      for (size_t k = p; k < q; k++) {
+        EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(i, eventTimes[k]),
+                    swingTrajectoryPlanner.getZpositionConstraint(i, eventTimes[k] + 1e-9), 1e-6)
+            << "foot: " << i << ", mode switch: " << eventTimes[k];
+      }
+      // the foot stays at the touch-down height during the following stance phase
+      EXPECT_NEAR(swingTrajectoryPlanner.getZpositionConstraint(i, touchDownTime + 1e-9), getTerrainHeight(i, touchDownTime), 1e-12)
+          << "foot: " << i << ", touch-down: " << touchDownTime;
+      p = q + 1;
+    }
+  }
+  EXPECT_GT(numMultiModeSwings, 0);
+}
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
 #include <memory>
 
 #include <ocs2_mobile_manipulator/MobileManipulatorPreComputation.h>
@@ -40,8 +41,11 @@ namespace mobile_manipulator {
 class MobileManipulatorSelfCollisionConstraint final : public SelfCollisionConstraint {
  public:
   MobileManipulatorSelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping,
-                                           PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-      : SelfCollisionConstraint(mapping, std::move(pinocchioGeometryInterface), minimumDistance) {}
+                                           PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                                           scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity(),
+                                           scalar_t maxWarmStartTranslation = 0.05, scalar_t maxWarmStartRotation = 0.1)
+      : SelfCollisionConstraint(mapping, std::move(pinocchioGeometryInterface), minimumDistance, activationDistance,
+                                maxWarmStartTranslation, maxWarmStartRotation) {}
   ~MobileManipulatorSelfCollisionConstraint() override = default;
   MobileManipulatorSelfCollisionConstraint(const MobileManipulatorSelfCollisionConstraint& other) = default;
   MobileManipulatorSelfCollisionConstraint* clone() const { return new MobileManipulatorSelfCollisionConstraint(*this); }
@@ -27,6 +27,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <limits>
 #include <string>
 
 #include <pinocchio/fwd.hpp>  // forward declarations must be included first.
@@ -48,11 +50,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_pinocchio_interface/urdf.h>
 #include <ocs2_self_collision/SelfCollisionConstraint.h>
 #include <ocs2_self_collision/SelfCollisionConstraintCppAd.h>
+#include <ocs2_sphere_approximation/SphereSelfCollision.h>
 
 #include "ocs2_mobile_manipulator/ManipulatorModelInfo.h"
+#include "ocs2_mobile_manipulator/MobileManipulatorPinocchioMapping.h"
 #include "ocs2_mobile_manipulator/MobileManipulatorPreComputation.h"
 #include "ocs2_mobile_manipulator/constraint/EndEffectorConstraint.h"
 #include "ocs2_mobile_manipulator/constraint/MobileManipulatorSelfCollisionConstraint.h"
+#include "ocs2_mobile_manipulator/constraint/MobileManipulatorSphereSelfCollisionConstraint.h"
 #include "ocs2_mobile_manipulator/cost/QuadraticInputCost.h"
 #include "ocs2_mobile_manipulator/dynamics/DefaultManipulatorDynamics.h"
 #include "ocs2_mobile_manipulator/dynamics/FloatingArmManipulatorDynamics.h"
@@ -209,7 +214,16 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
    * Pre-computation
    */
   if (usePreComputation) {
-    problem_.preComputationPtr.reset(new MobileManipulatorPreComputation(*pinocchioInterfacePtr_, manipulatorModelInfo_));
+    std::unique_ptr<MobileManipulatorPreComputation> preComputationPtr(
+        new MobileManipulatorPreComputation(*pinocchioInterfacePtr_, manipulatorModelInfo_));
+    // the end-effector constraints read the frame placements; the self-collision constraint reads the joint placements
+    constexpr unsigned endEffectorValue = PinocchioPreComputation::ForwardKinematics | PinocchioPreComputation::FramePlacements;
+    preComputationPtr->addRequirement(Request::SoftConstraint, endEffectorValue, PinocchioPreComputation::JointJacobians);
+    if (activateSelfCollision) {
+      preComputationPtr->addRequirement(Request::SoftConstraint, PinocchioPreComputation::ForwardKinematics,
+                                        PinocchioPreComputation::JointJacobians);
+    }
+    problem_.preComputationPtr = std::move(preComputationPtr);
   }
 
   // Rollout
@@ -304,6 +318,12 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   scalar_t mu = 1e-2;
   scalar_t delta = 1e-3;
   scalar_t minimumDistance = 0.0;
+  scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity();
+  scalar_t maxWarmStartTranslation = 0.05;
+  scalar_t maxWarmStartRotation = 0.1;
+  bool useSphereApproximation = false;
+  scalar_t sphereMaxExcess = 0.05;
+  scalar_t sphereShrinkRatio = 0.7;
 
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(taskFile, pt);
@@ -312,10 +332,48 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   loadData::loadPtreeValue(pt, mu, prefix + ".mu", true);
   loadData::loadPtreeValue(pt, delta, prefix + ".delta", true);
   loadData::loadPtreeValue(pt, minimumDistance, prefix + ".minimumDistance", true);
+  loadData::loadPtreeValue(pt, activationDistance, prefix + ".activationDistance", true);
+  loadData::loadPtreeValue(pt, maxWarmStartTranslation, prefix + ".maxWarmStartTranslation", true);
+  loadData::loadPtreeValue(pt, maxWarmStartRotation, prefix + ".maxWarmStartRotation", true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionObjectPairs", collisionObjectPairs, true);
   loadData::loadStdVectorOfPair(taskFile, prefix + ".collisionLinkPairs", collisionLinkPairs, true);
+  loadData::loadPtreeValue(pt, useSphereApproximation, prefix + ".useSphereApproximation", true);
+  if (useSphereApproximation) {
+    loadData::loadPtreeValue(pt, sphereMaxExcess, prefix + ".sphereMaxExcess", true);
+    loadData::loadPtreeValue(pt, sphereShrinkRatio, prefix + ".sphereShrinkRatio", true);
+  }
   std::cerr << " #### =============================================================================\n";
 
+  std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty({mu, delta}));
+
+  if (useSphereApproximation) {
+    if (!usePreComputation) {
+      throw std::runtime_error(
+          "[MobileManipulatorInterface::getSelfCollisionConstraint] The sphere approximation requires usePreComputation!");
+    }
+    if (!collisionObjectPairs.empty()) {
+      std::cerr << "WARNING: the collision object pairs are ignored by the sphere approximation of self-collision\n";
+    }
+
+    // approximate every link of the collision link pairs with spheres
+    std::vector<std::string> collisionLinks;
+    for (const auto& linkPair : collisionLinkPairs) {
+      for (const auto& link : {linkPair.first, linkPair.second}) {
+        if (std::find(collisionLinks.begin(), collisionLinks.end(), link) == collisionLinks.end()) {
+          collisionLinks.push_back(link);
+        }
+      }
+    }
+    const std::vector<scalar_t> maxExcesses(collisionLinks.size(), sphereMaxExcess);
+    PinocchioSphereInterface sphereInterface(pinocchioInterface, collisionLinks, maxExcesses, sphereShrinkRatio);
+    SphereSelfCollision sphereSelfCollision(std::move(sphereInterface), pinocchioInterface, collisionLinkPairs, minimumDistance);
+    std::cerr << "SelfCollision: Testing for " << sphereSelfCollision.getNumCollisionPairs() << " sphere pairs\n";
+
+    std::unique_ptr<StateConstraint> constraint(new MobileManipulatorSphereSelfCollisionConstraint(
+        MobileManipulatorPinocchioMapping(manipulatorModelInfo_), std::move(sphereSelfCollision)));
+    return std::unique_ptr<StateCost>(new StateSoftConstraint(std::move(constraint), std::move(penalty)));
+  }
+
   PinocchioGeometryInterface geometryInterface(pinocchioInterface, collisionLinkPairs, collisionObjectPairs);
 
   const size_t numCollisionPairs = geometryInterface.getNumCollisionPairs();
@@ -324,15 +382,14 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
   std::unique_ptr<StateConstraint> constraint;
   if (usePreComputation) {
     constraint = std::unique_ptr<StateConstraint>(new MobileManipulatorSelfCollisionConstraint(
-        MobileManipulatorPinocchioMapping(manipulatorModelInfo_), std::move(geometryInterface), minimumDistance));
+        MobileManipulatorPinocchioMapping(manipulatorModelInfo_), std::move(geometryInterface), minimumDistance, activationDistance,
+        maxWarmStartTranslation, maxWarmStartRotation));
   } else {
     constraint = std::unique_ptr<StateConstraint>(new SelfCollisionConstraintCppAd(
         pinocchioInterface, MobileManipulatorPinocchioMapping(manipulatorModelInfo_), std::move(geometryInterface), minimumDistance,
         "self_collision", libraryFolder, recompileLibraries, false));
   }
 
-  std::unique_ptr<PenaltyBase> penalty(new RelaxedBarrierPenalty({mu, delta}));
-
   return std::unique_ptr<StateCost>(new StateSoftConstraint(std::move(constraint), std::move(penalty)));
 }
 
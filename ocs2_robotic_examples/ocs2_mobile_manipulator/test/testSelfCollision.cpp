@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_robotic_assets/package_path.h>
 #include <ocs2_self_collision/SelfCollision.h>
@@ -156,3 +157,101 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, activationDistance) {
+  const scalar_t activationDistance = 0.2;
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  SelfCollision selfCollisionCulled(geometryInterface, minDistance, activationDistance);
+
+  benchmark::RepeatedTimer exactTimer;
+  benchmark::RepeatedTimer culledTimer;
+  for (int i = 0; i < 100; i++) {
+    vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    vector_t d1, d2;
+    matrix_t Jd1, Jd2;
+
+    exactTimer.startTimer();
+    std::tie(d1, Jd1) = selfCollision.getLinearApproximation(pinocchioInterface);
+    exactTimer.endTimer();
+
+    culledTimer.startTimer();
+    std::tie(d2, Jd2) = selfCollisionCulled.getLinearApproximation(pinocchioInterface);
+    culledTimer.endTimer();
+
+    for (size_t j = 0; j < selfCollision.getNumCollisionPairs(); j++) {
+      const bool isExact = std::abs(d1[j] - d2[j]) < 1e-9;
+      if (d1[j] + minDistance <= activationDistance || isExact) {
+        // pairs within the activation distance are never culled
+        ASSERT_NEAR(d1[j], d2[j], 1e-9);
+        ASSERT_TRUE(Jd1.row(j).isApprox(Jd2.row(j)));
+      } else {
+        // culled pairs report a conservative distance and no gradient
+        ASSERT_LT(d2[j], d1[j]);
+        ASSERT_GT(d2[j] + minDistance, activationDistance);
+        ASSERT_TRUE(Jd2.row(j).isZero(0.0));
+      }
+    }
+
+    // the value shares the distance query of the linear approximation
+    ASSERT_TRUE(selfCollisionCulled.getValue(pinocchioInterface).isApprox(d2));
+  }
+
+  std::cerr << "[SelfCollision] exact: " << exactTimer.getAverageInMilliseconds()
+            << " [ms], with activation distance: " << culledTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+TEST_F(TestSelfCollision, warmStartedTrajectory) {
+  const scalar_t infinity = std::numeric_limits<scalar_t>::infinity();
+  SelfCollision selfCollision(geometryInterface, minDistance, infinity, infinity, infinity);
+
+  // small steps along a trajectory warm start the distance queries from the previous step
+  const vector_t qFinal = vector_t::Random(9);
+  for (int i = 0; i <= 50; i++) {
+    const vector_t q = jointPositon + (i / 50.0) * (qFinal - jointPositon);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    vector_t d1, d2;
+    matrix_t Jd1, Jd2;
+
+    std::tie(d1, Jd1) = selfCollision.getLinearApproximation(pinocchioInterface);
+    std::tie(d2, Jd2) = SelfCollision(geometryInterface, minDistance).getLinearApproximation(pinocchioInterface);
+
+    ASSERT_TRUE(d1.isApprox(d2, 1e-6));
+    ASSERT_TRUE(Jd1.isApprox(Jd2, 1e-6));
+  }
+
+  // every query but the first one is warm started
+  EXPECT_EQ(selfCollision.getNumWarmStartedQueries(), 50);
+}
+
+TEST_F(TestSelfCollision, warmStartThresholds) {
+  const scalar_t infinity = std::numeric_limits<scalar_t>::infinity();
+  const scalar_t maxTranslation = 0.05;
+  const scalar_t maxRotation = 0.1;
+  SelfCollision selfCollision(geometryInterface, minDistance, infinity, maxTranslation, maxRotation);
+
+  computeValue(pinocchioInterface, jointPositon);
+  selfCollision.getValue(pinocchioInterface);
+  ASSERT_EQ(selfCollision.getNumWarmStartedQueries(), 0);
+
+  // a pure rotation of the last joint below the threshold is warm started
+  vector_t q = jointPositon;
+  q(8) += 0.5 * maxRotation;
+  computeValue(pinocchioInterface, q);
+  selfCollision.getValue(pinocchioInterface);
+  EXPECT_EQ(selfCollision.getNumWarmStartedQueries(), 1);
+
+  // a rotation of the last joint beyond the threshold starts cold, even though the joint position does not change
+  q(8) += 2.0 * maxRotation;
+  computeValue(pinocchioInterface, q);
+  selfCollision.getValue(pinocchioInterface);
+  EXPECT_EQ(selfCollision.getNumWarmStartedQueries(), 1);
+
+  // a translation of the base beyond the threshold starts cold
+  q(0) += 2.0 * maxTranslation;
+  computeValue(pinocchioInterface, q);
+  selfCollision.getValue(pinocchioInterface);
+  EXPECT_EQ(selfCollision.getNumWarmStartedQueries(), 1);
+}
@@ -44,11 +44,12 @@ class MultipleShootingMpc final : public MPC_BASE {
    * @param settings : settings for the multiple shooting solver.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: An optional thread pool shared with other solvers, e.g., the worker pool of an MPC_Host.
    */
   MultipleShootingMpc(mpc::Settings mpcSettings, multiple_shooting::Settings settings, const OptimalControlProblem& optimalControlProblem,
-                      const Initializer& initializer)
+                      const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr = nullptr)
       : MPC_BASE(std::move(mpcSettings)) {
-    solverPtr_.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer));
+    solverPtr_.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer, std::move(threadPoolPtr)));
   };
 
   ~MultipleShootingMpc() override = default;
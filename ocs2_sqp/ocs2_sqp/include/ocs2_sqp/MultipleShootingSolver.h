@@ -55,8 +55,11 @@ class MultipleShootingSolver : public SolverBase {
    * @param settings : settings for the multiple shooting solver.
    * @param [in] optimalControlProblem: The optimal control problem formulation.
    * @param [in] initializer: This class initializes the state-input for the time steps that no controller is available.
+   * @param [in] threadPoolPtr: An optional thread pool shared with other solvers. If it is not provided, the solver creates its own
+   * pool with (nThreads - 1) workers.
    */
-  MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer);
+  MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer,
+                         std::shared_ptr<ThreadPool> threadPoolPtr = nullptr);
 
   ~MultipleShootingSolver() override;
 
@@ -103,7 +106,7 @@ class MultipleShootingSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
+  /** Run a task in parallel with settings.nThreads. The task receives a unique worker index in [0, nThreads - 1]. */
   void runParallel(std::function<void(int)> taskFunction);
 
   /** Get profiling information as a string */
@@ -158,7 +161,7 @@ class MultipleShootingSolver : public SolverBase {
   std::unique_ptr<Initializer> initializerPtr_;
 
   // Threading
-  ThreadPool threadPool_;
+  std::shared_ptr<ThreadPool> threadPoolPtr_;
 
   // Solution
   PrimalSolution primalSolution_;
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <atomic>
 #include <iostream>
 #include <numeric>
 
@@ -42,11 +43,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 
 MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem,
-                                               const Initializer& initializer)
+                                               const Initializer& initializer, std::shared_ptr<ThreadPool> threadPoolPtr)
     : SolverBase(),
       settings_(std::move(settings)),
       hpipmInterface_(hpipm_interface::OcpSize(), settings.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPoolPtr_(std::move(threadPoolPtr)) {
+  if (threadPoolPtr_ == nullptr) {
+    threadPoolPtr_ = std::make_shared<ThreadPool>(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority);
+  }
+
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -214,7 +219,10 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 }
 
 void MultipleShootingSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+  // The worker index of a (possibly shared) pool can exceed the number of worker resources. Therefore, each of the nThreads tasks gets
+  // its own index.
+  std::atomic_int nextWorkerId{0};
+  threadPoolPtr_->runParallel([&](int) { taskFunction(nextWorkerId++); }, settings_.nThreads);
 }
 
 void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& initState,
@@ -539,6 +547,14 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   vector_array_t xNew(x.size());
   vector_array_t uNew(u.size());
   do {
+    // No new trial step after an interrupt. Keeping the current iterate makes it consistent with the feedback policy of the last QP.
+    if (isInterrupted()) {
+      if (settings_.printLinesearch) {
+        std::cerr << "Exiting linesearch early due to solver interrupt (i.e., " << toString(getInterruptStatus()) << ")\n";
+      }
+      break;
+    }
+
     // Compute step
     for (int i = 0; i < u.size(); i++) {
       if (du[i].size() > 0) {  // account for absence of inputs at events.
@@ -624,6 +640,9 @@ multiple_shooting::Convergence MultipleShootingSolver::checkConvergence(int iter
   if ((iteration + 1) >= settings_.sqpIteration) {
     // Converged because the next iteration would exceed the specified number of iterations
     return Convergence::ITERATIONS;
+  } else if (isInterrupted()) {
+    // Terminated early because of an interrupt request or the deadline
+    return Convergence::INTERRUPTED;
   } else if (stepInfo.stepSize < settings_.alpha_min) {
     // Converged because step size is below the specified minimum
     return Convergence::STEPSIZE;
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
@@ -141,3 +143,54 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, solve_with_deadline) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.printSolverStatus = true;
+  settings.printLinesearch = true;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with a passed deadline: only the first QP is solved and the initial guess is kept
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.setDeadline(std::chrono::steady_clock::now());
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getInterruptStatus(), ocs2::InterruptStatus::DEADLINE);
+  ASSERT_EQ(solver.getNumIterations(), size_t(1));
+
+  // The interrupted solution still covers the horizon with a consistent feedback policy
+  auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+  for (int i = 0; i < primalSolution.timeTrajectory_.size() - 1; i++) {
+    const auto t = primalSolution.timeTrajectory_[i];
+    const auto& x = primalSolution.stateTrajectory_[i];
+    const auto& u = primalSolution.inputTrajectory_[i];
+    ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
+  }
+
+  // Solve without deadline
+  solver.clearDeadline();
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getInterruptStatus(), ocs2::InterruptStatus::NONE);
+
+  // Check constraint satisfaction.
+  const auto performance = solver.getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+}